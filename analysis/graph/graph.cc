@@ -0,0 +1,94 @@
+// Scheduling overhead of wr::TaskGraph: 1M-node graphs of empty nodes, built once and rerun every iteration.
+// Items processed = nodes, so the reported time per item is the per-node overhead (target: < 50 ns/node).
+//
+//  >> Independent:  no edges, all nodes are sources (one `submit_batch`)
+//  >> Tree:         binary fan-out tree (every node releases two successors)
+//  >> Layered:      layers of `width` nodes, every node depends on 2 random nodes of the previous layer
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <thread>
+
+#include "exec/executor.hpp"
+#include "graph/task_graph.hpp"
+
+namespace {
+
+using Executor = wr::WsExecutor<>;
+using Graph = wr::TaskGraph<Executor>;
+
+constexpr uint32_t kNodes = 1 << 20;
+
+size_t pool_size() {
+    const auto hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 4 : hw;
+}
+
+void empty_node() {
+    benchmark::ClobberMemory();
+}
+
+template <typename Build>
+void run_graph(benchmark::State& state, Build build) {
+    Executor executor(pool_size());
+    Graph graph(&executor);
+    build(graph);
+
+    graph.run_and_wait();  // warm-up: seals the graph
+
+    for (auto _ : state) {
+        graph.run_and_wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * graph.size());
+}
+
+void BM_GraphIndependent(benchmark::State& state) {
+    run_graph(state, [](Graph& graph) {
+        for (uint32_t i = 0; i < kNodes; ++i) {
+            graph.emplace(empty_node);
+        }
+    });
+}
+
+void BM_GraphTree(benchmark::State& state) {
+    run_graph(state, [](Graph& graph) {
+        for (uint32_t i = 0; i < kNodes; ++i) {
+            auto node = graph.emplace(empty_node);
+            if (node > 0) {
+                graph.precede((node - 1) / 2, node);
+            }
+        }
+    });
+}
+
+void BM_GraphLayered(benchmark::State& state) {
+    const auto width = static_cast<uint32_t>(state.range(0));
+
+    run_graph(state, [width](Graph& graph) {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<uint32_t> pick(0, width - 1);
+
+        for (uint32_t i = 0; i < kNodes; ++i) {
+            auto node = graph.emplace(empty_node);
+            if (node >= width) {
+                const uint32_t layer_begin = (node / width - 1) * width;
+                const uint32_t first = layer_begin + pick(gen);
+                const uint32_t second = layer_begin + pick(gen);
+                graph.precede(first, node);
+                if (second != first) {
+                    graph.precede(second, node);
+                }
+            }
+        }
+    });
+}
+
+}  // namespace
+
+BENCHMARK(BM_GraphIndependent)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_GraphTree)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_GraphLayered)->Arg(64)->Arg(1024)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
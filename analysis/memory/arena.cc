@@ -0,0 +1,91 @@
+// Allocation-heavy tasks: per-worker scratch arena vs the global allocator (glibc malloc).
+//
+// Every task builds `allocs` small vectors (parsing-like scratch data), sums them up and throws them away.
+// Tasks are spawned in bulk on a WsExecutor with all hardware threads, so malloc is hit from every worker.
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "exec/executor.hpp"
+#include "memory/arena.hpp"
+
+namespace {
+
+constexpr int kTasksPerIteration = 4096;
+constexpr int kElementsPerVector = 24;
+
+std::atomic<uint64_t> sink = 0;
+
+size_t pool_size() {
+    const auto hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 4 : hw;
+}
+
+template <typename MakeVector>
+void scratch_work(int allocs, MakeVector&& make_vector) {
+    uint64_t sum = 0;
+    for (int i = 0; i < allocs; ++i) {
+        auto numbers = make_vector();
+        for (int j = 0; j < kElementsPerVector; ++j) {
+            numbers.push_back(i + j);  // grows a few times => several allocations per vector
+        }
+        for (int x : numbers) {
+            sum += x;
+        }
+    }
+    sink.fetch_add(sum, std::memory_order::relaxed);
+}
+
+template <typename Body>
+void run_tasks(benchmark::State& state, Body body) {
+    wr::WsExecutor<> executor(pool_size());
+    std::atomic<int> done = 0;
+
+    for (auto _ : state) {
+        done.store(0, std::memory_order::relaxed);
+
+        for (int t = 0; t < kTasksPerIteration; ++t) {
+            executor.submit([&] {
+                body();
+                done.fetch_add(1, std::memory_order::release);
+            });
+        }
+
+        while (done.load(std::memory_order::acquire) != kTasksPerIteration) {
+            std::this_thread::yield();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kTasksPerIteration * state.range(0));
+}
+
+void BM_ScratchMalloc(benchmark::State& state) {
+    const int allocs = static_cast<int>(state.range(0));
+
+    run_tasks(state, [allocs] {
+        scratch_work(allocs, [] {
+            return std::vector<int>{};
+        });
+    });
+}
+
+void BM_ScratchArena(benchmark::State& state) {
+    const int allocs = static_cast<int>(state.range(0));
+
+    run_tasks(state, [allocs] {
+        auto& arena = wr::this_worker::arena();  // rewound by the worker after the task
+        scratch_work(allocs, [&arena] {
+            return std::vector<int, wr::memory::ArenaAllocator<int>>{wr::memory::ArenaAllocator<int>(arena)};
+        });
+    });
+}
+
+}  // namespace
+
+BENCHMARK(BM_ScratchMalloc)->RangeMultiplier(4)->Range(1, 256)->UseRealTime();
+BENCHMARK(BM_ScratchArena)->RangeMultiplier(4)->Range(1, 256)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,128 @@
+// Latency of a latency-critical task submitted while the pool is saturated with bulk work.
+//
+// Every worker is kept busy by self-resubmitting low-priority chains (a couple of microseconds each);
+// an external thread submits a probe per iteration and measures submit -> start. Reported: p50 / p99.
+//
+//  >> Flat:      one level, the probe is queued with the bulk work (global queue polled every
+//                `kFairnessPeriod` picks or when the local work runs out)
+//  >> Priority:  two levels, the probe goes to level 0 and is picked by the next free worker
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "exec/executor.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct FlatConfig {
+    static constexpr size_t kLocalQueueCapacity = 8192;
+    static constexpr size_t kMaxLifoStreak = 23;
+    static constexpr uint64_t kFairnessPeriod = 61;
+};
+
+struct PriorityConfig : FlatConfig {
+    static constexpr size_t kPriorityLevels = 2;
+};
+
+constexpr int kChainsPerWorker = 4;
+constexpr int kBulkWork = 256;
+
+size_t pool_size() {
+    const auto hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 4 : hw;
+}
+
+template <typename Executor>
+class Bulk {
+  private:
+    Executor& executor_;
+    std::atomic<bool> running_ = true;
+    std::atomic<int> chains_ = 0;
+
+  public:
+    explicit Bulk(Executor& executor) : executor_(executor) {
+        const int chains = static_cast<int>(executor.workers_count()) * kChainsPerWorker;
+        chains_.store(chains);
+        for (int i = 0; i < chains; ++i) {
+            spawn();
+        }
+    }
+
+    ~Bulk() {
+        running_.store(false);
+        while (chains_.load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+  private:
+    void spawn() {
+        executor_.submit([this] {
+            uint64_t sink = 0;
+            for (int i = 0; i < kBulkWork; ++i) {
+                benchmark::DoNotOptimize(sink += i);
+            }
+
+            if (running_.load(std::memory_order::relaxed)) {
+                spawn();
+            } else {
+                chains_.fetch_sub(1);
+            }
+        });  // lowest level
+    }
+};
+
+template <typename Executor>
+void run_probes(benchmark::State& state, size_t probe_priority) {
+    Executor executor(pool_size());
+    Bulk<Executor> bulk(executor);
+
+    std::vector<double> latencies;
+
+    for (auto _ : state) {
+        std::atomic<bool> started = false;
+        Clock::duration latency{};
+        const auto submitted = Clock::now();
+
+        executor.submit(
+            [&] {
+                latency = Clock::now() - submitted;
+                started.store(true, std::memory_order::release);
+            },
+            probe_priority);
+
+        while (!started.load(std::memory_order::acquire)) {
+            std::this_thread::yield();
+        }
+        latencies.push_back(std::chrono::duration<double, std::micro>(latency).count());
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        return latencies[static_cast<size_t>(p * static_cast<double>(latencies.size() - 1))];
+    };
+    state.counters["p50_us"] = percentile(0.50);
+    state.counters["p99_us"] = percentile(0.99);
+}
+
+void BM_ProbeLatencyFlat(benchmark::State& state) {
+    run_probes<wr::WsExecutor<wr::TaskBase, FlatConfig>>(state, 0);
+}
+
+void BM_ProbeLatencyPriority(benchmark::State& state) {
+    run_probes<wr::WsExecutor<wr::TaskBase, PriorityConfig>>(state, 0);
+}
+
+}  // namespace
+
+BENCHMARK(BM_ProbeLatencyFlat)->Iterations(2000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+BENCHMARK(BM_ProbeLatencyPriority)->Iterations(2000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_MAIN();
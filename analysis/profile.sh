@@ -9,6 +9,7 @@ SVG_OUT=${2:-"${TARGET}.svg"}
 
 if [ -z "$TARGET" ]; then
   echo "usage : $0 <path_to_executable> [output_svg_path]"
+  echo "        (relative to the build directory, e.g. analysis/scheduler/scheduler_bench)"
   exit 1
 fi
 
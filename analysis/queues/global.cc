@@ -0,0 +1,155 @@
+// GlobalQueue under N producers and M consumers: single tasks and batches.
+//
+// Every producer owns a ring of tasks and re-pushes a task only after a consumer has taken it (`queued`
+// flag) => the queue holds at most `kRing` tasks per producer, like an injection queue under admission
+// control. A producer which finds its next task still queued counts a stall and yields instead of pushing,
+// a consumer which finds the queue empty yields.
+// `ops/s` and `time/op` (wall time per op, e.g. `40ns`) count the pushed + popped tasks of all threads;
+// `pushed/s` and `popped/s` are reported apart.
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "queues/global/global_queue.hpp"
+#include "tasks/task_base.hpp"
+
+namespace {
+
+constexpr size_t kRing = 1024;
+
+struct RingTask : wr::TaskBase {
+    std::atomic<bool> queued = false;
+
+    RingTask() noexcept : wr::TaskBase(&noop) {}
+
+    static void noop(wr::TaskBase*) noexcept {}
+};
+
+using Queue = wr::queues::GlobalQueue<wr::TaskBase>;
+using Batch = IntrusiveList<wr::TaskBase>;
+
+struct Shared {
+    Queue queue;
+    std::vector<std::vector<RingTask>> rings;  // per producer
+
+    explicit Shared(size_t producers) : rings(producers) {
+        for (auto& ring : rings) {
+            ring = std::vector<RingTask>(kRing);
+        }
+    }
+};
+
+Shared* shared = nullptr;
+
+void release(wr::TaskBase* task) {
+    // pairs with the producer's acquire: the pop (under the queue lock) happens before the next push
+    static_cast<RingTask*>(task)->queued.store(false, std::memory_order::release);
+}
+
+// range(0) producers, the remaining threads consume; range(1) tasks per push / pop (1 => `push` / `try_pop`)
+void BM_ProducersConsumers(benchmark::State& state) {
+    const auto producers = static_cast<size_t>(state.range(0));
+    const auto batch_size = static_cast<size_t>(state.range(1));
+    const auto index = static_cast<size_t>(state.thread_index());
+    const bool producer = index < producers;
+
+    if (index == 0) {
+        shared = new Shared(producers);
+    }
+
+    double pushed = 0;
+    double popped = 0;
+    double stalls = 0;
+    size_t next = 0;  // producer: position in its ring
+
+    for (auto _ : state) {
+        if (producer) {
+            auto& ring = shared->rings[index];
+
+            Batch batch;
+            size_t count = 0;
+            while (count < batch_size) {
+                RingTask& task = ring[next];
+                if (task.queued.load(std::memory_order::acquire)) {
+                    break;  // the consumers lag behind by a whole ring
+                }
+                task.queued.store(true, std::memory_order::relaxed);
+                batch.push_back(task);
+                next = (next + 1) % kRing;
+                ++count;
+            }
+
+            if (count == 0) {
+                ++stalls;
+                std::this_thread::yield();  // let the consumers catch up (oversubscribed machines)
+            } else if (batch_size == 1) {
+                std::optional<wr::TaskBase*> task = batch.try_pop_front();
+                shared->queue.push(*task);
+            } else {
+                shared->queue.push_batch(std::move(batch), count);
+            }
+            pushed += static_cast<double>(count);
+        } else if (batch_size == 1) {
+            if (auto task = shared->queue.try_pop()) {
+                release(*task);
+                ++popped;
+            } else {
+                std::this_thread::yield();
+            }
+        } else {
+            if (auto batch = shared->queue.try_pop_batch(batch_size)) {
+                while (!batch->empty()) {
+                    std::optional<wr::TaskBase*> task = batch->try_pop_front();
+                    release(*task);
+                    ++popped;
+                }
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    // the end of the loop is a barrier: drop what is left before the rings go away
+    if (index == 0) {
+        while (shared->queue.try_pop_batch(kRing)) {
+        }
+        delete shared;
+        shared = nullptr;
+    }
+
+    state.counters["ops/s"] = benchmark::Counter(pushed + popped, benchmark::Counter::kIsRate);
+    state.counters["time/op"] =
+        benchmark::Counter(pushed + popped, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.counters["pushed/s"] = benchmark::Counter(pushed, benchmark::Counter::kIsRate);
+    state.counters["popped/s"] = benchmark::Counter(popped, benchmark::Counter::kIsRate);
+    state.counters["producer_stalls"] = benchmark::Counter(stalls);
+}
+
+}  // namespace
+
+// {producers, consumers} x {single tasks, batches of 32}: the consumers are the threads beyond the producers
+int main(int argc, char** argv) {
+    for (int batch : {1, 32}) {
+        for (auto [producers, consumers] : {std::pair{1, 1}, {1, 3}, {2, 2}, {3, 1}, {4, 4}}) {
+            benchmark::RegisterBenchmark("BM_ProducersConsumers", &BM_ProducersConsumers)
+                ->ArgNames({"producers", "batch"})
+                ->Args({producers, batch})
+                ->Threads(producers + consumers)
+                ->UseRealTime();
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
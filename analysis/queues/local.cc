@@ -0,0 +1,166 @@
+// WorkStealingQueue: the owner alone, the owner against 1..N thieves, offload_half.
+//
+// Tasks are never run: the benchmarks move pointers to preallocated no-op tasks through the deque.
+// Every benchmark reports `ops/s` and `time/op` (wall time per op, e.g. `12.5ns`; an op = one push, pop,
+// steal or offloaded task). With threads both count the ops of all threads over the wall time; the owner's
+// and the thieves' ops are also reported apart (`owner_ops/s`, `stolen/s`, `steal_retries`).
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "queues/local/steal_handle.hpp"
+#include "queues/local/ws_queue.hpp"
+#include "tasks/task_base.hpp"
+
+namespace {
+
+constexpr size_t kCapacity = 256;
+
+using Queue = wr::queues::WorkStealingQueue<wr::TaskBase, kCapacity>;
+using Stealer = wr::queues::StealHandle<wr::TaskBase, kCapacity>;
+
+void noop(wr::TaskBase*) noexcept {}
+
+std::vector<wr::TaskBase> make_tasks(size_t count) {
+    std::vector<wr::TaskBase> tasks;
+    tasks.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        tasks.emplace_back(&noop);
+    }
+    return tasks;
+}
+
+void report_ops(benchmark::State& state, double ops) {
+    state.counters["ops/s"] = benchmark::Counter(ops, benchmark::Counter::kIsRate);
+    state.counters["time/op"] = benchmark::Counter(ops, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+// -------------------- Owner only --------------------
+
+// push + pop of one task: the LIFO hot path of a worker which spawns and runs its own tasks
+void BM_OwnerPushPop(benchmark::State& state) {
+    Queue queue;
+    auto tasks = make_tasks(1);
+
+    for (auto _ : state) {
+        queue.try_push(&tasks[0]);
+        benchmark::DoNotOptimize(queue.try_pop());
+    }
+
+    report_ops(state, static_cast<double>(state.iterations()) * 2);
+}
+
+// fill `range(0)` tasks, then drain them
+void BM_OwnerFillDrain(benchmark::State& state) {
+    const auto burst = static_cast<size_t>(state.range(0));
+    Queue queue;
+    auto tasks = make_tasks(burst);
+
+    for (auto _ : state) {
+        for (auto& task : tasks) {
+            queue.try_push(&task);
+        }
+        for (size_t i = 0; i < burst; ++i) {
+            benchmark::DoNotOptimize(queue.try_pop());
+        }
+    }
+
+    report_ops(state, static_cast<double>(state.iterations() * burst) * 2);
+}
+
+// -------------------- Owner + thieves --------------------
+
+// thread 0 is the owner: it pushes a burst and pops what the thieves have left;
+// threads 1..N steal one task at a time
+struct Shared {
+    Queue queue;
+    std::vector<wr::TaskBase> tasks = make_tasks(kCapacity);
+};
+
+Shared* shared = nullptr;
+
+void BM_OwnerWithThieves(benchmark::State& state) {
+    const auto burst = static_cast<size_t>(state.range(0));
+    const bool owner = state.thread_index() == 0;
+
+    if (owner) {
+        shared = new Shared();
+    }
+    // the start of the loop is a barrier of all threads => `shared` is visible to the thieves
+    std::optional<Stealer> stealer;
+
+    double owner_ops = 0;
+    double stolen = 0;
+    double retries = 0;
+
+    for (auto _ : state) {
+        if (owner) {
+            for (size_t i = 0; i < burst; ++i) {
+                shared->queue.try_push(&shared->tasks[i]);
+            }
+            while (shared->queue.try_pop()) {
+                ++owner_ops;
+            }
+            owner_ops += static_cast<double>(burst);
+        } else {
+            if (!stealer) {
+                stealer.emplace(shared->queue.create_stealer());
+            }
+            auto loot = stealer->steal();
+            stolen += loot.success() ? 1 : 0;
+            retries += loot.retry() ? 1 : 0;
+        }
+    }
+
+    // the end of the loop is a barrier too: nobody touches the queue anymore
+    if (owner) {
+        delete shared;
+        shared = nullptr;
+    }
+
+    report_ops(state, owner_ops + stolen);
+    state.counters["owner_ops/s"] = benchmark::Counter(owner_ops, benchmark::Counter::kIsRate);
+    state.counters["stolen/s"] = benchmark::Counter(stolen, benchmark::Counter::kIsRate);
+    state.counters["steal_retries"] = benchmark::Counter(retries);
+}
+
+// -------------------- Offload --------------------
+
+// a full queue gives half of its tasks away (`Worker::push_local` on overflow), the owner drains the rest
+void BM_OffloadHalf(benchmark::State& state) {
+    Queue queue;
+    auto tasks = make_tasks(kCapacity);
+    size_t moved = 0;
+
+    for (auto _ : state) {
+        for (auto& task : tasks) {
+            queue.try_push(&task);
+        }
+
+        size_t offloaded = 0;
+        auto batch = queue.offload_half(&offloaded);
+        while (batch && !batch->empty()) {
+            benchmark::DoNotOptimize(batch->try_pop_front());
+        }
+        while (queue.try_pop()) {
+        }
+        moved += offloaded;
+    }
+
+    // an op = one offloaded task: the pushes and the drain are part of the price of an offload
+    report_ops(state, static_cast<double>(moved));
+    state.counters["offloaded/iter"] =
+        benchmark::Counter(static_cast<double>(moved) / static_cast<double>(state.iterations()));
+}
+
+}  // namespace
+
+BENCHMARK(BM_OwnerPushPop);
+BENCHMARK(BM_OwnerFillDrain)->RangeMultiplier(4)->Range(4, kCapacity);
+BENCHMARK(BM_OwnerWithThieves)->Arg(64)->DenseThreadRange(1, 5)->UseRealTime();
+BENCHMARK(BM_OffloadHalf);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,342 @@
+// Replays a recording (`Config::kEnableRecording` + `WsExecutor::record_to`) against several ExecutionConfigs.
+//
+// The spawn tree of the recording is rebuilt (`record/dag.hpp`) and run again: roots are submitted from this
+// thread at their recorded times, every task spins for its recorded duration and submits its children at
+// their recorded offsets into its run. What changes between the runs is the scheduling => the makespan and
+// the queue waits compare the configs on the real shape of the load.
+//
+//      replay <recording> [--workers <n>] [--config <name>]    one JSON object per config, in a JSON array
+//      replay --record-demo <path>                              records a synthetic bursty fan-out
+//
+// Configs are compile-time types: add a line to `kConfigs` to try another one.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "exec/config/config.hpp"
+#include "exec/executor.hpp"
+#include "record/dag.hpp"
+#include "record/format.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// -------------------- Configs --------------------
+
+struct Default : wr::config::DefaultConfig {};
+
+struct ShortLifoStreak : wr::config::DefaultConfig {
+    static constexpr size_t kMaxLifoStreak = 4;
+};
+
+struct LongLifoStreak : wr::config::DefaultConfig {
+    static constexpr size_t kMaxLifoStreak = 64;
+};
+
+struct FrequentFairness : wr::config::DefaultConfig {
+    static constexpr uint64_t kFairnessPeriod = 13;
+};
+
+struct RareFairness : wr::config::DefaultConfig {
+    static constexpr uint64_t kFairnessPeriod = 257;
+};
+
+struct SmallLocalQueue : wr::config::DefaultConfig {
+    static constexpr size_t kLocalQueueCapacity = 64;
+};
+
+struct Recorded : wr::config::DefaultConfig {
+    static constexpr bool kEnableRecording = true;
+};
+
+// -------------------- Replay --------------------
+
+struct Plan {
+    const wr::record::Dag& dag;
+    std::vector<std::vector<size_t>> children;  // by offset
+    std::vector<size_t> roots;                  // by offset
+
+    explicit Plan(const wr::record::Dag& recorded) : dag(recorded), children(recorded.nodes.size()) {
+        for (size_t i = 0; i < dag.nodes.size(); ++i) {
+            const size_t parent = dag.nodes[i].parent;
+            (parent == wr::record::kRoot ? roots : children[parent]).push_back(i);
+        }
+        const auto by_offset = [this](size_t lhs, size_t rhs) {
+            return dag.nodes[lhs].offset < dag.nodes[rhs].offset;
+        };
+        std::stable_sort(roots.begin(), roots.end(), by_offset);
+        for (auto& list : children) {
+            std::stable_sort(list.begin(), list.end(), by_offset);
+        }
+    }
+};
+
+void spin_until(Clock::time_point deadline) {
+    while (Clock::now() < deadline) {
+    }
+}
+
+void sleep_until(Clock::time_point deadline) {
+    constexpr auto kSpin = std::chrono::microseconds(100);  // the sleep overshoots: spin the last part
+    if (deadline - Clock::now() > kSpin) {
+        std::this_thread::sleep_until(deadline - kSpin);
+    }
+    spin_until(deadline);
+}
+
+template <typename Config>
+class Replayer {
+  private:
+    using Executor = wr::WsExecutor<wr::TaskBase, Config>;
+
+    const Plan& plan_;
+    Executor executor_;
+
+    std::vector<Clock::time_point> submitted_;
+    std::vector<Clock::time_point> started_;
+    std::atomic<size_t> done_ = 0;
+
+  public:
+    Replayer(const Plan& plan, size_t workers)
+        : plan_(plan), executor_(workers), submitted_(plan.dag.nodes.size()), started_(plan.dag.nodes.size()) {}
+
+    // returns the makespan; `waits` gets the submit-to-start time of every task (ns)
+    std::chrono::nanoseconds run(std::vector<uint64_t>& waits) {
+        const auto origin = Clock::now();
+        for (size_t root : plan_.roots) {
+            sleep_until(origin + std::chrono::nanoseconds(plan_.dag.nodes[root].offset));
+            submit(root);
+        }
+        while (done_.load(std::memory_order::acquire) != plan_.dag.nodes.size()) {
+            std::this_thread::yield();
+        }
+        const auto makespan = Clock::now() - origin;
+
+        waits.clear();
+        for (size_t i = 0; i < plan_.dag.nodes.size(); ++i) {
+            waits.push_back(static_cast<uint64_t>((started_[i] - submitted_[i]).count()));
+        }
+        return makespan;
+    }
+
+  private:
+    void submit(size_t node) {
+        submitted_[node] = Clock::now();
+        executor_.submit([this, node] { execute(node); });
+    }
+
+    void execute(size_t node) {
+        const auto start = Clock::now();
+        started_[node] = start;
+
+        for (size_t child : plan_.children[node]) {
+            spin_until(start + std::chrono::nanoseconds(plan_.dag.nodes[child].offset));
+            submit(child);
+        }
+        spin_until(start + std::chrono::nanoseconds(plan_.dag.nodes[node].duration));
+
+        done_.fetch_add(1, std::memory_order::release);
+    }
+};
+
+// -------------------- Report --------------------
+
+struct Summary {
+    double mean = 0;
+    uint64_t p50 = 0;
+    uint64_t p99 = 0;
+    uint64_t max = 0;
+};
+
+Summary summarize(std::vector<uint64_t> values) {
+    Summary summary;
+    if (values.empty()) {
+        return summary;
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (uint64_t value : values) {
+        sum += static_cast<double>(value);
+    }
+    summary.mean = sum / static_cast<double>(values.size());
+    summary.p50 = values[values.size() / 2];
+    summary.p99 = values[std::min(values.size() - 1, values.size() * 99 / 100)];
+    summary.max = values.back();
+    return summary;
+}
+
+void print_wait(const char* key, const Summary& summary) {
+    std::printf("\"%s\": {\"mean\": %.3f, \"p50\": %.3f, \"p99\": %.3f, \"max\": %.3f}", key, summary.mean / 1e3,
+                static_cast<double>(summary.p50) / 1e3, static_cast<double>(summary.p99) / 1e3,
+                static_cast<double>(summary.max) / 1e3);
+}
+
+struct Run {
+    const char* name;
+    void (*replay)(const Plan& plan, size_t workers, const char* name, bool first);
+};
+
+template <typename Config>
+void replay_with(const Plan& plan, size_t workers, const char* name, bool first) {
+    std::vector<uint64_t> waits;
+    std::chrono::nanoseconds makespan{0};
+    {
+        Replayer<Config> replayer(plan, workers);
+        makespan = replayer.run(waits);
+    }
+
+    std::vector<uint64_t> recorded_waits;
+    for (const auto& node : plan.dag.nodes) {
+        recorded_waits.push_back(node.wait);
+    }
+
+    std::printf("%s  {\"config\": \"%s\", \"workers\": %zu, \"tasks\": %zu, \"recorded_makespan_ms\": %.3f, "
+                "\"makespan_ms\": %.3f, ",
+                first ? "" : ",\n", name, workers, plan.dag.nodes.size(), static_cast<double>(plan.dag.makespan) / 1e6,
+                static_cast<double>(makespan.count()) / 1e6);
+    print_wait("wait_us", summarize(waits));
+    std::printf(", ");
+    print_wait("recorded_wait_us", summarize(recorded_waits));
+    std::printf("}");
+    std::fflush(stdout);
+}
+
+constexpr Run kConfigs[] = {
+    {"default", &replay_with<Default>},
+    {"lifo-streak-4", &replay_with<ShortLifoStreak>},
+    {"lifo-streak-64", &replay_with<LongLifoStreak>},
+    {"fairness-13", &replay_with<FrequentFairness>},
+    {"fairness-257", &replay_with<RareFairness>},
+    {"local-queue-64", &replay_with<SmallLocalQueue>},
+};
+
+// -------------------- Demo recording --------------------
+
+// 20 bursts, 2 ms apart: 16 external requests each, a request fans out into 4..8 children of 20..100 us,
+// every fourth child spawns two more
+void record_demo(const std::string& path) {
+    const auto hw = std::thread::hardware_concurrency();
+    wr::WsExecutor<wr::TaskBase, Recorded> executor(hw == 0 ? 4 : hw);
+    executor.record_to(path);
+
+    std::mt19937 rng(42);
+    std::atomic<size_t> pending = 0;
+
+    const auto work = [](int us) { spin_until(Clock::now() + std::chrono::microseconds(us)); };
+
+    for (int burst = 0; burst < 20; ++burst) {
+        for (int request = 0; request < 16; ++request) {
+            const int fan_out = 4 + static_cast<int>(rng() % 5);
+            const int length = 20 + static_cast<int>(rng() % 81);
+            pending.fetch_add(1);
+            executor.submit([&, fan_out, length] {
+                work(10);
+                for (int child = 0; child < fan_out; ++child) {
+                    pending.fetch_add(1);
+                    executor.submit([&, child, length] {
+                        work(length);
+                        if (child % 4 == 0) {
+                            for (int i = 0; i < 2; ++i) {
+                                pending.fetch_add(1);
+                                executor.submit([&, length] {
+                                    work(length / 2);
+                                    pending.fetch_sub(1);
+                                });
+                            }
+                        }
+                        pending.fetch_sub(1);
+                    });
+                }
+                pending.fetch_sub(1);
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    while (pending.load() != 0) {
+        std::this_thread::yield();
+    }
+}
+
+int usage(const char* self) {
+    std::fprintf(stderr, "usage: %s <recording> [--workers <n>] [--config <name>]\n       %s --record-demo <path>\n",
+                 self, self);
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return usage(argv[0]);
+    }
+
+    const std::string first = argv[1];
+    if (first == "--record-demo") {
+        if (argc != 3) {
+            return usage(argv[0]);
+        }
+        record_demo(argv[2]);
+        return 0;
+    }
+
+    size_t workers = 0;
+    std::string only;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        if (flag == "--workers") {
+            workers = static_cast<size_t>(std::strtoul(argv[i + 1], nullptr, 10));
+        } else if (flag == "--config") {
+            only = argv[i + 1];
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    std::ifstream file(first, std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "cannot open %s\n", first.c_str());
+        return 1;
+    }
+
+    wr::record::Recording recording;
+    try {
+        recording = wr::record::read(file);
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "%s: %s\n", first.c_str(), error.what());
+        return 1;
+    }
+
+    const auto dag = wr::record::build_dag(recording);
+    const Plan plan(dag);
+    if (workers == 0) {
+        workers = recording.workers;
+    }
+
+    const auto selected = [&only](const Run& run) { return only.empty() || only == run.name; };
+    if (std::none_of(std::begin(kConfigs), std::end(kConfigs), selected)) {
+        std::fprintf(stderr, "unknown config %s\n", only.c_str());
+        return 2;
+    }
+
+    std::printf("[\n");
+    bool first_run = true;
+    for (const Run& run : kConfigs) {
+        if (selected(run)) {
+            run.replay(plan, workers, run.name, first_run);
+            first_run = false;
+        }
+    }
+    std::printf("\n]\n");
+    return 0;
+}
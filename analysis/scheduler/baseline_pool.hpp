@@ -0,0 +1,86 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace analysis {
+
+/* The textbook thread pool: one deque of std::function behind a mutex, idle threads sleep on a condvar.
+ * The baseline of the scheduler workloads: every submit (external or from a task) takes the same lock. */
+class MutexPool {
+  private:  // data members:
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<std::function<void()>> queue_;
+    bool stop_ = false;
+
+    std::vector<std::thread> threads_;
+
+  public:  // member functions:
+    explicit MutexPool(size_t threads_count);
+    ~MutexPool();
+
+    MutexPool(const MutexPool&) = delete;
+    MutexPool& operator=(const MutexPool&) = delete;
+    MutexPool(MutexPool&&) = delete;
+    MutexPool& operator=(MutexPool&&) = delete;
+
+    template <typename F>
+    void submit(F&& fun);
+
+  private:  // member functions:
+    void work();
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline MutexPool::MutexPool(size_t threads_count) {
+    threads_.reserve(threads_count);
+    for (size_t i = 0; i < threads_count; ++i) {
+        threads_.emplace_back([this] { work(); });
+    }
+}
+
+inline MutexPool::~MutexPool() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+template <typename F>
+void MutexPool::submit(F&& fun) {
+    {
+        std::lock_guard lock(mutex_);
+        queue_.emplace_back(std::forward<F>(fun));
+    }
+    wake_.notify_one();
+}
+
+inline void MutexPool::work() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;  // stopped and drained
+        }
+
+        auto task = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+}
+
+}  // namespace analysis
@@ -0,0 +1,285 @@
+// Whole-executor workloads: WsExecutor vs a mutex + condvar pool (`baseline_pool.hpp`) with as many threads.
+//
+//  >> fib / skynet:     recursive spawn, no work in the tasks => the price of a spawn + a join
+//  >> ping-pong:        an external thread submits one task and waits for it, repeatedly => wake latency
+//  >> fan-out uniform:  many independent ~1us tasks submitted from outside => throughput
+//  >> fan-out skewed:   the same tasks spawned by a single task => everything starts on one worker (stealing)
+//  >> injection storm:  several external threads submit tiny tasks at once => contention on the injection queue
+//
+// The output is JSON (Google Benchmark's format) unless `--benchmark_format` says otherwise;
+// `--benchmark_out=<file>` keeps it next to the console output.
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "baseline_pool.hpp"
+#include "exec/executor.hpp"
+
+namespace {
+
+using Executor = wr::WsExecutor<>;
+using Baseline = analysis::MutexPool;
+
+size_t pool_size() {
+    const auto hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 4 : hw;
+}
+
+template <typename P>
+void wait_for(P&& predicate) {
+    while (!predicate()) {
+        std::this_thread::yield();
+    }
+}
+
+void spin(int iterations) {
+    for (int i = 0; i < iterations; ++i) {
+        benchmark::DoNotOptimize(i);
+    }
+}
+
+constexpr int kTaskWork = 250;  // ~1us of spinning
+
+// -------------------- Joins --------------------
+
+struct Result {
+    std::atomic<uint64_t> value = 0;
+    std::atomic<bool> ready = false;
+};
+
+// sum of the children of a recursive task: the last child to finish passes it to the parent
+class Join {
+  private:
+    std::atomic<uint64_t> sum_ = 0;
+    std::atomic<uint32_t> pending_;
+    Join* parent_;
+    Result* result_;  // the root only
+
+  public:
+    Join(uint32_t children, Join* parent, Result* result) : pending_(children), parent_(parent), result_(result) {}
+
+    void add(uint64_t value) {
+        sum_.fetch_add(value, std::memory_order::relaxed);
+        if (pending_.fetch_sub(1, std::memory_order::acq_rel) != 1) {
+            return;
+        }
+
+        const uint64_t sum = sum_.load(std::memory_order::relaxed);
+        if (parent_ != nullptr) {
+            Join* parent = parent_;
+            delete this;
+            parent->add(sum);
+        } else {
+            result_->value.store(sum, std::memory_order::relaxed);
+            result_->ready.store(true, std::memory_order::release);
+            delete this;
+        }
+    }
+};
+
+// -------------------- fib --------------------
+
+template <typename Pool>
+void fib(Pool& pool, int n, Join* parent) {
+    if (n < 2) {
+        parent->add(static_cast<uint64_t>(n));
+        return;
+    }
+    auto* join = new Join(2, parent, nullptr);
+    pool.submit([&pool, n, join] { fib(pool, n - 1, join); });
+    pool.submit([&pool, n, join] { fib(pool, n - 2, join); });
+}
+
+uint64_t fib_tasks(int n) {
+    // calls of the naive recursion: fib(n + 1) * 2 - 1
+    uint64_t a = 0;
+    uint64_t b = 1;
+    for (int i = 0; i < n + 1; ++i) {
+        b = a + b;
+        a = b - a;
+    }
+    return 2 * a - 1;
+}
+
+template <typename Pool>
+void BM_Fib(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    Pool pool(pool_size());
+
+    for (auto _ : state) {
+        Result result;
+        auto* root = new Join(1, nullptr, &result);
+        pool.submit([&pool, n, root] { fib(pool, n, root); });
+        wait_for([&] { return result.ready.load(std::memory_order::acquire); });
+        benchmark::DoNotOptimize(result.value.load());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * fib_tasks(n)));
+}
+
+// -------------------- skynet --------------------
+
+// 10-ary tree of tasks, the leaves return their number: 1M leaves, 1.11M tasks
+constexpr uint64_t kSkynetLeaves = 1'000'000;
+
+template <typename Pool>
+void skynet(Pool& pool, uint64_t number, uint64_t size, Join* parent) {
+    if (size == 1) {
+        parent->add(number);
+        return;
+    }
+    auto* join = new Join(10, parent, nullptr);
+    const uint64_t child_size = size / 10;
+    for (uint64_t i = 0; i < 10; ++i) {
+        pool.submit([&pool, number, i, child_size, join] { skynet(pool, number + i * child_size, child_size, join); });
+    }
+}
+
+template <typename Pool>
+void BM_Skynet(benchmark::State& state) {
+    Pool pool(pool_size());
+
+    for (auto _ : state) {
+        Result result;
+        auto* root = new Join(1, nullptr, &result);
+        pool.submit([&pool, root] { skynet(pool, 0, kSkynetLeaves, root); });
+        wait_for([&] { return result.ready.load(std::memory_order::acquire); });
+        if (result.value.load() != kSkynetLeaves * (kSkynetLeaves - 1) / 2) {
+            state.SkipWithError("wrong sum");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * (kSkynetLeaves * 10 - 1) / 9));
+}
+
+// -------------------- ping-pong --------------------
+
+template <typename Pool>
+void BM_PingPong(benchmark::State& state) {
+    constexpr int kRoundTrips = 1000;
+    Pool pool(pool_size());
+    std::atomic<int> pong = 0;
+
+    for (auto _ : state) {
+        for (int i = 1; i <= kRoundTrips; ++i) {
+            pool.submit([&pong, i] { pong.store(i, std::memory_order::release); });
+            wait_for([&] { return pong.load(std::memory_order::acquire) == i; });
+        }
+        pong.store(0, std::memory_order::relaxed);
+    }
+
+    // items = round trips: 1 / items_per_second is the latency of a submit to an idle pool
+    state.SetItemsProcessed(state.iterations() * kRoundTrips);
+}
+
+// -------------------- fan-out --------------------
+
+constexpr int kFanOut = 10'000;
+
+template <typename Pool>
+void BM_FanOutUniform(benchmark::State& state) {
+    Pool pool(pool_size());
+    std::atomic<int> done = 0;
+
+    for (auto _ : state) {
+        done.store(0, std::memory_order::relaxed);
+        for (int i = 0; i < kFanOut; ++i) {
+            pool.submit([&done] {
+                spin(kTaskWork);
+                done.fetch_add(1, std::memory_order::release);
+            });
+        }
+        wait_for([&] { return done.load(std::memory_order::acquire) == kFanOut; });
+    }
+
+    state.SetItemsProcessed(state.iterations() * kFanOut);
+}
+
+template <typename Pool>
+void BM_FanOutSkewed(benchmark::State& state) {
+    Pool pool(pool_size());
+    std::atomic<int> done = 0;
+
+    for (auto _ : state) {
+        done.store(0, std::memory_order::relaxed);
+        pool.submit([&pool, &done] {
+            for (int i = 0; i < kFanOut; ++i) {
+                pool.submit([&done] {
+                    spin(kTaskWork);
+                    done.fetch_add(1, std::memory_order::release);
+                });
+            }
+        });
+        wait_for([&] { return done.load(std::memory_order::acquire) == kFanOut; });
+    }
+
+    state.SetItemsProcessed(state.iterations() * kFanOut);
+}
+
+// -------------------- injection storm --------------------
+
+template <typename Pool>
+void BM_InjectionStorm(benchmark::State& state) {
+    constexpr int kPerSubmitter = 10'000;
+    const auto submitters = static_cast<int>(state.range(0));
+    Pool pool(pool_size());
+    std::atomic<int> done = 0;
+
+    for (auto _ : state) {
+        done.store(0, std::memory_order::relaxed);
+
+        std::vector<std::thread> threads;
+        threads.reserve(static_cast<size_t>(submitters));
+        for (int s = 0; s < submitters; ++s) {
+            threads.emplace_back([&pool, &done] {
+                for (int i = 0; i < kPerSubmitter; ++i) {
+                    pool.submit([&done] { done.fetch_add(1, std::memory_order::release); });
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        wait_for([&] { return done.load(std::memory_order::acquire) == submitters * kPerSubmitter; });
+    }
+
+    state.SetItemsProcessed(state.iterations() * submitters * kPerSubmitter);
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_Fib, Executor)->Arg(20)->Arg(25)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Fib, Baseline)->Arg(20)->Arg(25)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Skynet, Executor)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Skynet, Baseline)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PingPong, Executor)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PingPong, Baseline)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_FanOutUniform, Executor)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_FanOutUniform, Baseline)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_FanOutSkewed, Executor)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_FanOutSkewed, Baseline)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_InjectionStorm, Executor)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_InjectionStorm, Baseline)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// JSON by default: the results are meant to be stored and compared across commits
+int main(int argc, char** argv) {
+    std::vector<char*> args(argv, argv + argc);
+    std::string json_format = "--benchmark_format=json";
+    args.insert(args.begin() + 1, json_format.data());  // a later `--benchmark_format` wins
+    int args_count = static_cast<int>(args.size());
+
+    benchmark::Initialize(&args_count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(args_count, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,157 @@
+// Contended critical sections inside tasks: wr::AsyncMutex / wr::AsyncSemaphore vs std::mutex.
+//
+// Every task enters the critical section `rounds` times (a few hundred ns of work each time).
+// With std::mutex a contender blocks its whole worker thread; with the async primitives it leaves a waiter
+// and the worker runs something else, the releaser hands the lock over through its lifo slot.
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+
+#include "exec/executor.hpp"
+#include "sync/mutex.hpp"
+#include "sync/semaphore.hpp"
+
+namespace {
+
+using Executor = wr::WsExecutor<>;
+
+constexpr int kTasksPerIteration = 1024;
+constexpr int kSectionWork = 64;
+
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+            std::terminate();
+        }
+    };
+};
+
+uint64_t shared_state = 0;
+
+void critical_section() {
+    for (int i = 0; i < kSectionWork; ++i) {
+        benchmark::DoNotOptimize(shared_state += i);
+    }
+}
+
+size_t pool_size() {
+    const auto hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 4 : hw;
+}
+
+template <typename Spawn>
+void run_tasks(benchmark::State& state, Executor& executor, Spawn spawn) {
+    std::atomic<int> done = 0;
+
+    for (auto _ : state) {
+        done.store(0, std::memory_order::relaxed);
+
+        for (int t = 0; t < kTasksPerIteration; ++t) {
+            executor.submit([&] { spawn(done); });
+        }
+
+        while (done.load(std::memory_order::acquire) != kTasksPerIteration) {
+            std::this_thread::yield();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kTasksPerIteration * state.range(0));
+}
+
+// -------------------- Mutex --------------------
+
+Detached async_locker(wr::AsyncMutex<Executor>& mutex, int rounds, std::atomic<int>& done) {
+    for (int i = 0; i < rounds; ++i) {
+        co_await mutex.lock();
+        critical_section();
+        mutex.unlock();
+    }
+    done.fetch_add(1, std::memory_order::release);
+}
+
+void BM_StdMutex(benchmark::State& state) {
+    const int rounds = static_cast<int>(state.range(0));
+    Executor executor(pool_size());
+    std::mutex mutex;
+
+    run_tasks(state, executor, [&](std::atomic<int>& done) {
+        for (int i = 0; i < rounds; ++i) {
+            std::lock_guard lock(mutex);
+            critical_section();
+        }
+        done.fetch_add(1, std::memory_order::release);
+    });
+}
+
+void BM_AsyncMutex(benchmark::State& state) {
+    const int rounds = static_cast<int>(state.range(0));
+    Executor executor(pool_size());
+    wr::AsyncMutex<Executor> mutex(&executor);
+
+    run_tasks(state, executor, [&](std::atomic<int>& done) {
+        async_locker(mutex, rounds, done);
+    });
+}
+
+// -------------------- Semaphore (4 permits) --------------------
+
+constexpr size_t kPermits = 4;
+
+Detached async_acquirer(wr::AsyncSemaphore<Executor>& semaphore, int rounds, std::atomic<int>& done) {
+    for (int i = 0; i < rounds; ++i) {
+        co_await semaphore.acquire();
+        critical_section();
+        semaphore.release();
+    }
+    done.fetch_add(1, std::memory_order::release);
+}
+
+void BM_StdCountingSemaphore(benchmark::State& state) {
+    const int rounds = static_cast<int>(state.range(0));
+    Executor executor(pool_size());
+    std::counting_semaphore<> semaphore(kPermits);
+
+    run_tasks(state, executor, [&](std::atomic<int>& done) {
+        for (int i = 0; i < rounds; ++i) {
+            semaphore.acquire();
+            critical_section();
+            semaphore.release();
+        }
+        done.fetch_add(1, std::memory_order::release);
+    });
+}
+
+void BM_AsyncSemaphore(benchmark::State& state) {
+    const int rounds = static_cast<int>(state.range(0));
+    Executor executor(pool_size());
+    wr::AsyncSemaphore<Executor> semaphore(&executor, kPermits);
+
+    run_tasks(state, executor, [&](std::atomic<int>& done) {
+        async_acquirer(semaphore, rounds, done);
+    });
+}
+
+}  // namespace
+
+BENCHMARK(BM_StdMutex)->RangeMultiplier(4)->Range(1, 64)->UseRealTime();
+BENCHMARK(BM_AsyncMutex)->RangeMultiplier(4)->Range(1, 64)->UseRealTime();
+BENCHMARK(BM_StdCountingSemaphore)->RangeMultiplier(4)->Range(1, 64)->UseRealTime();
+BENCHMARK(BM_AsyncSemaphore)->RangeMultiplier(4)->Range(1, 64)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "../utils/constants.hpp"
+
+namespace wr::coord {
+
+/* Admission control of the injected work (`Config::kInjectionCapacity`): one counter of the tasks which
+ * sit in the injection queues (global queues + task groups), maintained without locks.
+ *
+ *  >> every push into an injection queue is counted (`acquire`), every pop is uncounted (`release`)
+ *     => plain `submit` and the overflow of the local queues are never refused, but they take room
+ *  >> `try_acquire` admits a task only while the count is below the capacity (CAS, no overshoot)
+ *  >> external producers wait for room on the counter itself (`std::atomic::wait`),
+ *     consumers notify only if somebody waits
+ *  >> watermarks with hysteresis: `overloaded()` turns on at `HighWatermark` and stays on until the count
+ *     falls to `LowWatermark` => a stable signal to shed load upstream */
+template <size_t Capacity, size_t HighWatermark, size_t LowWatermark>
+class alignas(utils::constants::CACHE_LINE_SIZE) Admission {
+    static_assert(Capacity > 0, "zero capacity => admission control is off, do not instantiate");
+    static_assert(LowWatermark < HighWatermark && HighWatermark <= Capacity, "0 <= low < high <= capacity");
+
+  private:  // data members:
+    std::atomic<size_t> queued_ = 0;
+    std::atomic<size_t> waiters_ = 0;  // producers in `wait_for_room`
+    std::atomic<bool> overloaded_ = false;
+
+  public:  // member functions:
+    Admission() = default;
+    ~Admission() = default;
+
+    Admission(const Admission&) = delete;
+    Admission& operator=(const Admission&) = delete;
+    Admission(Admission&&) = delete;
+    Admission& operator=(Admission&&) = delete;
+
+    /*
+     * @brief Take room for one task if there is any.
+     */
+    bool try_acquire() noexcept;
+
+    /*
+     * @brief Take room for `count` tasks unconditionally (may exceed the capacity).
+     */
+    void acquire(size_t count) noexcept;
+
+    /*
+     * @brief A task has left an injection queue.
+     */
+    void release() noexcept;
+
+    /*
+     * @brief Block until the count falls below the capacity. External threads only:
+     * a worker must help instead (see `WsExecutor::submit_bounded`).
+     */
+    void wait_for_room() noexcept;
+
+    bool has_room() const noexcept;
+    bool overloaded() const noexcept;
+    size_t size() const noexcept;
+
+  private:  // member functions:
+    void on_grown(size_t queued) noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <size_t Capacity, size_t HighWatermark, size_t LowWatermark>
+bool Admission<Capacity, HighWatermark, LowWatermark>::try_acquire() noexcept {
+    size_t queued = queued_.load(std::memory_order::relaxed);
+    do {
+        if (queued >= Capacity) {
+            return false;
+        }
+    } while (!queued_.compare_exchange_weak(queued, queued + 1, std::memory_order::relaxed));
+
+    on_grown(queued + 1);
+    return true;
+}
+
+template <size_t Capacity, size_t HighWatermark, size_t LowWatermark>
+void Admission<Capacity, HighWatermark, LowWatermark>::acquire(size_t count) noexcept {
+    ///
+    on_grown(queued_.fetch_add(count, std::memory_order::relaxed) + count);
+    ///
+}
+
+template <size_t Capacity, size_t HighWatermark, size_t LowWatermark>
+void Admission<Capacity, HighWatermark, LowWatermark>::release() noexcept {
+    // seq_cst: Dekker-style handshake with `wait_for_room` (either it sees the room, or we see the waiter)
+    const size_t queued = queued_.fetch_sub(1) - 1;
+
+    if (queued <= LowWatermark && overloaded_.load(std::memory_order::relaxed)) {
+        overloaded_.store(false, std::memory_order::relaxed);
+    }
+    if (queued < Capacity && waiters_.load() > 0) {
+        queued_.notify_all();
+    }
+}
+
+template <size_t Capacity, size_t HighWatermark, size_t LowWatermark>
+void Admission<Capacity, HighWatermark, LowWatermark>::wait_for_room() noexcept {
+    waiters_.fetch_add(1);
+    while (true) {
+        const size_t queued = queued_.load();
+        if (queued < Capacity) {
+            break;
+        }
+        queued_.wait(queued);  // returns at once if the count has already changed
+    }
+    waiters_.fetch_sub(1, std::memory_order::relaxed);
+}
+
+template <size_t Capacity, size_t HighWatermark, size_t LowWatermark>
+bool Admission<Capacity, HighWatermark, LowWatermark>::has_room() const noexcept {
+    ///
+    return queued_.load(std::memory_order::relaxed) < Capacity;
+    ///
+}
+
+template <size_t Capacity, size_t HighWatermark, size_t LowWatermark>
+bool Admission<Capacity, HighWatermark, LowWatermark>::overloaded() const noexcept {
+    // the flag only decides inside the hysteresis band => a racy store cannot leave it stuck
+    const size_t queued = queued_.load(std::memory_order::relaxed);
+    return queued >= HighWatermark || (queued > LowWatermark && overloaded_.load(std::memory_order::relaxed));
+}
+
+template <size_t Capacity, size_t HighWatermark, size_t LowWatermark>
+size_t Admission<Capacity, HighWatermark, LowWatermark>::size() const noexcept {
+    ///
+    return queued_.load(std::memory_order::relaxed);
+    ///
+}
+
+template <size_t Capacity, size_t HighWatermark, size_t LowWatermark>
+void Admission<Capacity, HighWatermark, LowWatermark>::on_grown(size_t queued) noexcept {
+    if (queued >= HighWatermark && !overloaded_.load(std::memory_order::relaxed)) {
+        overloaded_.store(true, std::memory_order::relaxed);
+    }
+}
+
+}  // namespace wr::coord
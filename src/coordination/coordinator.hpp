@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "directive.hpp"
 #include "throttler.hpp"
 
@@ -12,31 +14,56 @@ namespace wr::coord {
 class Coordinator {
   public:  // nested types:
     using SearchPermit = Throttler::StealPermit;
+    using WakeFn = void (*)(void*) noexcept;
 
   private:  // data members:
     Throttler semaphore_;
     std::atomic<bool> shutdown_requested_ = false;
     std::atomic<bool> work_maybe_available_ = false;
 
+    // a worker which sleeps outside of the throttler (in the I/O reactor) is woken through this
+    WakeFn external_wake_ = nullptr;
+    void* external_wake_context_ = nullptr;
+
   public:  // member functions:
     explicit Coordinator(size_t total_workers);
 
     // main method for requesting instructions by Worker
     [[nodiscard]] Directive ask_to_steal() noexcept;
 
-    void park_worker() noexcept;
+    /* `index` < total_workers: the worker parks on a slot of its own */
+    void park_worker(size_t index) noexcept;
+
+    /* parks the worker until it is notified or `has_work` starts to hold; `has_work` is evaluated
+     * after the worker is accounted as parked, so work published before the notification is never missed */
+    template <WakeCondition Predicate>
+    void park_worker(size_t index, Predicate&& has_work) noexcept;
+
+    /* the same, bounded by `deadline` (the next timer of the executor) */
+    template <WakeCondition Predicate>
+    void park_worker_until(size_t index, std::chrono::steady_clock::time_point deadline, Predicate&& has_work) noexcept;
 
     void notify_worker() noexcept;
 
+    /* wakes the worker `index` only (work which only it may run): from its park slot, or through the
+     * external waker if it is not parked there (it may sleep in the reactor) */
+    void wake_worker(size_t index) noexcept;
+
+    /* wakes every parked worker: shutdown */
+    void notify_all_workers() noexcept;
+
     void shutdown() noexcept;
 
+    /* must be set before the workers start */
+    void set_external_waker(WakeFn wake, void* context) noexcept;
+
     bool should_shutdown() const noexcept;
 };
 
 /* ---------------------------------- IMPLEMENTATION ---------------------------------- */
 
 inline Coordinator::Coordinator(size_t total_workers)
-    : semaphore_(total_workers > 1 ? total_workers / 2 : 1) {}
+    : semaphore_(total_workers > 1 ? total_workers / 2 : 1, total_workers) {}
 
 inline auto Coordinator::ask_to_steal() noexcept -> Directive {
     if (shutdown_requested_.load()) {
@@ -58,12 +85,27 @@ inline auto Coordinator::ask_to_steal() noexcept -> Directive {
     return Directive::Park();
 }
 
-inline void Coordinator::park_worker() noexcept {
-    semaphore_.park([this] {
+inline void Coordinator::park_worker(size_t index) noexcept {
+    semaphore_.park(index, [this] {
         return shutdown_requested_.load();
     });
 }
 
+template <WakeCondition Predicate>
+void Coordinator::park_worker(size_t index, Predicate&& has_work) noexcept {
+    semaphore_.park(index, [this, &has_work] {
+        return shutdown_requested_.load() || work_maybe_available_.exchange(false) || has_work();
+    });
+}
+
+template <WakeCondition Predicate>
+void Coordinator::park_worker_until(size_t index, std::chrono::steady_clock::time_point deadline,
+                                    Predicate&& has_work) noexcept {
+    semaphore_.park_until(index, deadline, [this, &has_work] {
+        return shutdown_requested_.load() || work_maybe_available_.exchange(false) || has_work();
+    });
+}
+
 inline void Coordinator::notify_worker() noexcept {
     if (semaphore_.searchers_count() > 0) {
         work_maybe_available_.store(true);
@@ -72,12 +114,39 @@ inline void Coordinator::notify_worker() noexcept {
 
     if (semaphore_.parked_count() > 0) {
         semaphore_.notify_work_available();
+        return;
+    }
+
+    // nobody sleeps on the condvar, but the reactor's poller may sleep in epoll
+    if (external_wake_ != nullptr) {
+        external_wake_(external_wake_context_);
+    }
+}
+
+inline void Coordinator::wake_worker(size_t index) noexcept {
+    if (semaphore_.notify_worker(index)) {
+        return;
+    }
+    if (external_wake_ != nullptr) {
+        external_wake_(external_wake_context_);
+    }
+}
+
+inline void Coordinator::notify_all_workers() noexcept {
+    semaphore_.notify_all_workers();
+    if (external_wake_ != nullptr) {
+        external_wake_(external_wake_context_);
     }
 }
 
 inline void Coordinator::shutdown() noexcept {
     shutdown_requested_.store(true);
-    semaphore_.notify_all_workers();
+    notify_all_workers();
+}
+
+inline void Coordinator::set_external_waker(WakeFn wake, void* context) noexcept {
+    external_wake_ = wake;
+    external_wake_context_ = context;
 }
 
 inline bool Coordinator::should_shutdown() const noexcept {
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "wake_condition.hpp"
 
@@ -13,7 +18,11 @@ namespace wr::coord {
 
 /* Throttler is a component that stores information about the number of workers in the active steal
  * phase and the number of workers which are parked. It works on the principle of TaggedSemaphore,
- * limiting the number of thieves-workers in the WS Scheduler: */
+ * limiting the number of thieves-workers in the WS Scheduler.
+ *
+ * Every worker parks on a slot of its own (a condvar + a flag under the shared mutex) => a wakeup is
+ * delivered to exactly one worker: the most recently parked one for new work, or a given one for work
+ * which only it may run (its inbox, a handed-over batch, the timekeeper's alarm). */
 class Throttler /* Semaphore */ {
   public:  // nested types:
     class StealPermit /* is a linear type and RAII-wrapper for semaphore counter unit */ {
@@ -38,25 +47,41 @@ class Throttler /* Semaphore */ {
         explicit StealPermit(Throttler* host) : host_(host) {}
     };
 
+  private:  // nested types:
+    struct ParkSlot {
+        std::condition_variable wake;
+        bool parked = false;    // in `idle_`; guarded by `wait_mutex_`
+        bool notified = false;  // taken out of `idle_` by a notifier; guarded by `wait_mutex_`
+    };
+
   private:  // data members:
     const size_t max_searchers_count_;
     std::atomic<size_t> searchers_count_ = 0;
     std::atomic<size_t> parked_count_ = 0;
 
     std::mutex wait_mutex_;
-    std::condition_variable work_available_;
-    std::atomic<bool> work_hint_ = false;
+    std::unique_ptr<ParkSlot[]> slots_;  // one per worker
+    std::vector<size_t> idle_;           // parked slots, the most recent last; never reallocates
 
   public:  // member functions:
-    explicit Throttler(size_t max_searchers) : max_searchers_count_(max_searchers) {}
+    Throttler(size_t max_searchers, size_t slots);
 
     [[nodiscard]] std::optional<StealPermit> try_acquire_permit() noexcept;
 
+    /* parks on `slot` (< slots) until notified or `stop_waiting` holds */
     template <WakeCondition Predicate>
-    void park(Predicate&& stop_waiting) noexcept;
+    void park(size_t slot, Predicate&& stop_waiting) noexcept;
 
+    /* the same, but wakes up by itself at `deadline` */
+    template <WakeCondition Predicate>
+    void park_until(size_t slot, std::chrono::steady_clock::time_point deadline, Predicate&& stop_waiting) noexcept;
+
+    /* wakes the most recently parked worker (its caches are the warmest), unless somebody is searching */
     void notify_work_available() noexcept;
 
+    /* wakes the worker parked on `slot` only; false if it is not parked here */
+    bool notify_worker(size_t slot) noexcept;
+
     void notify_all_workers() noexcept;
 
     size_t searchers_count() const noexcept;
@@ -65,6 +90,13 @@ class Throttler /* Semaphore */ {
 
   private:  // member functions:
     void on_permit_released() noexcept;
+
+    // lists `slot` as parked / takes it off the list after the wait; under `wait_mutex_`
+    ParkSlot& enlist(size_t slot) noexcept;
+    void delist(size_t slot) noexcept;
+
+    // takes the parked slot out of `idle_` and wakes it; under `wait_mutex_`
+    void wake_locked(size_t slot) noexcept;
 };
 
 /* ---------------------------------- IMPLEMENTATION ---------------------------------- */
@@ -85,6 +117,11 @@ inline void Throttler::StealPermit::release() noexcept {
     }
 }
 
+inline Throttler::Throttler(size_t max_searchers, size_t slots)
+    : max_searchers_count_(max_searchers), slots_(std::make_unique<ParkSlot[]>(slots)) {
+    idle_.reserve(slots);
+}
+
 inline std::optional<Throttler::StealPermit> Throttler::try_acquire_permit() noexcept {
     // trying to give `SearchPermit` via CAS:
     size_t current_searchers_count_ = searchers_count_.load();
@@ -98,26 +135,40 @@ inline std::optional<Throttler::StealPermit> Throttler::try_acquire_permit() noe
 }
 
 template <WakeCondition Predicate>
-void Throttler::park(Predicate&& stop_waiting) noexcept {
+void Throttler::park(size_t slot, Predicate&& stop_waiting) noexcept {
     // `stop_waiting` should be noexcept ^
     std::unique_lock<std::mutex> lock(wait_mutex_);
-    parked_count_.fetch_add(1);
+    ParkSlot& self = enlist(slot);
 
-    work_available_.wait(lock, [this, &stop_waiting] {
+    self.wake.wait(lock, [&self, &stop_waiting] {
         // Condition to wake:
-        // 1. external reason (stop_waiting)
-        // 2. or an internal work hint (work_hint)
-        if (stop_waiting()) {
-            return true;
-        }
-        if (work_hint_.load()) {
-            work_hint_.store(false);
-            return true;
-        }
-        return false;
+        // 1. a notifier has picked this slot
+        // 2. or an external reason (stop_waiting)
+        return self.notified || stop_waiting();
     });
 
-    parked_count_.fetch_sub(1);
+    delist(slot);
+}
+
+template <WakeCondition Predicate>
+void Throttler::park_until(size_t slot, std::chrono::steady_clock::time_point deadline,
+                           Predicate&& stop_waiting) noexcept {
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    ParkSlot& self = enlist(slot);
+
+#if defined(__SANITIZE_THREAD__)
+    // TSan of GCC 12 does not intercept `pthread_cond_clockwait` (steady clock waits) and reports a double
+    // lock => wait on the system clock there
+    const auto until = std::chrono::system_clock::now() + (deadline - std::chrono::steady_clock::now());
+#else
+    const auto until = deadline;
+#endif
+
+    self.wake.wait_until(lock, until, [&self, &stop_waiting] {
+        return self.notified || stop_waiting();
+    });
+
+    delist(slot);
 }
 
 inline void Throttler::notify_work_available() noexcept {
@@ -129,18 +180,58 @@ inline void Throttler::notify_work_available() noexcept {
     }
     // else (if every Worker sleep or busy): Coordinator notify one sleeping worker:
     if (parked_count_.load() > 0) {
-        {
-            std::lock_guard<std::mutex> lock(wait_mutex_);
-            work_hint_.store(true);
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        if (!idle_.empty()) {
+            wake_locked(idle_.back());
         }
-        work_available_.notify_one();
     }
 }
 
+inline bool Throttler::notify_worker(size_t slot) noexcept {
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    if (!slots_[slot].parked) {
+        return false;
+    }
+    wake_locked(slot);
+    return true;
+}
+
 inline void Throttler::notify_all_workers() noexcept {
-    // for scheduler shutdowning process
+    // for scheduler shutdowning process: the sleepers re-check their wake conditions
     std::lock_guard lock(wait_mutex_);
-    work_available_.notify_all();
+    for (size_t slot : idle_) {
+        slots_[slot].wake.notify_one();
+    }
+}
+
+inline auto Throttler::enlist(size_t slot) noexcept -> ParkSlot& {
+    ParkSlot& self = slots_[slot];
+    assert(!self.parked && "a slot is parked on by one worker at a time");
+
+    self.parked = true;
+    idle_.push_back(slot);
+    parked_count_.fetch_add(1);
+    return self;
+}
+
+inline void Throttler::delist(size_t slot) noexcept {
+    ParkSlot& self = slots_[slot];
+
+    // woken up by itself (`stop_waiting`, the deadline) => still listed
+    if (self.parked) {
+        self.parked = false;
+        idle_.erase(std::find(idle_.begin(), idle_.end(), slot));
+    }
+    self.notified = false;
+    parked_count_.fetch_sub(1);
+}
+
+inline void Throttler::wake_locked(size_t slot) noexcept {
+    ParkSlot& target = slots_[slot];
+    target.parked = false;
+    target.notified = true;
+    idle_.erase(std::find(idle_.begin(), idle_.end(), slot));
+    target.wake.notify_one();
 }
 
 inline size_t Throttler::searchers_count() const noexcept {
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+
+namespace wr::config {
+
+/* Where the overflow of a full local queue goes (half of it, see `WorkStealingQueue::offload_half`) */
+enum class OverflowPolicy : uint8_t {
+    kGlobalQueue,  // to the global queue: the others find it on the fairness tick or when they run dry
+    kIdleWorker,   // handed over to a parked or searching worker, which is woken; the global queue if none
+};
+
+/* Optional knobs of an `ExecutionConfig`.
+ * The concept only requires the essentials; everything else is looked up here and falls back to a
+ * default when the config does not declare it => user configs do not break when a knob is added. */
+template <typename C>
+struct Options {
+    /* `this_worker::arena()` is rewound after every task (see `memory/arena.hpp`) */
+    static constexpr bool kArenaResetPerTask = [] {
+        if constexpr (requires { C::kArenaResetPerTask; }) {
+            return static_cast<bool>(C::kArenaResetPerTask);
+        } else {
+            return true;
+        }
+    }();
+
+    /* size of a chunk of the per-worker arena */
+    static constexpr size_t kArenaChunkSize = [] {
+        if constexpr (requires { C::kArenaChunkSize; }) {
+            return static_cast<size_t>(C::kArenaChunkSize);
+        } else {
+            return size_t{64} * 1024;
+        }
+    }();
+
+    /* back arena chunks with huge pages (falls back to regular pages if they are unavailable) */
+    static constexpr bool kArenaHugePages = [] {
+        if constexpr (requires { C::kArenaHugePages; }) {
+            return static_cast<bool>(C::kArenaHugePages);
+        } else {
+            return false;
+        }
+    }();
+
+    /* ring capacity of the per-worker inbox (`WsExecutor::submit_to`), power of two */
+    static constexpr size_t kInboxCapacity = [] {
+        if constexpr (requires { C::kInboxCapacity; }) {
+            return static_cast<size_t>(C::kInboxCapacity);
+        } else {
+            return size_t{1024};
+        }
+    }();
+
+    /* number of strict priority levels, 0 is the highest (see `WsExecutor::submit`) */
+    static constexpr size_t kPriorityLevels = [] {
+        if constexpr (requires { C::kPriorityLevels; }) {
+            return static_cast<size_t>(C::kPriorityLevels);
+        } else {
+            return size_t{1};
+        }
+    }();
+
+    /* anti-starvation: every `kPriorityAgingPeriod`-th pick serves the lowest non-empty level first (0 => off) */
+    static constexpr size_t kPriorityAgingPeriod = [] {
+        if constexpr (requires { C::kPriorityAgingPeriod; }) {
+            return static_cast<size_t>(C::kPriorityAgingPeriod);
+        } else {
+            return size_t{0};
+        }
+    }();
+
+    /* capacity for task groups with weighted fair sharing (`WsExecutor::add_group`), 0 => no groups */
+    static constexpr size_t kMaxTaskGroups = [] {
+        if constexpr (requires { C::kMaxTaskGroups; }) {
+            return static_cast<size_t>(C::kMaxTaskGroups);
+        } else {
+            return size_t{0};
+        }
+    }();
+
+    /* weight of the work submitted outside of any group, relative to the weights of the groups */
+    static constexpr size_t kDefaultGroupWeight = [] {
+        if constexpr (requires { C::kDefaultGroupWeight; }) {
+            return static_cast<size_t>(C::kDefaultGroupWeight);
+        } else {
+            return size_t{1};
+        }
+    }();
+
+    /* tick of the timer wheel (`WsExecutor::submit_after`) in microseconds: timers fire on tick boundaries */
+    static constexpr size_t kTimerResolutionUs = [] {
+        if constexpr (requires { C::kTimerResolutionUs; }) {
+            return static_cast<size_t>(C::kTimerResolutionUs);
+        } else {
+            return size_t{1000};
+        }
+    }();
+
+    /* epoll reactor polled by idle workers (`WsExecutor::reactor`), Linux only */
+    static constexpr bool kEnableReactor = [] {
+        if constexpr (requires { C::kEnableReactor; }) {
+            return static_cast<bool>(C::kEnableReactor);
+        } else {
+            return false;
+        }
+    }();
+
+    /* bound on the tasks queued in the injection queues (`WsExecutor::try_submit`), 0 => unbounded */
+    static constexpr size_t kInjectionCapacity = [] {
+        if constexpr (requires { C::kInjectionCapacity; }) {
+            return static_cast<size_t>(C::kInjectionCapacity);
+        } else {
+            return size_t{0};
+        }
+    }();
+
+    /* `WsExecutor::overloaded()` turns on at the high watermark and off at the low one */
+    static constexpr size_t kInjectionHighWatermark = [] {
+        if constexpr (requires { C::kInjectionHighWatermark; }) {
+            return static_cast<size_t>(C::kInjectionHighWatermark);
+        } else {
+            return kInjectionCapacity - kInjectionCapacity / 4;
+        }
+    }();
+
+    static constexpr size_t kInjectionLowWatermark = [] {
+        if constexpr (requires { C::kInjectionLowWatermark; }) {
+            return static_cast<size_t>(C::kInjectionLowWatermark);
+        } else {
+            return kInjectionCapacity / 2;
+        }
+    }();
+
+    static constexpr OverflowPolicy kOverflowPolicy = [] {
+        if constexpr (requires { C::kOverflowPolicy; }) {
+            return static_cast<OverflowPolicy>(C::kOverflowPolicy);
+        } else {
+            return OverflowPolicy::kGlobalQueue;
+        }
+    }();
+
+    /* per-worker scheduler counters (`WsExecutor::stats`), compiled out when off */
+    static constexpr bool kEnableStats = [] {
+        if constexpr (requires { C::kEnableStats; }) {
+            return static_cast<bool>(C::kEnableStats);
+        } else {
+            return false;
+        }
+    }();
+
+    /* cycles per phase of the run loop (`WsExecutor::stats`, `WorkerStats::utilization`), compiled out when off */
+    static constexpr bool kEnableCycleAccounting = [] {
+        if constexpr (requires { C::kEnableCycleAccounting; }) {
+            return static_cast<bool>(C::kEnableCycleAccounting);
+        } else {
+            return false;
+        }
+    }();
+
+    /* queue-wait / execution histograms (`WsExecutor::latency`), the task type must be a `StampedTask` */
+    static constexpr bool kEnableLatency = [] {
+        if constexpr (requires { C::kEnableLatency; }) {
+            return static_cast<bool>(C::kEnableLatency);
+        } else {
+            return false;
+        }
+    }();
+
+    /* per-worker state published into a POSIX shared-memory segment for `wr-top` (`WsExecutor::introspection_name`) */
+    static constexpr bool kEnableIntrospection = [] {
+        if constexpr (requires { C::kEnableIntrospection; }) {
+            return static_cast<bool>(C::kEnableIntrospection);
+        } else {
+            return false;
+        }
+    }();
+
+    /* period of the samples of the segment */
+    static constexpr uint32_t kIntrospectionPeriodMs = [] {
+        if constexpr (requires { C::kIntrospectionPeriodMs; }) {
+            return static_cast<uint32_t>(C::kIntrospectionPeriodMs);
+        } else {
+            return uint32_t{100};
+        }
+    }();
+
+    /* per-worker trace rings (`WsExecutor::dump_trace`), compiled out when off */
+    static constexpr bool kEnableTracing = [] {
+        if constexpr (requires { C::kEnableTracing; }) {
+            return static_cast<bool>(C::kEnableTracing);
+        } else {
+            return false;
+        }
+    }();
+
+    /* events kept per worker (16 bytes each), a power of two: older ones are overwritten */
+    static constexpr size_t kTraceCapacity = [] {
+        if constexpr (requires { C::kTraceCapacity; }) {
+            return static_cast<size_t>(C::kTraceCapacity);
+        } else {
+            return size_t{1} << 16;
+        }
+    }();
+
+    /* a task running longer than this is reported (`WsExecutor::on_stall`), 0 => no watchdog thread */
+    static constexpr uint32_t kWatchdogThresholdMs = [] {
+        if constexpr (requires { C::kWatchdogThresholdMs; }) {
+            return static_cast<uint32_t>(C::kWatchdogThresholdMs);
+        } else {
+            return uint32_t{0};
+        }
+    }();
+
+    /* the stalled worker is signalled to capture its stack into the report (glibc only) */
+    static constexpr bool kWatchdogBacktrace = [] {
+        if constexpr (requires { C::kWatchdogBacktrace; }) {
+            return static_cast<bool>(C::kWatchdogBacktrace);
+        } else {
+            return false;
+        }
+    }();
+
+    /* the signal for the backtrace: its handler is replaced process-wide */
+    static constexpr int kWatchdogSignal = [] {
+        if constexpr (requires { C::kWatchdogSignal; }) {
+            return static_cast<int>(C::kWatchdogSignal);
+        } else {
+            return SIGURG;
+        }
+    }();
+
+    /* submit / run events of every task logged for `WsExecutor::record_to` (see `record/readme.md`) */
+    static constexpr bool kEnableRecording = [] {
+        if constexpr (requires { C::kEnableRecording; }) {
+            return static_cast<bool>(C::kEnableRecording);
+        } else {
+            return false;
+        }
+    }();
+};
+
+}  // namespace wr::config
@@ -1,26 +1,165 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <cassert>
+#include <chrono>
+#include <concepts>
+#include <fstream>
+#include <iostream>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <variant>
+#include <vector>
 
+#include <ntrusive/intrusive.hpp>
+
+#include "../coordination/admission.hpp"
+#include "../coordination/coordinator.hpp"
+#include "../introspect/publisher.hpp"
+#include "../io/reactor.hpp"
+#include "../queues/global/global_queue.hpp"
+#include "../queues/global/group_queue.hpp"
+#include "../record/format.hpp"
+#include "../record/recorder.hpp"
+#include "../tasks/closure.hpp"
 #include "../tasks/concept.hpp"
+#include "../tasks/stamped_task.hpp"
+#include "../tasks/task_base.hpp"
+#include "../timer/timer_queue.hpp"
+#include "../timer/timer_task.hpp"
+#include "../trace/export.hpp"
+#include "../utils/tsc.hpp"
+#include "../watchdog/backtrace.hpp"
+#include "../watchdog/watchdog.hpp"
 #include "../worker/worker.hpp"
 #include "config/concept.hpp"
 #include "config/config.hpp"
+#include "config/options.hpp"
+#include "sender/bulk.hpp"
+#include "sender/scheduler.hpp"
 
 namespace wr {
 
-template <task::Task TaskType, config::ExecutionConfig Config = config::DefaultConfig>
+// TaskType = TaskBase: heterogeneous tasks, dispatched through a function pointer;
+// TaskType = concrete task: the pool is specialized for a single task type.
+template <task::Task TaskType = TaskBase, config::ExecutionConfig Config = config::DefaultConfig>
 class WsExecutor {
   public:  // nested types:
+    using TaskT = TaskType;
     using WorkerType = Worker<TaskType, Config>;
+    using Batch = IntrusiveList<TaskType>;
+    using Scheduler = exec::Scheduler<WsExecutor>;
+
+    // strict priority levels (`Config::kPriorityLevels`, 1 by default): 0 is the highest,
+    // work of a lower level runs only when no worker can find work of a higher one
+    static constexpr size_t kPriorityLevels = config::Options<Config>::kPriorityLevels;
+    static constexpr size_t kDefaultPriority = kPriorityLevels - 1;
+
+    // task groups (tenants) sharing the injected work by weight: `Config::kMaxTaskGroups`, 0 by default
+    static constexpr size_t kMaxTaskGroups = config::Options<Config>::kMaxTaskGroups;
+
+    using GroupId = size_t;
+
+    using Clock = std::chrono::steady_clock;
+    using TimerTaskT = TimerTask<TaskType>;
+
+    static constexpr bool kEnableReactor = config::Options<Config>::kEnableReactor;
+
+    using Reactor = io::Reactor<TaskType>;
+    using IoTaskT = IoTask<TaskType>;
+
+    // bound on the injected work (`Config::kInjectionCapacity`), 0 => unbounded and not tracked
+    static constexpr size_t kInjectionCapacity = config::Options<Config>::kInjectionCapacity;
+
+    // per-worker counters (`Config::kEnableStats`)
+    static constexpr bool kEnableStats = config::Options<Config>::kEnableStats;
+    using Stats = stats::Snapshot;
+
+    // cycles per phase of the run loop, reported as `WorkerStats::utilization` (`Config::kEnableCycleAccounting`)
+    static constexpr bool kEnableCycleAccounting = config::Options<Config>::kEnableCycleAccounting;
+
+    // queue-wait / execution histograms (`Config::kEnableLatency`, TaskType = `StampedTask<...>`)
+    static constexpr bool kEnableLatency = config::Options<Config>::kEnableLatency;
+    using Latency = stats::LatencySnapshot;
+
+    // per-worker trace rings (`Config::kEnableTracing`)
+    static constexpr bool kEnableTracing = config::Options<Config>::kEnableTracing;
+
+    // shared-memory records for `wr-top` (`Config::kEnableIntrospection`)
+    static constexpr bool kEnableIntrospection = config::Options<Config>::kEnableIntrospection;
+
+    // reports of the tasks which run for longer than `Config::kWatchdogThresholdMs` (0 => off)
+    static constexpr bool kEnableWatchdog = config::Options<Config>::kWatchdogThresholdMs > 0;
+
+    // submit / run log of every task for `analysis/replay` (`Config::kEnableRecording`)
+    static constexpr bool kEnableRecording = config::Options<Config>::kEnableRecording;
+
+    using Admission = coord::Admission<kInjectionCapacity, config::Options<Config>::kInjectionHighWatermark,
+                                       config::Options<Config>::kInjectionLowWatermark>;
+
+    struct GroupStats {
+        size_t weight;
+        uint64_t submitted;
+        uint64_t executed;  // taken by the workers
+    };
 
   private:  // data members:
     std::vector<std::unique_ptr<WorkerType>> workers_;
-    std::atomic<int> active_stealers_{0};
-    size_t max_stealers_;
+    std::array<queues::GlobalQueue<TaskType>, kPriorityLevels> global_queues_;
+
+    std::array<queues::GroupQueue<TaskType>, kMaxTaskGroups> groups_;
+    std::atomic<size_t> groups_count_ = 0;  // published groups
+    std::mutex groups_mutex_;               // registration only
+
+    timer::TimerQueue<TaskType> timers_{std::chrono::microseconds(config::Options<Config>::kTimerResolutionUs)};
+    // alarm (tick) of the parked worker which keeps time, `kNever` if nobody does
+    std::atomic<uint64_t> timekeeper_deadline_ = timer::TimerWheel::kNever;
+    // index of that worker, meaningful while the alarm is set (stored right after it is claimed)
+    std::atomic<size_t> timekeeper_ = 0;
+
+    [[no_unique_address]] std::conditional_t<kEnableReactor, std::unique_ptr<Reactor>, std::monostate> reactor_;
+
+    // tasks in the injection queues
+    [[no_unique_address]] std::conditional_t<(kInjectionCapacity > 0), Admission, std::monostate> admission_;
+    coord::Coordinator coordinator_;
     size_t num_workers_;
 
+    utils::tsc::Calibration tsc_calibration_;
+
+    struct TraceDestination {
+        std::string path;  // empty => no dump at shutdown
+        trace::Format format = trace::Format::kChromeJson;
+    };
+    [[no_unique_address]] std::conditional_t<kEnableTracing, TraceDestination, std::monostate> trace_at_shutdown_;
+
+    // samples the pool into the segment; stopped before the workers
+    [[no_unique_address]] std::conditional_t<kEnableIntrospection, std::unique_ptr<introspect::Publisher>,
+                                             std::monostate>
+        publisher_;
+
+    // compares the task stamps of the workers with the clock; stopped before the workers
+    [[no_unique_address]] std::conditional_t<kEnableWatchdog, std::unique_ptr<watchdog::Watchdog>, std::monostate>
+        watchdog_;
+
+    // the workers log into their own recorders, the external submitters into this one (under the lock)
+    struct ExternalRecording {
+        std::mutex mutex;
+        record::Recorder<true> recorder;
+        std::string path;  // empty => nothing is written at shutdown
+    };
+    [[no_unique_address]] std::conditional_t<kEnableRecording, ExternalRecording, std::monostate> recording_;
+
+  public:  // friendship declaration:
+    friend class Worker<TaskType, Config>;
+
   public:  // member functions:
     WsExecutor(size_t workers_count);
     ~WsExecutor();
@@ -30,8 +169,739 @@ class WsExecutor {
     WsExecutor& operator=(const WsExecutor&) = delete;
     WsExecutor& operator=(WsExecutor&&) = delete;
 
-    void submit(TaskType* task) noexcept;
+    // `priority` < kPriorityLevels; by default tasks go to the lowest level
+    void submit(TaskType* task, size_t priority = kDefaultPriority) noexcept;
+
+    // Wraps the callable into a task stored in the current worker's block pool
+    // (heap for external threads), see `tasks/closure.hpp`.
+    template <typename F>
+        requires std::invocable<std::decay_t<F>&> && (!std::is_convertible_v<F, TaskType*>) &&
+                 task::TrampolineTask<TaskType>
+    void submit(F&& fun, size_t priority = kDefaultPriority);
+
+    // Pool for the closures submitted here: the current worker's if it is a worker of this executor, nullptr
+    // (=> heap) otherwise. A block from the pool of another executor could outlive it (freed by our worker).
+    memory::BlockPool* closure_pool() const noexcept;
+
+    // Queues the task behind the work already queued: to the injection queue, also from a worker (neither
+    // the LIFO slot nor the local queue). For tasks which give the worker away and come back (`Strand`).
+    void defer(TaskType* task, size_t priority = kDefaultPriority) noexcept;
+
+    // Admission control (`Config::kInjectionCapacity` > 0). False => the injection queues are full and the
+    // task has not been taken. From a worker the task goes to the local queue as usual (if admitted).
+    bool try_submit(TaskType* task, size_t priority = kDefaultPriority) noexcept
+        requires(kInjectionCapacity > 0);
+
+    // Waits for room: a worker runs other tasks of the executor meanwhile (a bounded number of nested
+    // waits), an external thread blocks.
+    void submit_bounded(TaskType* task, size_t priority = kDefaultPriority) noexcept
+        requires(kInjectionCapacity > 0);
+
+    template <typename F>
+        requires std::invocable<std::decay_t<F>&> && (!std::is_convertible_v<F, TaskType*>) &&
+                 task::TrampolineTask<TaskType>
+    void submit_bounded(F&& fun, size_t priority = kDefaultPriority);
+
+    // Load-shedding signal: on at `kInjectionHighWatermark` queued tasks, off at `kInjectionLowWatermark`
+    bool overloaded() const noexcept
+        requires(kInjectionCapacity > 0);
+
+    // tasks in the injection queues (plain `submit` and local overflow count too)
+    size_t injected() const noexcept
+        requires(kInjectionCapacity > 0);
+
+    // Pins the task to the worker `worker_index`: it goes to the worker's inbox,
+    // which is drained before the local queue and is never stolen from.
+    void submit_to(size_t worker_index, TaskType* task) noexcept;
+
+    // Docks the whole batch to the global queue under a single lock and wakes up
+    // to `batch size` workers. Used by bulk-like producers.
+    void submit_batch(Batch&& batch, size_t batch_size, size_t priority = kDefaultPriority) noexcept;
+
+    // Registers a task group with its own injection queue. Workers pull from the injection queues
+    // with a deficit round robin: a group gets `weight` tasks per round, the work submitted outside of
+    // groups gets `Config::kDefaultGroupWeight`. Groups live as long as the executor.
+    GroupId add_group(size_t weight)
+        requires(kMaxTaskGroups > 0);
+
+    // Always goes to the group's queue (also from a worker): that is where the share is enforced.
+    void submit_to_group(GroupId group, TaskType* task) noexcept
+        requires(kMaxTaskGroups > 0);
+
+    template <typename F>
+        requires std::invocable<std::decay_t<F>&> && (!std::is_convertible_v<F, TaskType*>) &&
+                 task::TrampolineTask<TaskType>
+    void submit_to_group(GroupId group, F&& fun);
+
+    GroupStats group_stats(GroupId group) const noexcept
+        requires(kMaxTaskGroups > 0);
+
+    // Delayed tasks: the task waits in the executor's timer wheel (no timer thread) and is injected
+    // when it expires, never earlier. Workers advance the wheel: on the fairness tick and before parking,
+    // the last one to park sleeps until the next deadline. Timers pending at destruction never run.
+    template <typename Rep, typename Period>
+    void submit_after(std::chrono::duration<Rep, Period> delay, TimerTaskT* task) noexcept;
+
+    void submit_at(Clock::time_point deadline, TimerTaskT* task) noexcept;
+
+    template <typename Rep, typename Period, typename F>
+        requires std::invocable<std::decay_t<F>&> && (!std::is_convertible_v<F, TimerTaskT*>) &&
+                 task::TrampolineTask<TaskType>
+    void submit_after(std::chrono::duration<Rep, Period> delay, F&& fun);
+
+    template <typename F>
+        requires std::invocable<std::decay_t<F>&> && (!std::is_convertible_v<F, TimerTaskT*>) &&
+                 task::TrampolineTask<TaskType>
+    void submit_at(Clock::time_point deadline, F&& fun);
+
+    // O(1). True if the timer was removed before it expired: the task will not run
+    bool cancel(TimerTaskT* task) noexcept;
+
+    // I/O readiness: register `IoTask`s here, ready ones are queued on the worker which polled them
+    Reactor& reactor() noexcept
+        requires kEnableReactor;
+
+    // Reads the counters of every worker while they run (relaxed loads): per worker + the total
+    Stats stats() const
+        requires(kEnableStats || kEnableCycleAccounting);
+
+    // Merges the histograms of the workers while they run; values are in TSC cycles (see `ns_per_cycle`)
+    Latency latency() const
+        requires kEnableLatency;
+
+    // Copies the trace rings of the workers while they run: the last `kTraceCapacity` events of each
+    std::vector<trace::WorkerTrace> trace() const
+        requires kEnableTracing;
+
+    // Chrome trace JSON / Perfetto protobuf of `trace()`, timestamps in ns since the start of the executor
+    void dump_trace(std::ostream& out, trace::Format format = trace::Format::kChromeJson) const
+        requires kEnableTracing;
+
+    // The destructor writes the trace to `path` once the workers have stopped
+    void dump_trace_at_shutdown(std::string path, trace::Format format = trace::Format::kChromeJson)
+        requires kEnableTracing;
+
+    // Name of the shared-memory segment (`wr-top <name>`), unlinked by the destructor
+    const std::string& introspection_name() const noexcept
+        requires kEnableIntrospection;
+
+    // Replaces the stall handler (the default prints to stderr); it runs on the watchdog thread,
+    // once per stalled task
+    void on_stall(watchdog::StallHandler handler)
+        requires kEnableWatchdog;
+
+    // The destructor writes the submit / run log to `path` once the workers have stopped (`record/format.hpp`)
+    void record_to(std::string path)
+        requires kEnableRecording;
+
+    // P2300-style scheduler: see `exec/sender/readme.md`
+    Scheduler get_scheduler() noexcept;
+
+    size_t workers_count() const noexcept;
+
+  private:  // member functions:
+    // injects the expired timers, returns their number
+    size_t poll_timers() noexcept;
+
+    // admission accounting, no-ops when the injected work is unbounded
+    void on_injected(size_t count) noexcept;
+    void on_taken() noexcept;
+
+    // the task enters the executor: the queue-wait stamp, the submit event of the recording
+    void on_submitted(TaskType* task) noexcept;
+    Batch stamp_batch(Batch&& batch) noexcept;
+
+    // one sample of every record of the segment (the publisher's thread)
+    void publish(introspect::Segment& segment) const
+        requires kEnableIntrospection;
+
+    // one pass of the watchdog: `reported[i]` is the start stamp of the last task reported on worker `i`
+    void check_stalls(watchdog::Watchdog& dog, std::vector<uint64_t>& reported)
+        requires kEnableWatchdog;
 };
 
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+WsExecutor<TaskType, Config>::WsExecutor(size_t workers_count)
+    : coordinator_(workers_count), num_workers_(workers_count) {
+    if constexpr (kEnableReactor) {
+        reactor_ = std::make_unique<Reactor>();
+        coordinator_.set_external_waker(&Reactor::wake_thunk, reactor_.get());
+    }
+
+    workers_.reserve(num_workers_);
+    for (size_t i = 0; i < num_workers_; ++i) {
+        workers_.push_back(std::make_unique<WorkerType>(*this, i));
+    }
+
+    // workers look at each other (victims) => start only after all of them are constructed
+    for (auto& worker : workers_) {
+        worker->start();
+    }
+
+    if constexpr (kEnableIntrospection) {
+        const uint32_t flags = (kEnableStats ? introspect::kHasStats : 0) |
+                               (kEnableCycleAccounting ? introspect::kHasCycles : 0);
+        const uint32_t period_ms = config::Options<Config>::kIntrospectionPeriodMs;
+        auto segment = introspect::Segment::create(introspect::Segment::default_name(),
+                                                   static_cast<uint32_t>(num_workers_), period_ms, flags);
+        publisher_ = std::make_unique<introspect::Publisher>(
+            std::move(segment), std::chrono::milliseconds(period_ms),
+            [this](introspect::Segment& target) { publish(target); });
+    }
+
+    if constexpr (kEnableWatchdog) {
+        const uint32_t threshold_ms = config::Options<Config>::kWatchdogThresholdMs;
+        const auto period = std::chrono::milliseconds(std::max<uint32_t>(threshold_ms / 4, 1));
+        watchdog_ = std::make_unique<watchdog::Watchdog>(
+            period, [](const watchdog::StallReport& report) { watchdog::print(std::cerr, report); },
+            [this, reported = std::vector<uint64_t>(num_workers_)](watchdog::Watchdog& dog) mutable {
+                check_stalls(dog, reported);
+            });
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+WsExecutor<TaskType, Config>::~WsExecutor() {
+    if constexpr (kEnableWatchdog) {
+        watchdog_.reset();
+    }
+    if constexpr (kEnableIntrospection) {
+        publisher_.reset();
+    }
+
+    coordinator_.shutdown();
+    for (auto& worker : workers_) {
+        worker->stop();
+    }
+
+    if constexpr (kEnableTracing) {
+        if (!trace_at_shutdown_.path.empty()) {
+            std::ofstream file(trace_at_shutdown_.path, std::ios::binary | std::ios::trunc);
+            dump_trace(file, trace_at_shutdown_.format);
+        }
+    }
+
+    if constexpr (kEnableRecording) {
+        if (!recording_.path.empty()) {
+            std::vector<record::Event> events;
+            recording_.recorder.append_to(events);
+            for (const auto& worker : workers_) {
+                worker->recorder_.append_to(events);
+            }
+            std::ofstream file(recording_.path, std::ios::binary | std::ios::trunc);
+            record::write(file, static_cast<uint32_t>(num_workers_), tsc_calibration_.ns_per_cycle(), std::move(events));
+        }
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::submit(TaskType* task, size_t priority) noexcept {
+    assert(priority < kPriorityLevels);
+    auto* worker = WorkerType::current();
+
+    // fast path: spawn from a task of this executor
+    if (worker != nullptr && &worker->host() == this) {
+        worker->push_task(task, priority);
+        return;
+    }
+
+    on_injected(1);
+    on_submitted(task);
+    global_queues_[priority].push(task);
+    coordinator_.notify_worker();
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::defer(TaskType* task, size_t priority) noexcept {
+    assert(priority < kPriorityLevels);
+    on_injected(1);
+    on_submitted(task);
+    global_queues_[priority].push(task);
+    coordinator_.notify_worker();
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+bool WsExecutor<TaskType, Config>::try_submit(TaskType* task, size_t priority) noexcept
+    requires(kInjectionCapacity > 0)
+{
+    assert(priority < kPriorityLevels);
+    auto* worker = WorkerType::current();
+
+    if (worker != nullptr && &worker->host() == this) {
+        if (!admission_.has_room()) {
+            return false;
+        }
+        worker->push_task(task, priority);
+        return true;
+    }
+
+    if (!admission_.try_acquire()) {
+        return false;
+    }
+    on_submitted(task);
+    global_queues_[priority].push(task);
+    coordinator_.notify_worker();
+    return true;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::submit_bounded(TaskType* task, size_t priority) noexcept
+    requires(kInjectionCapacity > 0)
+{
+    assert(priority < kPriorityLevels);
+    auto* worker = WorkerType::current();
+
+    if (worker != nullptr && &worker->host() == this) {
+        // blocking a worker could stall the pool => drain the queues while they are full. A helped task
+        // may wait for room in turn: past `Worker::kMaxHelpDepth` such waits let the task in over the
+        // capacity (the queues may hold nothing but the producers whose frames are below)
+        while (!admission_.has_room() && worker->may_help()) {
+            if (!worker->help()) {
+                std::this_thread::yield();
+            }
+        }
+        worker->push_task(task, priority);
+        return;
+    }
+
+    while (!admission_.try_acquire()) {
+        admission_.wait_for_room();
+    }
+    on_submitted(task);
+    global_queues_[priority].push(task);
+    coordinator_.notify_worker();
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+template <typename F>
+    requires std::invocable<std::decay_t<F>&> && (!std::is_convertible_v<F, TaskType*>) &&
+             task::TrampolineTask<TaskType>
+void WsExecutor<TaskType, Config>::submit_bounded(F&& fun, size_t priority) {
+    ///
+    submit_bounded(task::make_closure<TaskType>(std::forward<F>(fun), closure_pool()), priority);
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+bool WsExecutor<TaskType, Config>::overloaded() const noexcept
+    requires(kInjectionCapacity > 0)
+{
+    ///
+    return admission_.overloaded();
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+size_t WsExecutor<TaskType, Config>::injected() const noexcept
+    requires(kInjectionCapacity > 0)
+{
+    ///
+    return admission_.size();
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+template <typename F>
+    requires std::invocable<std::decay_t<F>&> && (!std::is_convertible_v<F, TaskType*>) &&
+             task::TrampolineTask<TaskType>
+void WsExecutor<TaskType, Config>::submit(F&& fun, size_t priority) {
+    ///
+    submit(task::make_closure<TaskType>(std::forward<F>(fun), closure_pool()), priority);
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+memory::BlockPool* WsExecutor<TaskType, Config>::closure_pool() const noexcept {
+    auto* worker = WorkerType::current();
+    return worker != nullptr && &worker->host() == this ? memory::BlockPool::current() : nullptr;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::submit_to(size_t worker_index, TaskType* task) noexcept {
+    assert(worker_index < num_workers_);
+    on_submitted(task);
+    workers_[worker_index]->push_inbox(task);
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::submit_batch(Batch&& batch, size_t batch_size, size_t priority) noexcept {
+    assert(priority < kPriorityLevels);
+    on_injected(batch_size);
+    if constexpr (kEnableLatency || kEnableRecording) {
+        global_queues_[priority].push_batch(stamp_batch(std::move(batch)), batch_size);
+    } else {
+        global_queues_[priority].push_batch(std::move(batch), batch_size);
+    }
+
+    const size_t to_wake = batch_size < num_workers_ ? batch_size : num_workers_;
+    for (size_t i = 0; i < to_wake; ++i) {
+        coordinator_.notify_worker();
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto WsExecutor<TaskType, Config>::add_group(size_t weight) -> GroupId
+    requires(kMaxTaskGroups > 0)
+{
+    assert(weight > 0);
+    std::lock_guard lock(groups_mutex_);
+
+    const size_t id = groups_count_.load(std::memory_order::relaxed);
+    assert(id < kMaxTaskGroups && "too many task groups, see `kMaxTaskGroups`");
+
+    groups_[id].set_weight(weight);
+    groups_count_.store(id + 1, std::memory_order::release);  // workers see the weight with the group
+    return id;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::submit_to_group(GroupId group, TaskType* task) noexcept
+    requires(kMaxTaskGroups > 0)
+{
+    assert(group < groups_count_.load(std::memory_order::relaxed));
+    on_injected(1);
+    on_submitted(task);
+    groups_[group].push(task);
+    coordinator_.notify_worker();
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+template <typename F>
+    requires std::invocable<std::decay_t<F>&> && (!std::is_convertible_v<F, TaskType*>) &&
+             task::TrampolineTask<TaskType>
+void WsExecutor<TaskType, Config>::submit_to_group(GroupId group, F&& fun) {
+    ///
+    submit_to_group(group, task::make_closure<TaskType>(std::forward<F>(fun), closure_pool()));
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto WsExecutor<TaskType, Config>::group_stats(GroupId group) const noexcept -> GroupStats
+    requires(kMaxTaskGroups > 0)
+{
+    const auto& queue = groups_[group];
+    return GroupStats{queue.weight(), queue.submitted(), queue.executed()};
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+template <typename Rep, typename Period>
+void WsExecutor<TaskType, Config>::submit_after(std::chrono::duration<Rep, Period> delay, TimerTaskT* task) noexcept {
+    ///
+    submit_at(Clock::now() + std::chrono::duration_cast<Clock::duration>(delay), task);
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::submit_at(Clock::time_point deadline, TimerTaskT* task) noexcept {
+    auto tick = timers_.schedule(task, deadline);
+    if (!tick) {
+        submit(task);  // already due
+        return;
+    }
+
+    // Dekker-style handshake with the timekeeper (see `Worker::pick_task`): either it sees the new
+    // deadline in its wake condition, or we see its alarm here
+    const uint64_t alarm = timekeeper_deadline_.load();
+    if (alarm == timer::TimerWheel::kNever) {
+        coordinator_.notify_worker();  // nobody keeps time: an idle worker has to take over
+    } else if (*tick < alarm) {
+        // the timekeeper sleeps too long. A stale index means that the new one has not parked yet:
+        // it will see the new deadline by itself
+        coordinator_.wake_worker(timekeeper_.load());
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+template <typename Rep, typename Period, typename F>
+    requires std::invocable<std::decay_t<F>&> &&
+             (!std::is_convertible_v<F, typename WsExecutor<TaskType, Config>::TimerTaskT*>) &&
+             task::TrampolineTask<TaskType>
+void WsExecutor<TaskType, Config>::submit_after(std::chrono::duration<Rep, Period> delay, F&& fun) {
+    ///
+    submit_after(delay, detail::make_timer_closure<TaskType>(std::forward<F>(fun), closure_pool()));
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+template <typename F>
+    requires std::invocable<std::decay_t<F>&> &&
+             (!std::is_convertible_v<F, typename WsExecutor<TaskType, Config>::TimerTaskT*>) &&
+             task::TrampolineTask<TaskType>
+void WsExecutor<TaskType, Config>::submit_at(Clock::time_point deadline, F&& fun) {
+    ///
+    submit_at(deadline, detail::make_timer_closure<TaskType>(std::forward<F>(fun), closure_pool()));
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+bool WsExecutor<TaskType, Config>::cancel(TimerTaskT* task) noexcept {
+    ///
+    return timers_.cancel(task);
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto WsExecutor<TaskType, Config>::reactor() noexcept -> Reactor&
+    requires kEnableReactor
+{
+    ///
+    return *reactor_;
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+size_t WsExecutor<TaskType, Config>::poll_timers() noexcept {
+    if (!timers_.due()) {
+        return 0;
+    }
+
+    Batch batch;
+    const size_t count = timers_.poll(batch);
+    if (count > 0) {
+        submit_batch(std::move(batch), count);
+    }
+    return count;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto WsExecutor<TaskType, Config>::stats() const -> Stats
+    requires(kEnableStats || kEnableCycleAccounting)
+{
+    Stats snapshot;
+    snapshot.workers.reserve(workers_.size());
+    for (const auto& worker : workers_) {
+        snapshot.workers.push_back(worker->stats_.snapshot());
+        snapshot.workers.back().utilization = worker->cycles_.snapshot();
+        snapshot.total += snapshot.workers.back();
+    }
+    snapshot.ns_per_cycle = tsc_calibration_.ns_per_cycle();
+    return snapshot;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto WsExecutor<TaskType, Config>::latency() const -> Latency
+    requires kEnableLatency
+{
+    Latency snapshot;
+    snapshot.workers.reserve(workers_.size());
+    for (const auto& worker : workers_) {
+        snapshot.workers.push_back(worker->latency_.snapshot());
+        snapshot.total += snapshot.workers.back();
+    }
+    snapshot.ns_per_cycle = tsc_calibration_.ns_per_cycle();
+    return snapshot;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto WsExecutor<TaskType, Config>::trace() const -> std::vector<trace::WorkerTrace>
+    requires kEnableTracing
+{
+    std::vector<trace::WorkerTrace> traces;
+    traces.reserve(workers_.size());
+    for (const auto& worker : workers_) {
+        traces.push_back(trace::WorkerTrace{worker->index(), worker->trace_.read()});
+    }
+    return traces;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::dump_trace(std::ostream& out, trace::Format format) const
+    requires kEnableTracing
+{
+    const trace::Timebase timebase{tsc_calibration_.origin(), tsc_calibration_.ns_per_cycle()};
+    trace::write(out, format, trace(), timebase);
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::dump_trace_at_shutdown(std::string path, trace::Format format)
+    requires kEnableTracing
+{
+    trace_at_shutdown_ = TraceDestination{std::move(path), format};
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+const std::string& WsExecutor<TaskType, Config>::introspection_name() const noexcept
+    requires kEnableIntrospection
+{
+    ///
+    return publisher_->segment().name();
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::publish(introspect::Segment& segment) const
+    requires kEnableIntrospection
+{
+    introspect::PoolSample pool;
+    pool.timestamp_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+    for (const auto& queue : global_queues_) {
+        pool.global_depth += queue.size();
+    }
+    if constexpr (kMaxTaskGroups > 0) {
+        for (size_t group = 0; group < groups_count_.load(std::memory_order::acquire); ++group) {
+            pool.global_depth += groups_[group].size();
+        }
+    }
+    if constexpr (kInjectionCapacity > 0) {
+        pool.injected = admission_.size();
+    }
+    pool.ns_per_cycle = tsc_calibration_.ns_per_cycle();
+    segment.pool().store(pool);
+
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        const WorkerType& worker = *workers_[i];
+
+        introspect::WorkerSample sample;
+        for (const auto& queue : worker.local_queues_) {
+            sample.local_depth += queue.size();
+        }
+        sample.local_depth += worker.lifo_slot_.load(std::memory_order::relaxed) != nullptr ? 1 : 0;
+        sample.parked = worker.parked_.load(std::memory_order::relaxed);
+        sample.searching = worker.searching_.load(std::memory_order::relaxed);
+
+        const stats::WorkerStats counters = worker.stats_.snapshot();
+        sample.tasks_run = counters.tasks_run;
+        sample.global_pops = counters.global_pops;
+        sample.steal_attempts = counters.steal_attempts;
+        sample.steal_success = counters.steal_success;
+        sample.tasks_stolen = counters.tasks_stolen;
+        sample.parks = counters.parks;
+        sample.offloads = counters.offloads;
+
+        const stats::Utilization utilization = worker.cycles_.snapshot();
+        sample.cycles = utilization.cycles;
+        for (size_t victim = 0; victim < utilization.steal_cycles.size() && victim < introspect::kMaxPeers;
+             ++victim) {
+            sample.steal_cycles[victim] = utilization.steal_cycles[victim];
+        }
+
+        segment.worker(i).store(sample);
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::on_injected(size_t count) noexcept {
+    if constexpr (kInjectionCapacity > 0) {
+        admission_.acquire(count);
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::on_taken() noexcept {
+    if constexpr (kInjectionCapacity > 0) {
+        admission_.release();
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::on_submitted(TaskType* task) noexcept {
+    WorkerType::stamp(task);
+
+    if constexpr (kEnableRecording) {
+        auto* worker = WorkerType::current();
+        if (worker != nullptr && &worker->host() == this) {
+            worker->recorder_.submitted(task, static_cast<uint16_t>(worker->index()));
+        } else {
+            std::lock_guard lock(recording_.mutex);
+            recording_.recorder.submitted(task, record::kExternal);
+        }
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto WsExecutor<TaskType, Config>::stamp_batch(Batch&& batch) noexcept -> Batch {
+    Batch stamped;
+    while (!batch.empty()) {
+        std::optional<TaskType*> task = batch.try_pop_front();
+        on_submitted(*task);
+        stamped.push_back(**task);
+    }
+    return stamped;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto WsExecutor<TaskType, Config>::get_scheduler() noexcept -> Scheduler {
+    ///
+    return Scheduler(this);
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+size_t WsExecutor<TaskType, Config>::workers_count() const noexcept {
+    ///
+    return num_workers_;
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::on_stall(watchdog::StallHandler handler)
+    requires kEnableWatchdog
+{
+    ///
+    watchdog_->set_handler(std::move(handler));
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::record_to(std::string path)
+    requires kEnableRecording
+{
+    ///
+    recording_.path = std::move(path);
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void WsExecutor<TaskType, Config>::check_stalls(watchdog::Watchdog& dog, std::vector<uint64_t>& reported)
+    requires kEnableWatchdog
+{
+    const auto threshold = std::chrono::milliseconds(config::Options<Config>::kWatchdogThresholdMs);
+    const double ns_per_cycle = tsc_calibration_.ns_per_cycle();
+    const uint64_t now = utils::tsc::now();
+
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        WorkerType& worker = *workers_[i];
+
+        // between tasks: the stamp of the last one is only cleared when the worker parks
+        if (worker.parked_.load(std::memory_order::relaxed) || worker.searching_.load(std::memory_order::relaxed)) {
+            continue;
+        }
+
+        const watchdog::Running running = worker.watch_.running();
+        if (running.started_at == 0 || running.started_at == reported[i] || running.started_at > now) {
+            continue;
+        }
+        const auto duration = std::chrono::nanoseconds(
+            static_cast<int64_t>(static_cast<double>(now - running.started_at) * ns_per_cycle));
+        if (duration < threshold) {
+            continue;
+        }
+        reported[i] = running.started_at;
+
+        watchdog::StallReport report;
+        report.worker = i;
+        report.task = running.task;
+        report.type = watchdog::function_name(running.entry);
+        if (report.type.empty()) {
+            report.type = watchdog::demangle(typeid(TaskType));
+        }
+        report.duration = duration;
+
+        if constexpr (config::Options<Config>::kWatchdogBacktrace) {
+            auto frames = watchdog::capture_backtrace(worker.thread_.native_handle(),
+                                                      config::Options<Config>::kWatchdogSignal,
+                                                      std::chrono::milliseconds(100));
+            // the stack belongs to the stalled task only if the worker has not moved on meanwhile
+            if (worker.watch_.running().started_at == running.started_at) {
+                report.backtrace = watchdog::symbolize(frames);
+            }
+        }
+
+        dog.report(report);
+    }
+}
 
 }  // namespace wr
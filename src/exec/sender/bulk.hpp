@@ -0,0 +1,197 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <utility>
+
+#include <ntrusive/intrusive.hpp>
+
+#include "scheduler.hpp"
+
+namespace wr::exec {
+
+/* Native `bulk(schedule(sched), shape, fun)`:
+ * instead of `shape` separate submits, iterations are split into (at most) one contiguous chunk per
+ * worker, and all chunks are docked to the executor with a single `submit_batch`.
+ * The last finished chunk completes the receiver. */
+template <typename Executor, typename Shape, typename Fun, typename Receiver>
+    requires TrampolineTask<typename Executor::TaskT>
+class BulkOperation {
+  public:  // nested types:
+    using TaskT = typename Executor::TaskT;
+
+    struct Chunk : TaskT {
+        BulkOperation* operation_ = nullptr;
+        Shape begin_{};
+        Shape end_{};
+
+        Chunk() : TaskT(&BulkOperation::run_chunk) {}
+    };
+
+  private:  // data members:
+    Executor* host_;
+    Shape shape_;
+    Fun fun_;
+    Receiver receiver_;
+
+    // the only allocation of the operation: one per `connect`, not per iteration
+    size_t chunks_count_;
+    std::unique_ptr<Chunk[]> chunks_;
+
+    std::atomic<size_t> pending_ = 0;
+
+    std::atomic<bool> failed_ = false;
+    std::exception_ptr error_;
+
+  public:  // member functions:
+    BulkOperation(Executor* host, Shape shape, Fun fun, Receiver receiver);
+
+    BulkOperation(const BulkOperation&) = delete;
+    BulkOperation& operator=(const BulkOperation&) = delete;
+    BulkOperation(BulkOperation&&) = delete;
+    BulkOperation& operator=(BulkOperation&&) = delete;
+
+    void start() & noexcept;
+
+  private:  // member functions:
+    static void run_chunk(TaskT* self) noexcept;
+
+    void complete() noexcept;
+};
+
+/* ---------------------------------- */
+
+template <typename Executor, typename Shape, typename Fun>
+class BulkSender {
+  private:  // data members:
+    Executor* host_;
+    Shape shape_;
+    Fun fun_;
+
+  public:  // nested types:
+#ifdef WR_WITH_STDEXEC
+    using sender_concept = stdexec::sender_t;
+    using completion_signatures = stdexec::completion_signatures<stdexec::set_value_t(),
+                                                                 stdexec::set_error_t(std::exception_ptr)>;
+#endif
+
+  public:  // member functions:
+    BulkSender(Executor* host, Shape shape, Fun fun) : host_(host), shape_(shape), fun_(std::move(fun)) {}
+
+    template <typename Receiver>
+    BulkOperation<Executor, Shape, Fun, Receiver> connect(Receiver receiver) &&;
+
+    template <typename Receiver>
+    BulkOperation<Executor, Shape, Fun, Receiver> connect(Receiver receiver) const&;
+};
+
+/* ---------------------------------- */
+
+template <typename Executor, typename Shape, typename Fun>
+BulkSender<Executor, Shape, Fun> bulk(ScheduleSender<Executor> sender, Shape shape, Fun fun) {
+    return BulkSender<Executor, Shape, Fun>(sender.host(), shape, std::move(fun));
+}
+
+#ifdef WR_WITH_STDEXEC
+/* stdexec customization: found by ADL on `ScheduleSender` */
+template <typename Executor, std::integral Shape, typename Fun>
+BulkSender<Executor, Shape, Fun> tag_invoke(stdexec::bulk_t, ScheduleSender<Executor> sender, Shape shape, Fun fun) {
+    return bulk(sender, shape, std::move(fun));
+}
+#endif
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <typename Executor, typename Shape, typename Fun, typename Receiver>
+    requires TrampolineTask<typename Executor::TaskT>
+BulkOperation<Executor, Shape, Fun, Receiver>::BulkOperation(Executor* host, Shape shape, Fun fun, Receiver receiver)
+    : host_(host), shape_(shape), fun_(std::move(fun)), receiver_(std::move(receiver)) {
+    const auto total = static_cast<size_t>(shape_);
+    chunks_count_ = total < host_->workers_count() ? total : host_->workers_count();
+    chunks_ = std::make_unique<Chunk[]>(chunks_count_);
+}
+
+template <typename Executor, typename Shape, typename Fun, typename Receiver>
+    requires TrampolineTask<typename Executor::TaskT>
+void BulkOperation<Executor, Shape, Fun, Receiver>::start() & noexcept {
+    if (chunks_count_ == 0) {
+        detail::set_value(std::move(receiver_));
+        return;
+    }
+
+    const auto total = static_cast<size_t>(shape_);
+    const size_t step = total / chunks_count_;
+    const size_t remainder = total % chunks_count_;
+
+    IntrusiveList<TaskT> batch;
+    size_t begin = 0;
+
+    for (size_t i = 0; i < chunks_count_; ++i) {
+        // first `remainder` chunks take one extra iteration
+        const size_t end = begin + step + (i < remainder ? 1 : 0);
+
+        Chunk& chunk = chunks_[i];
+        chunk.operation_ = this;
+        chunk.begin_ = static_cast<Shape>(begin);
+        chunk.end_ = static_cast<Shape>(end);
+        batch.push_back(chunk);
+
+        begin = end;
+    }
+
+    pending_.store(chunks_count_, std::memory_order::relaxed);
+    host_->submit_batch(std::move(batch), chunks_count_);
+}
+
+template <typename Executor, typename Shape, typename Fun, typename Receiver>
+    requires TrampolineTask<typename Executor::TaskT>
+void BulkOperation<Executor, Shape, Fun, Receiver>::run_chunk(TaskT* self) noexcept {
+    auto* chunk = static_cast<Chunk*>(self);
+    auto* operation = chunk->operation_;
+
+    try {
+        for (Shape i = chunk->begin_; i < chunk->end_; ++i) {
+            operation->fun_(i);
+        }
+    } catch (...) {
+        // only the first error is reported
+        if (!operation->failed_.exchange(true, std::memory_order::relaxed)) {
+            operation->error_ = std::current_exception();
+        }
+    }
+
+    if (operation->pending_.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+        operation->complete();
+    }
+}
+
+template <typename Executor, typename Shape, typename Fun, typename Receiver>
+    requires TrampolineTask<typename Executor::TaskT>
+void BulkOperation<Executor, Shape, Fun, Receiver>::complete() noexcept {
+    if (failed_.load(std::memory_order::relaxed)) {
+        detail::set_error(std::move(receiver_), std::move(error_));
+    } else {
+        detail::set_value(std::move(receiver_));
+    }
+}
+
+template <typename Executor, typename Shape, typename Fun>
+template <typename Receiver>
+BulkOperation<Executor, Shape, Fun, Receiver> BulkSender<Executor, Shape, Fun>::connect(Receiver receiver) && {
+    ///
+    return BulkOperation<Executor, Shape, Fun, Receiver>(host_, shape_, std::move(fun_), std::move(receiver));
+    ///
+}
+
+template <typename Executor, typename Shape, typename Fun>
+template <typename Receiver>
+BulkOperation<Executor, Shape, Fun, Receiver> BulkSender<Executor, Shape, Fun>::connect(Receiver receiver) const& {
+    ///
+    return BulkOperation<Executor, Shape, Fun, Receiver>(host_, shape_, fun_, std::move(receiver));
+    ///
+}
+
+}  // namespace wr::exec
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <exception>
+#include <utility>
+
+#ifdef WR_WITH_STDEXEC
+#    include <stdexec/execution.hpp>
+#endif
+
+#include "../../tasks/concept.hpp"
+
+namespace wr::exec {
+
+/* Operation states of the adapters are tasks themselves (no allocation per `schedule()`),
+ * so the executor's task type must be able to carry a "trampoline" back into the operation. */
+using task::TrampolineTask;
+
+/* ---------------------------------- */
+
+/* Completion channels of a receiver.
+ * >> With stdexec: forwarded to the standard customization point objects.
+ * >> Without it: minimal in-repo protocol, receiver completes through its member functions:
+ *      r.set_value(values...) && noexcept
+ *      r.set_error(std::exception_ptr) && noexcept
+ */
+namespace detail {
+
+template <typename R, typename... Values>
+void set_value(R&& receiver, Values&&... values) noexcept {
+#ifdef WR_WITH_STDEXEC
+    stdexec::set_value(std::forward<R>(receiver), std::forward<Values>(values)...);
+#else
+    std::forward<R>(receiver).set_value(std::forward<Values>(values)...);
+#endif
+}
+
+template <typename R>
+void set_error(R&& receiver, std::exception_ptr error) noexcept {
+#ifdef WR_WITH_STDEXEC
+    stdexec::set_error(std::forward<R>(receiver), std::move(error));
+#else
+    std::forward<R>(receiver).set_error(std::move(error));
+#endif
+}
+
+}  // namespace detail
+
+}  // namespace wr::exec
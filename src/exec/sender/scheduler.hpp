@@ -0,0 +1,166 @@
+#pragma once
+
+#include <utility>
+
+#include "receiver.hpp"
+
+namespace wr::exec {
+
+template <typename Executor>
+class Scheduler;
+
+/* ---------------------------------- */
+
+/* Operation state of `schedule()`: it IS the task which is submitted to the executor.
+ * >> lives inside the caller's (connect-er's) storage => zero allocations
+ * >> non-movable: the executor holds a pointer to it until `run()` */
+template <typename Executor, typename Receiver>
+    requires TrampolineTask<typename Executor::TaskT>
+class ScheduleOperation : public Executor::TaskT {
+  public:  // nested types:
+    using TaskT = typename Executor::TaskT;
+
+  private:  // data members:
+    Executor* host_;
+    Receiver receiver_;
+
+  public:  // member functions:
+    ScheduleOperation(Executor* host, Receiver receiver);
+
+    ScheduleOperation(const ScheduleOperation&) = delete;
+    ScheduleOperation& operator=(const ScheduleOperation&) = delete;
+    ScheduleOperation(ScheduleOperation&&) = delete;
+    ScheduleOperation& operator=(ScheduleOperation&&) = delete;
+
+    void start() & noexcept;
+
+  private:  // member functions:
+    static void trampoline(TaskT* self) noexcept;
+};
+
+/* ---------------------------------- */
+
+template <typename Executor>
+class ScheduleSender {
+  private:  // data members:
+    Executor* host_;
+
+  public:  // nested types:
+#ifdef WR_WITH_STDEXEC
+    using sender_concept = stdexec::sender_t;
+    using completion_signatures = stdexec::completion_signatures<stdexec::set_value_t()>;
+
+    struct Env {
+        Executor* host_;
+
+        template <typename CPO>
+        Scheduler<Executor> query(stdexec::get_completion_scheduler_t<CPO>) const noexcept {
+            return Scheduler<Executor>(host_);
+        }
+    };
+#endif
+
+  public:  // member functions:
+    explicit ScheduleSender(Executor* host) noexcept : host_(host) {}
+
+    template <typename Receiver>
+    ScheduleOperation<Executor, Receiver> connect(Receiver receiver) const;
+
+    Executor* host() const noexcept;
+
+#ifdef WR_WITH_STDEXEC
+    Env get_env() const noexcept {
+        return Env{host_};
+    }
+#endif
+};
+
+/* ---------------------------------- */
+
+/* Lightweight handle to the executor (a pointer) => copyable, comparable */
+template <typename Executor>
+class Scheduler {
+  private:  // data members:
+    Executor* host_;
+
+  public:  // nested types:
+#ifdef WR_WITH_STDEXEC
+    using scheduler_concept = stdexec::scheduler_t;
+#endif
+
+  public:  // member functions:
+    explicit Scheduler(Executor* host) noexcept : host_(host) {}
+
+    ScheduleSender<Executor> schedule() const noexcept;
+
+    Executor* host() const noexcept;
+
+    bool operator==(const Scheduler&) const noexcept = default;
+};
+
+/* ---------------------------------- */
+
+/* Free-function form of the minimal in-repo protocol: */
+
+template <typename Executor>
+ScheduleSender<Executor> schedule(Scheduler<Executor> scheduler) noexcept {
+    return scheduler.schedule();
+}
+
+template <typename Operation>
+void start(Operation& operation) noexcept {
+    operation.start();
+}
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <typename Executor, typename Receiver>
+    requires TrampolineTask<typename Executor::TaskT>
+ScheduleOperation<Executor, Receiver>::ScheduleOperation(Executor* host, Receiver receiver)
+    : TaskT(&ScheduleOperation::trampoline), host_(host), receiver_(std::move(receiver)) {}
+
+template <typename Executor, typename Receiver>
+    requires TrampolineTask<typename Executor::TaskT>
+void ScheduleOperation<Executor, Receiver>::start() & noexcept {
+    ///
+    host_->submit(this);
+    ///
+}
+
+template <typename Executor, typename Receiver>
+    requires TrampolineTask<typename Executor::TaskT>
+void ScheduleOperation<Executor, Receiver>::trampoline(TaskT* self) noexcept {
+    auto* operation = static_cast<ScheduleOperation*>(self);
+    detail::set_value(std::move(operation->receiver_));
+}
+
+template <typename Executor>
+template <typename Receiver>
+ScheduleOperation<Executor, Receiver> ScheduleSender<Executor>::connect(Receiver receiver) const {
+    ///
+    return ScheduleOperation<Executor, Receiver>(host_, std::move(receiver));
+    ///
+}
+
+template <typename Executor>
+Executor* ScheduleSender<Executor>::host() const noexcept {
+    ///
+    return host_;
+    ///
+}
+
+template <typename Executor>
+ScheduleSender<Executor> Scheduler<Executor>::schedule() const noexcept {
+    ///
+    return ScheduleSender<Executor>(host_);
+    ///
+}
+
+template <typename Executor>
+Executor* Scheduler<Executor>::host() const noexcept {
+    ///
+    return host_;
+    ///
+}
+
+}  // namespace wr::exec
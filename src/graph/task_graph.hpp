@@ -0,0 +1,429 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <ntrusive/intrusive.hpp>
+
+#include "../tasks/concept.hpp"
+
+namespace wr {
+
+/**
+ * @brief Static DAG of tasks: built once, run many times on an executor.
+ *
+ * @section LAYOUT
+ *
+ *  `seal()` (called by the first `run()` after a change) compacts the graph into two flat arrays:
+ *
+ *  nodes_:       [ n0 | n1 | n2 | ... ]          <- nodes are the executor's tasks themselves
+ *  successors_:  [ n1 n2 | n3 | n3 | ... ]       <- edge lists, one contiguous range per node
+ *
+ *  => a run allocates nothing: it resets the predecessor counters and submits the sources.
+ *
+ * @section EXECUTION
+ *
+ *  >> a finished node decrements the counters of its successors (no atomic RMW for a successor with a single
+ *     predecessor: it is ready by definition)
+ *  >> the first successor which becomes ready is run directly by the same worker (no queue round-trip),
+ *     the others are submitted: from a worker they land in its lifo slot / local queue, ready to be stolen
+ *  >> only sinks count down the run: a node reaches the shared counter only if it has no successors
+ *
+ *  Node functions are invoked from `run() noexcept`: an exception escaping them terminates the program.
+ */
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+class TaskGraph {
+  public:  // nested types:
+    using TaskT = typename Executor::TaskT;
+    using NodeId = uint32_t;
+
+  private:  // nested types:
+    class Node : public TaskT {
+      public:  // data members:
+        TaskGraph* graph_ = nullptr;
+        std::function<void()> fun_;
+
+        Node** successors_ = nullptr;
+        uint32_t successors_count_ = 0;
+        uint32_t predecessors_count_ = 0;
+
+        std::atomic<uint32_t> pending_ = 0;
+
+      public:  // member functions:
+        Node() noexcept : TaskT(&TaskGraph::trampoline) {}
+    };
+
+    /* Splits the sources between workers: a range of sources, halved recursively (one half is
+     * submitted and may be stolen, the other is kept), leaves run their sources in place */
+    class Launcher : public TaskT {
+      public:  // data members:
+        TaskGraph* graph_ = nullptr;
+        uint32_t begin_ = 0;
+        uint32_t end_ = 0;
+        uint32_t left_ = 0;  // children in `launchers_`, 0 for a leaf (the root is never a child)
+        uint32_t right_ = 0;
+
+      public:  // member functions:
+        Launcher() noexcept : TaskT(&TaskGraph::launch) {}
+    };
+
+    struct Edge {
+        NodeId from_;
+        NodeId to_;
+    };
+
+    /* fewer sources are submitted with a single `submit_batch` */
+    static constexpr size_t kLaunchGrain = 64;
+
+  private:  // data members:
+    Executor* host_;
+
+    /* builder state */
+    std::vector<std::function<void()>> funs_;
+    std::vector<Edge> edges_;
+    bool sealed_ = false;
+
+    /* sealed graph: flat arrays, reused by every run */
+    std::unique_ptr<Node[]> nodes_;
+    std::unique_ptr<Node*[]> successors_;
+    std::vector<NodeId> sources_;
+    std::unique_ptr<Launcher[]> launchers_;  // sized by `launchers_for()`
+    uint32_t launchers_count_ = 0;
+    size_t sinks_count_ = 0;
+
+    /* current run */
+    std::atomic<size_t> pending_sinks_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable finished_;
+    bool running_ = false;
+
+  public:  // member functions:
+    explicit TaskGraph(Executor* host) noexcept : host_(host) {}
+    ~TaskGraph();
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+    TaskGraph(TaskGraph&&) = delete;
+    TaskGraph& operator=(TaskGraph&&) = delete;
+
+    /*  -------------------- Building (not while running) -------------------- */
+
+    template <typename F>
+        requires std::invocable<std::decay_t<F>&>
+    NodeId emplace(F&& fun);
+
+    /*
+     * @brief Add an edge: `to` starts only after `from` has finished. Edges must not form a cycle.
+     */
+    void precede(NodeId from, NodeId to);
+
+    size_t size() const noexcept;
+
+    /*  -------------------- Running -------------------- */
+
+    /*
+     * @brief Start a run (asynchronously). The previous run must be finished.
+     */
+    void run();
+
+    /*
+     * @brief Block the calling thread until the current run is finished. [not from the executor's tasks]
+     */
+    void wait();
+
+    void run_and_wait();
+
+  private:  // member functions:
+    void seal();
+
+    // Kahn's pass over the sealed graph: every node is reached from the sources [debug check of `seal`]
+    bool acyclic() const;
+
+    uint32_t build_launchers(uint32_t begin, uint32_t end);
+
+    static uint32_t launchers_for(uint32_t sources) noexcept;
+
+    void finish_sink() noexcept;
+
+    static void trampoline(TaskT* self) noexcept;
+
+    static void launch(TaskT* self) noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+TaskGraph<Executor>::~TaskGraph() {
+    ///
+    wait();
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+template <typename F>
+    requires std::invocable<std::decay_t<F>&>
+auto TaskGraph<Executor>::emplace(F&& fun) -> NodeId {
+    assert(!running_);
+
+    funs_.emplace_back(std::forward<F>(fun));
+    sealed_ = false;
+    return static_cast<NodeId>(funs_.size() - 1);
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void TaskGraph<Executor>::precede(NodeId from, NodeId to) {
+    assert(!running_);
+    assert(from < funs_.size() && to < funs_.size() && from != to);
+
+    edges_.push_back(Edge{from, to});
+    sealed_ = false;
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+size_t TaskGraph<Executor>::size() const noexcept {
+    ///
+    return funs_.size();
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void TaskGraph<Executor>::run() {
+    if (!sealed_) {
+        seal();
+    }
+    if (funs_.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        assert(!running_ && "previous run is not finished");
+        running_ = true;
+    }
+
+    const size_t count = funs_.size();
+    for (size_t i = 0; i < count; ++i) {
+        nodes_[i].pending_.store(nodes_[i].predecessors_count_, std::memory_order::relaxed);
+    }
+    pending_sinks_.store(sinks_count_, std::memory_order::relaxed);
+
+    // the submit publishes the resets above
+    if (launchers_count_ > 0) {
+        host_->submit(&launchers_[0]);
+        return;
+    }
+
+    IntrusiveList<TaskT> batch;
+    for (NodeId source : sources_) {
+        batch.push_back(nodes_[source]);
+    }
+    host_->submit_batch(std::move(batch), sources_.size());
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void TaskGraph<Executor>::wait() {
+    std::unique_lock lock(mutex_);
+    finished_.wait(lock, [this] { return !running_; });
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void TaskGraph<Executor>::run_and_wait() {
+    run();
+    wait();
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void TaskGraph<Executor>::seal() {
+    const size_t count = funs_.size();
+
+    nodes_ = std::make_unique<Node[]>(count);
+    successors_ = std::make_unique<Node*[]>(edges_.size());
+
+    // counting sort of the edges by `from` => contiguous successor ranges
+    std::vector<uint32_t> offsets(count + 1, 0);
+    for (const Edge& edge : edges_) {
+        ++offsets[edge.from_ + 1];
+        ++nodes_[edge.to_].predecessors_count_;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    sources_.clear();
+    sinks_count_ = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        Node& node = nodes_[i];
+        node.graph_ = this;
+        node.fun_ = funs_[i];
+        node.successors_ = successors_.get() + offsets[i];
+        node.successors_count_ = offsets[i + 1] - offsets[i];
+
+        if (node.predecessors_count_ == 0) {
+            sources_.push_back(static_cast<NodeId>(i));
+        }
+        if (node.successors_count_ == 0) {
+            ++sinks_count_;
+        }
+    }
+
+    for (const Edge& edge : edges_) {
+        successors_[offsets[edge.from_]++] = &nodes_[edge.to_];  // `offsets` are not needed anymore
+    }
+
+    assert(acyclic() && "graph has a cycle");
+
+    launchers_count_ = 0;
+    launchers_.reset();
+    if (sources_.size() > kLaunchGrain) {
+        launchers_ = std::make_unique<Launcher[]>(launchers_for(static_cast<uint32_t>(sources_.size())));
+        build_launchers(0, static_cast<uint32_t>(sources_.size()));
+    }
+
+    sealed_ = true;
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool TaskGraph<Executor>::acyclic() const {
+    const size_t count = funs_.size();
+    std::vector<uint32_t> pending(count);
+    for (size_t i = 0; i < count; ++i) {
+        pending[i] = nodes_[i].predecessors_count_;
+    }
+
+    // a node on a cycle (or behind one) never runs out of predecessors
+    std::vector<const Node*> ready;
+    for (NodeId source : sources_) {
+        ready.push_back(&nodes_[source]);
+    }
+    size_t reached = 0;
+    while (!ready.empty()) {
+        const Node* node = ready.back();
+        ready.pop_back();
+        ++reached;
+        for (uint32_t i = 0; i < node->successors_count_; ++i) {
+            const Node* successor = node->successors_[i];
+            if (--pending[static_cast<size_t>(successor - nodes_.get())] == 0) {
+                ready.push_back(successor);
+            }
+        }
+    }
+    return reached == count;
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+uint32_t TaskGraph<Executor>::build_launchers(uint32_t begin, uint32_t end) {
+    const uint32_t index = launchers_count_++;
+
+    Launcher& launcher = launchers_[index];
+    launcher.graph_ = this;
+    launcher.begin_ = begin;
+    launcher.end_ = end;
+
+    if (end - begin > kLaunchGrain) {
+        const uint32_t middle = begin + (end - begin) / 2;
+        launcher.left_ = build_launchers(begin, middle);
+        launcher.right_ = build_launchers(middle, end);
+    }
+    return index;
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+uint32_t TaskGraph<Executor>::launchers_for(uint32_t sources) noexcept {
+    if (sources <= kLaunchGrain) {
+        return 1;
+    }
+    return 1 + launchers_for(sources / 2) + launchers_for(sources - sources / 2);
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void TaskGraph<Executor>::finish_sink() noexcept {
+    if (pending_sinks_.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+        // notified under the lock: `wait()` cannot return (and the graph die) before we are done here
+        std::lock_guard lock(mutex_);
+        running_ = false;
+        finished_.notify_all();
+    }
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void TaskGraph<Executor>::trampoline(TaskT* self) noexcept {
+    auto* node = static_cast<Node*>(self);
+    TaskGraph* graph = node->graph_;
+    Executor* host = graph->host_;
+
+    while (node != nullptr) {
+        node->fun_();
+
+        Node** it = node->successors_;
+        Node** end = it + node->successors_count_;
+
+        if (it == end) {
+            graph->finish_sink();  // may be the last touch of the graph
+            return;
+        }
+
+        // the graph is alive until the last successor is released: it blocks at least one sink
+        Node* next = nullptr;
+        for (; it != end; ++it) {
+            Node* successor = *it;
+            if (successor->predecessors_count_ == 1 ||
+                successor->pending_.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+                if (next == nullptr) {
+                    next = successor;  // run it right here
+                } else {
+                    host->submit(successor);
+                }
+            }
+        }
+        node = next;
+    }
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void TaskGraph<Executor>::launch(TaskT* self) noexcept {
+    auto* launcher = static_cast<Launcher*>(self);
+    TaskGraph* graph = launcher->graph_;
+
+    // the graph is alive while at least one source has not run yet
+    while (launcher->left_ != 0) {
+        graph->host_->submit(&graph->launchers_[launcher->right_]);
+        launcher = &graph->launchers_[launcher->left_];
+    }
+
+    const NodeId* source = graph->sources_.data() + launcher->begin_;
+    const NodeId* end = graph->sources_.data() + launcher->end_;
+    Node* nodes = graph->nodes_.get();
+
+    for (; source != end; ++source) {
+        nodes[*source].run();
+    }
+}
+
+}  // namespace wr
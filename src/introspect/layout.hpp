@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "../utils/constants.hpp"
+#include "../worker/cycles.hpp"
+
+namespace wr::introspect {
+
+/**
+ * @brief Single-writer seqlock over a trivially copyable record, usable across processes (shared memory).
+ *
+ *  >> the writer makes the sequence odd, stores the words, makes it even again (release)
+ *  >> a reader copies the words between two reads of the sequence and retries if it has changed
+ *     => the writer never waits for the readers, a reader never sees a torn record
+ *
+ *  The words are relaxed atomics: no data race in the C++ sense, the same bytes as a plain copy.
+ */
+template <typename T>
+class alignas(utils::constants::CACHE_LINE_SIZE) Seqlock {
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(uint64_t) == 0);
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "the record is shared between processes");
+
+  private:  // data members:
+    static constexpr size_t kWords = sizeof(T) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> sequence_ = 0;  // odd => a write is in progress
+    std::array<std::atomic<uint64_t>, kWords> words_{};
+
+  public:  // member functions:
+    void store(const T& value) noexcept;        // the writer
+    bool try_load(T& value) const noexcept;     // false if a write got in the way
+    T load() const noexcept;                    // retries until the copy is consistent
+
+    uint64_t version() const noexcept;  // number of the stores so far
+};
+
+/* -------------------- Records of the segment -------------------- */
+
+inline constexpr uint64_t kMagic = 0x706f742d72772eull;  // ".wr-top"
+inline constexpr uint32_t kVersion = 1;
+
+// the steal flow is tracked between the first kMaxPeers workers
+inline constexpr size_t kMaxPeers = 64;
+
+// `Header::flags`
+inline constexpr uint32_t kHasStats = 1;   // `Config::kEnableStats`: the counters are filled
+inline constexpr uint32_t kHasCycles = 2;  // `Config::kEnableCycleAccounting`: the phases are filled
+
+/* Written once by the creator; `magic` is stored last (release) => a reader of a valid magic sees the rest */
+struct Header {
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t workers;
+    uint64_t pid;
+    uint32_t period_ms;
+    uint32_t flags;
+};
+
+struct PoolSample {
+    uint64_t timestamp_ns = 0;  // steady clock of the publisher
+    uint64_t global_depth = 0;  // tasks in the injection queues: every priority level and group
+    uint64_t injected = 0;      // `WsExecutor::injected` of bounded pools, 0 otherwise
+    double ns_per_cycle = 1.0;  // of the cycles of `WorkerSample`
+};
+
+struct WorkerSample {
+    uint64_t local_depth = 0;  // `bottom_ - top_` of the deques + the LIFO slot
+    uint64_t parked = 0;
+    uint64_t searching = 0;
+
+    uint64_t tasks_run = 0;
+    uint64_t global_pops = 0;
+    uint64_t steal_attempts = 0;
+    uint64_t steal_success = 0;
+    uint64_t tasks_stolen = 0;
+    uint64_t parks = 0;
+    uint64_t offloads = 0;
+
+    std::array<uint64_t, static_cast<size_t>(stats::Phase::kCount)> cycles{};
+    std::array<uint64_t, kMaxPeers> steal_cycles{};  // per victim
+};
+
+/* Offsets in the segment: Header | Seqlock<PoolSample> | Seqlock<WorkerSample> x workers */
+struct Layout {
+    static constexpr size_t kPoolOffset = utils::constants::CACHE_LINE_SIZE;
+    static constexpr size_t kWorkersOffset = kPoolOffset + sizeof(Seqlock<PoolSample>);
+
+    static_assert(sizeof(Header) <= kPoolOffset);
+
+    static constexpr size_t size(size_t workers) noexcept {
+        return kWorkersOffset + workers * sizeof(Seqlock<WorkerSample>);
+    }
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <typename T>
+void Seqlock<T>::store(const T& value) noexcept {
+    uint64_t words[kWords];
+    std::memcpy(words, &value, sizeof(T));
+
+    const uint64_t sequence = sequence_.load(std::memory_order::relaxed);
+    sequence_.store(sequence + 1, std::memory_order::relaxed);
+    std::atomic_thread_fence(std::memory_order::release);  // the odd sequence goes before the words
+
+    for (size_t i = 0; i < kWords; ++i) {
+        words_[i].store(words[i], std::memory_order::relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order::release);
+}
+
+template <typename T>
+bool Seqlock<T>::try_load(T& value) const noexcept {
+    const uint64_t before = sequence_.load(std::memory_order::acquire);
+    if (before % 2 != 0) {
+        return false;
+    }
+
+    uint64_t words[kWords];
+    for (size_t i = 0; i < kWords; ++i) {
+        words[i] = words_[i].load(std::memory_order::relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order::acquire);  // the words are read before the sequence again
+    if (sequence_.load(std::memory_order::relaxed) != before) {
+        return false;
+    }
+    std::memcpy(&value, words, sizeof(T));
+    return true;
+}
+
+template <typename T>
+T Seqlock<T>::load() const noexcept {
+    T value;
+    while (!try_load(value)) {
+    }
+    return value;
+}
+
+template <typename T>
+uint64_t Seqlock<T>::version() const noexcept {
+    ///
+    return sequence_.load(std::memory_order::acquire) / 2;
+    ///
+}
+
+}  // namespace wr::introspect
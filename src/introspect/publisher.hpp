@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "../utils/thread_name.hpp"
+#include "segment.hpp"
+
+namespace wr::introspect {
+
+#if defined(__unix__) || defined(__APPLE__)
+
+/**
+ * @brief Sampling thread of an executor (`Config::kEnableIntrospection`): every period it calls
+ * `sample(Segment&)`, which reads the executor with relaxed loads and stores the records.
+ *
+ * The workers are never touched: no hot-path stores, the samples come from the state they keep anyway
+ * (queue indices, parked flags, counters).
+ */
+class Publisher {
+  private:  // data members:
+    Segment segment_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+
+    std::thread thread_;
+
+  public:  // member functions:
+    template <typename Sample>
+    Publisher(Segment segment, std::chrono::milliseconds period, Sample sample);
+    ~Publisher();
+
+    Publisher(const Publisher&) = delete;
+    Publisher& operator=(const Publisher&) = delete;
+    Publisher(Publisher&&) = delete;
+    Publisher& operator=(Publisher&&) = delete;
+
+    const Segment& segment() const noexcept;
+};
+
+#endif
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+template <typename Sample>
+Publisher::Publisher(Segment segment, std::chrono::milliseconds period, Sample sample)
+    : segment_(std::move(segment)) {
+    thread_ = std::thread([this, period, sample = std::move(sample)]() mutable {
+        utils::set_thread_name("wr-introspect");
+        std::unique_lock lock(mutex_);
+        while (!stop_) {
+            lock.unlock();
+            sample(segment_);
+            lock.lock();
+
+            // a sampling period, not a deadline: the system clock will do (plain pthread_cond_timedwait)
+            wake_.wait_until(lock, std::chrono::system_clock::now() + period, [this] { return stop_; });
+        }
+    });
+}
+
+inline Publisher::~Publisher() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+inline const Segment& Publisher::segment() const noexcept {
+    ///
+    return segment_;
+    ///
+}
+
+#endif
+
+}  // namespace wr::introspect
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "layout.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+
+#    include <cerrno>
+#    include <system_error>
+#endif
+
+namespace wr::introspect {
+
+#if defined(__unix__) || defined(__APPLE__)
+
+/**
+ * @brief POSIX shared-memory segment with the records of one executor (see `layout.hpp`).
+ *
+ *  >> `create`: the publisher (the executor), read-write; the name is unlinked by the destructor
+ *  >> `open`: an observer (`wr-top`), read-only; throws if the segment is not an executor's
+ */
+class Segment {
+  private:  // data members:
+    std::string name_;
+    void* base_ = nullptr;
+    size_t size_ = 0;
+    bool owner_ = false;
+
+  public:  // member functions:
+    static Segment create(std::string name, uint32_t workers, uint32_t period_ms, uint32_t flags);
+    static Segment open(std::string name);
+
+    Segment(Segment&& other) noexcept;
+    Segment& operator=(Segment&& other) noexcept;
+    ~Segment();
+
+    Segment(const Segment&) = delete;
+    Segment& operator=(const Segment&) = delete;
+
+    const std::string& name() const noexcept;
+
+    const Header& header() const noexcept;
+    uint32_t workers() const noexcept;
+
+    Seqlock<PoolSample>& pool() noexcept;
+    const Seqlock<PoolSample>& pool() const noexcept;
+
+    Seqlock<WorkerSample>& worker(size_t index) noexcept;
+    const Seqlock<WorkerSample>& worker(size_t index) const noexcept;
+
+    // "/wr-<pid>-<n>": n counts the executors of the process
+    static std::string default_name();
+
+  private:  // member functions:
+    Segment(std::string name, void* base, size_t size, bool owner) noexcept;
+
+    char* bytes() const noexcept;
+};
+
+#endif
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+inline Segment::Segment(std::string name, void* base, size_t size, bool owner) noexcept
+    : name_(std::move(name)), base_(base), size_(size), owner_(owner) {}
+
+inline Segment Segment::create(std::string name, uint32_t workers, uint32_t period_ms, uint32_t flags) {
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "shm_open(" + name + ")");
+    }
+
+    const size_t size = Layout::size(workers);
+    if (::ftruncate(fd, static_cast<off_t>(size)) < 0) {
+        const int error = errno;
+        ::close(fd);
+        ::shm_unlink(name.c_str());
+        throw std::system_error(error, std::generic_category(), "ftruncate");
+    }
+
+    void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        ::shm_unlink(name.c_str());
+        throw std::system_error(error, std::generic_category(), "mmap");
+    }
+
+    // the pages are zeroed: construct the records, then publish the header
+    auto* bytes = static_cast<char*>(base);
+    auto* header = ::new (bytes) Header{};
+    ::new (bytes + Layout::kPoolOffset) Seqlock<PoolSample>();
+    for (size_t i = 0; i < workers; ++i) {
+        ::new (bytes + Layout::kWorkersOffset + i * sizeof(Seqlock<WorkerSample>)) Seqlock<WorkerSample>();
+    }
+    header->version = kVersion;
+    header->workers = workers;
+    header->pid = static_cast<uint64_t>(::getpid());
+    header->period_ms = period_ms;
+    header->flags = flags;
+    header->magic.store(kMagic, std::memory_order::release);
+
+    return Segment(std::move(name), base, size, /*owner=*/true);
+}
+
+inline Segment Segment::open(std::string name) {
+    const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), "shm_open(" + name + ")");
+    }
+
+    struct stat info {};
+    if (::fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < Layout::size(0)) {
+        ::close(fd);
+        throw std::runtime_error(name + ": not an executor segment");
+    }
+
+    const auto size = static_cast<size_t>(info.st_size);
+    void* base = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(), "mmap");
+    }
+
+    Segment segment(std::move(name), base, size, /*owner=*/false);
+    const Header& header = segment.header();
+    if (header.magic.load(std::memory_order::acquire) != kMagic || header.version != kVersion ||
+        Layout::size(header.workers) > size) {
+        throw std::runtime_error(segment.name() + ": not an executor segment (or another version)");
+    }
+    return segment;
+}
+
+inline Segment::Segment(Segment&& other) noexcept
+    : name_(std::move(other.name_)),
+      base_(std::exchange(other.base_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      owner_(std::exchange(other.owner_, false)) {}
+
+inline Segment& Segment::operator=(Segment&& other) noexcept {
+    if (this != &other) {
+        Segment dropped(std::move(*this));
+        name_ = std::move(other.name_);
+        base_ = std::exchange(other.base_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        owner_ = std::exchange(other.owner_, false);
+    }
+    return *this;
+}
+
+inline Segment::~Segment() {
+    if (base_ != nullptr) {
+        ::munmap(base_, size_);
+    }
+    if (owner_) {
+        ::shm_unlink(name_.c_str());
+    }
+}
+
+inline const std::string& Segment::name() const noexcept {
+    ///
+    return name_;
+    ///
+}
+
+inline const Header& Segment::header() const noexcept {
+    ///
+    return *std::launder(reinterpret_cast<const Header*>(bytes()));
+    ///
+}
+
+inline uint32_t Segment::workers() const noexcept {
+    ///
+    return header().workers;
+    ///
+}
+
+inline Seqlock<PoolSample>& Segment::pool() noexcept {
+    ///
+    return *std::launder(reinterpret_cast<Seqlock<PoolSample>*>(bytes() + Layout::kPoolOffset));
+    ///
+}
+
+inline const Seqlock<PoolSample>& Segment::pool() const noexcept {
+    ///
+    return *std::launder(reinterpret_cast<const Seqlock<PoolSample>*>(bytes() + Layout::kPoolOffset));
+    ///
+}
+
+inline Seqlock<WorkerSample>& Segment::worker(size_t index) noexcept {
+    char* record = bytes() + Layout::kWorkersOffset + index * sizeof(Seqlock<WorkerSample>);
+    return *std::launder(reinterpret_cast<Seqlock<WorkerSample>*>(record));
+}
+
+inline const Seqlock<WorkerSample>& Segment::worker(size_t index) const noexcept {
+    const char* record = bytes() + Layout::kWorkersOffset + index * sizeof(Seqlock<WorkerSample>);
+    return *std::launder(reinterpret_cast<const Seqlock<WorkerSample>*>(record));
+}
+
+inline std::string Segment::default_name() {
+    static std::atomic<uint32_t> instances = 0;
+    return "/wr-" + std::to_string(::getpid()) + "-" + std::to_string(instances.fetch_add(1));
+}
+
+inline char* Segment::bytes() const noexcept {
+    ///
+    return static_cast<char*>(base_);
+    ///
+}
+
+#endif
+
+}  // namespace wr::introspect
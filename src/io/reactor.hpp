@@ -0,0 +1,266 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "../tasks/concept.hpp"
+
+#if defined(__linux__)
+#    include <sys/epoll.h>
+#    include <sys/eventfd.h>
+#    include <unistd.h>
+
+#    include <cerrno>
+#    include <system_error>
+#endif
+
+namespace wr {
+
+namespace io {
+
+template <task::Task TaskT>
+class Reactor;
+
+}  // namespace io
+
+/* Task which waits for I/O readiness (`io::Reactor::add`): an executor task with the descriptor and the
+ * events reported by the last poll next to it. While it waits it is in no queue. */
+template <task::Task TaskT>
+class IoTask : public TaskT {
+  private:  // data members:
+    int fd_ = -1;
+    uint32_t ready_events_ = 0;
+
+  public:  // friendship declaration:
+    friend class io::Reactor<TaskT>;
+
+  public:  // member functions:
+    using TaskT::TaskT;
+
+    int fd() const noexcept {
+        return fd_;
+    }
+
+    /* EPOLLIN / EPOLLOUT / EPOLLHUP / EPOLLERR ... which made the task runnable */
+    uint32_t ready_events() const noexcept {
+        return ready_events_;
+    }
+};
+
+namespace io {
+
+#if defined(__linux__)
+
+/**
+ * @brief epoll reactor driven by idle workers (`Config::kEnableReactor`): no I/O thread.
+ *
+ *  >> a worker which is about to park polls epoll instead of sleeping on the condvar (one poller at a time),
+ *     busy workers poll without blocking on the fairness tick
+ *  >> ready tasks are handed to the polling worker in one batch (up to kMaxEvents) and go to its local queue
+ *     => no cross-thread submit per event, the rest of the pool steals them
+ *  >> the blocked poller is woken by an eventfd when new work arrives (see `Coordinator::notify_worker`)
+ *
+ *  Registrations are one-shot: a ready task is queued once, `rearm` it to wait for the next event.
+ */
+template <task::Task TaskT>
+class Reactor {
+  public:  // nested types:
+    using IoTaskT = IoTask<TaskT>;
+
+    static constexpr int kMaxEvents = 64;
+
+  private:  // data members:
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;  // eventfd, registered with `data.ptr == nullptr`
+
+    std::atomic<bool> polling_ = false;  // poller role
+    std::atomic<bool> blocked_ = false;  // the poller sleeps in epoll_wait
+
+  public:  // member functions:
+    Reactor();
+    ~Reactor();
+
+    Reactor(const Reactor&) = delete;
+    Reactor& operator=(const Reactor&) = delete;
+    Reactor(Reactor&&) = delete;
+    Reactor& operator=(Reactor&&) = delete;
+
+    /*
+     * @brief Watch `fd` for `events` (EPOLLIN, EPOLLOUT, ...): `task` is queued once when they occur.
+     * Throws std::system_error if epoll refuses the descriptor.
+     */
+    void add(IoTaskT* task, int fd, uint32_t events);
+
+    /*
+     * @brief Wait for the next `events` on a registered task (usually from the task itself).
+     */
+    void rearm(IoTaskT* task, uint32_t events);
+
+    /*
+     * @brief Stop watching. A task which is already queued still runs.
+     */
+    void remove(IoTaskT* task) noexcept;
+
+    /*  -------------------- Worker side -------------------- */
+
+    bool try_acquire_poller() noexcept;
+    void release_poller() noexcept;
+
+    /*
+     * @brief Poll for ready tasks, `on_ready(TaskT*)` is called for each of them; returns their number.
+     * `timeout_ms` != 0 => the poller may block: it does not if `has_work()` holds after it has published
+     * that it is going to. Poller only.
+     */
+    template <typename Predicate, typename OnReady>
+    size_t wait(int timeout_ms, Predicate&& has_work, OnReady&& on_ready) noexcept;
+
+    /* wakes the poller if it is blocked [any thread] */
+    void wake() noexcept;
+
+    static void wake_thunk(void* self) noexcept;
+};
+
+#else
+
+template <task::Task TaskT>
+class Reactor {
+    static_assert(sizeof(TaskT) == 0, "wr::io::Reactor requires Linux (epoll)");
+};
+
+#endif
+
+}  // namespace io
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+#if defined(__linux__)
+
+template <task::Task TaskT>
+io::Reactor<TaskT>::Reactor() {
+    epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0) {
+        throw std::system_error(errno, std::generic_category(), "epoll_create1");
+    }
+
+    wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        const int error = errno;
+        ::close(epoll_fd_);
+        throw std::system_error(error, std::generic_category(), "eventfd");
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event) < 0) {
+        const int error = errno;
+        ::close(wake_fd_);
+        ::close(epoll_fd_);
+        throw std::system_error(error, std::generic_category(), "epoll_ctl");
+    }
+}
+
+template <task::Task TaskT>
+io::Reactor<TaskT>::~Reactor() {
+    ::close(wake_fd_);
+    ::close(epoll_fd_);
+}
+
+template <task::Task TaskT>
+void io::Reactor<TaskT>::add(IoTaskT* task, int fd, uint32_t events) {
+    task->fd_ = fd;
+
+    epoll_event event{};
+    event.events = events | EPOLLONESHOT;
+    event.data.ptr = task;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+        throw std::system_error(errno, std::generic_category(), "epoll_ctl(ADD)");
+    }
+}
+
+template <task::Task TaskT>
+void io::Reactor<TaskT>::rearm(IoTaskT* task, uint32_t events) {
+    epoll_event event{};
+    event.events = events | EPOLLONESHOT;
+    event.data.ptr = task;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, task->fd_, &event) < 0) {
+        throw std::system_error(errno, std::generic_category(), "epoll_ctl(MOD)");
+    }
+}
+
+template <task::Task TaskT>
+void io::Reactor<TaskT>::remove(IoTaskT* task) noexcept {
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, task->fd_, nullptr);
+    task->fd_ = -1;
+}
+
+template <task::Task TaskT>
+bool io::Reactor<TaskT>::try_acquire_poller() noexcept {
+    ///
+    return !polling_.load(std::memory_order::relaxed) && !polling_.exchange(true, std::memory_order::acquire);
+    ///
+}
+
+template <task::Task TaskT>
+void io::Reactor<TaskT>::release_poller() noexcept {
+    ///
+    polling_.store(false, std::memory_order::release);
+    ///
+}
+
+template <task::Task TaskT>
+template <typename Predicate, typename OnReady>
+size_t io::Reactor<TaskT>::wait(int timeout_ms, Predicate&& has_work, OnReady&& on_ready) noexcept {
+    if (timeout_ms != 0) {
+        // Dekker-style handshake with `wake()`: either it sees us blocked, or we see its work here
+        blocked_.store(true);
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (has_work()) {
+            timeout_ms = 0;
+        }
+    }
+
+    epoll_event events[kMaxEvents];
+    int count = ::epoll_wait(epoll_fd_, events, kMaxEvents, timeout_ms);
+    blocked_.store(false, std::memory_order::relaxed);
+
+    if (count < 0) {
+        return 0;  // EINTR
+    }
+
+    size_t ready = 0;
+    for (int i = 0; i < count; ++i) {
+        if (events[i].data.ptr == nullptr) {
+            uint64_t drained = 0;
+            [[maybe_unused]] auto bytes = ::read(wake_fd_, &drained, sizeof(drained));
+            continue;
+        }
+
+        auto* task = static_cast<IoTaskT*>(events[i].data.ptr);
+        task->ready_events_ = events[i].events;
+        on_ready(static_cast<TaskT*>(task));
+        ++ready;
+    }
+    return ready;
+}
+
+template <task::Task TaskT>
+void io::Reactor<TaskT>::wake() noexcept {
+    std::atomic_thread_fence(std::memory_order::seq_cst);  // the work is published before `blocked_` is read
+    if (blocked_.load(std::memory_order::relaxed) && blocked_.exchange(false)) {
+        const uint64_t one = 1;
+        [[maybe_unused]] auto bytes = ::write(wake_fd_, &one, sizeof(one));
+    }
+}
+
+template <task::Task TaskT>
+void io::Reactor<TaskT>::wake_thunk(void* self) noexcept {
+    ///
+    static_cast<Reactor*>(self)->wake();
+    ///
+}
+
+#endif
+
+}  // namespace wr
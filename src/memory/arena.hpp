@@ -0,0 +1,331 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#    include <sys/mman.h>
+#endif
+
+#include "../utils/constants.hpp"
+
+namespace wr::memory {
+
+/**
+ * @brief Bump allocator for short-lived scratch memory (one per worker).
+ *
+ * @section DESIGN
+ *
+ *  >> allocate() is a pointer bump inside the current chunk; deallocate does not exist
+ *  >> memory is reclaimed at once: rewind() to a mark (ArenaScope) or reset() to the very beginning
+ *  >> chunks are never returned until the arena dies => after warm-up there are no system calls at all
+ *
+ *  chunk chain:  [head] -> [ ] -> [ ] -> nullptr
+ *                           ^ current_, cursor_ somewhere inside it
+ *
+ *  >> chunks are page-aligned (mmap), the arena itself is cache-aligned => no false sharing between workers
+ *  >> optionally chunks are backed by huge pages (MAP_HUGETLB, fallback to madvise(MADV_HUGEPAGE))
+ *  >> the first chunk is mapped lazily: workers which never touch their arena pay nothing
+ *
+ *  Owner-only: no synchronization inside.
+ */
+class alignas(utils::constants::CACHE_LINE_SIZE) Arena {
+  private:  // nested types:
+    struct Chunk {
+        Chunk* next_;
+        size_t size_; /* including the header */
+    };
+
+    static constexpr size_t kChunkHeaderSize = alignof(std::max_align_t);
+
+  public:  // nested types:
+    /* Position in the arena to rewind to */
+    struct Mark {
+        Chunk* chunk_ = nullptr;
+        std::byte* cursor_ = nullptr;
+    };
+
+    static constexpr size_t kHugePageSize = size_t{2} * 1024 * 1024;
+
+  private:  // data members:
+    const size_t chunk_size_;
+    const bool huge_pages_;
+
+    Chunk* head_ = nullptr;
+    Chunk* current_ = nullptr;
+    std::byte* cursor_ = nullptr;
+    std::byte* limit_ = nullptr;
+
+    static inline thread_local Arena* current_arena_ = nullptr;
+
+  public:  // member functions:
+    explicit Arena(size_t chunk_size = size_t{64} * 1024, bool huge_pages = false) noexcept;
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena(Arena&&) = delete;
+    Arena& operator=(Arena&&) = delete;
+
+    /*
+     * @brief Bump-allocate `size` bytes aligned by `align` (power of two). Throws std::bad_alloc.
+     */
+    [[nodiscard]] void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+    template <typename T>
+    [[nodiscard]] T* allocate_array(size_t count);
+
+    [[nodiscard]] Mark mark() const noexcept;
+
+    /*
+     * @brief Release everything allocated after `mark`.
+     */
+    void rewind(Mark mark) noexcept;
+
+    /*
+     * @brief Release everything (chunks are kept for reuse).
+     */
+    void reset() noexcept;
+
+    /*
+     * @brief Total size of mapped chunks.
+     */
+    size_t capacity() const noexcept;
+
+    /*
+     * @brief Arena of the worker running on the current thread (nullptr for other threads).
+     */
+    static Arena* current() noexcept;
+
+    static void set_current(Arena* arena) noexcept;
+
+  private:  // member functions:
+    void* allocate_slow(size_t size, size_t align);
+
+    Chunk* map_chunk(size_t size);
+
+    static void unmap_chunk(Chunk* chunk) noexcept;
+
+    void enter(Chunk* chunk, std::byte* cursor) noexcept;
+
+    static std::byte* data_of(Chunk* chunk) noexcept;
+
+    static std::byte* align_up(std::byte* ptr, size_t align) noexcept;
+};
+
+/* ---------------------------------- */
+
+/* RAII: everything allocated from the arena during the scope is released at its end */
+class ArenaScope {
+  private:  // data members:
+    Arena& arena_;
+    Arena::Mark mark_;
+
+  public:  // member functions:
+    explicit ArenaScope(Arena& arena) noexcept : arena_(arena), mark_(arena.mark()) {}
+
+    ~ArenaScope() {
+        arena_.rewind(mark_);
+    }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+};
+
+/* ---------------------------------- */
+
+/* STL-compatible adapter: std::vector<int, ArenaAllocator<int>> v(ArenaAllocator<int>(arena)); */
+template <typename T>
+class ArenaAllocator {
+  public:  // nested types:
+    using value_type = T;
+
+  private:  // data members:
+    Arena* arena_;
+
+    template <typename U>
+    friend class ArenaAllocator;
+
+  public:  // member functions:
+    explicit ArenaAllocator(Arena& arena) noexcept : arena_(&arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) {}
+
+    [[nodiscard]] T* allocate(size_t count) {
+        return arena_->allocate_array<T>(count);
+    }
+
+    void deallocate(T*, size_t) noexcept { /* memory is released by rewind()/reset() */ }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return arena_ == other.arena_;
+    }
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline Arena::Arena(size_t chunk_size, bool huge_pages) noexcept
+    : chunk_size_(huge_pages ? (chunk_size + kHugePageSize - 1) / kHugePageSize * kHugePageSize : chunk_size),
+      huge_pages_(huge_pages) {}
+
+inline Arena::~Arena() {
+    while (head_ != nullptr) {
+        unmap_chunk(std::exchange(head_, head_->next_));
+    }
+}
+
+inline void* Arena::allocate(size_t size, size_t align) {
+    std::byte* ptr = align_up(cursor_, align);
+
+    // fast path: [cursor_ == limit_ == nullptr] before the first chunk is mapped
+    if (ptr != nullptr && ptr + size <= limit_) {
+        cursor_ = ptr + size;
+        return ptr;
+    }
+
+    return allocate_slow(size, align);
+}
+
+template <typename T>
+T* Arena::allocate_array(size_t count) {
+    if (count > SIZE_MAX / sizeof(T)) {
+        throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+}
+
+inline auto Arena::mark() const noexcept -> Mark {
+    ///
+    return Mark{current_, cursor_};
+    ///
+}
+
+inline void Arena::rewind(Mark mark) noexcept {
+    if (mark.chunk_ == nullptr) {
+        reset();
+        return;
+    }
+    enter(mark.chunk_, mark.cursor_);
+}
+
+inline void Arena::reset() noexcept {
+    if (head_ != nullptr) {
+        enter(head_, data_of(head_));
+    }
+}
+
+inline size_t Arena::capacity() const noexcept {
+    size_t total = 0;
+    for (Chunk* chunk = head_; chunk != nullptr; chunk = chunk->next_) {
+        total += chunk->size_;
+    }
+    return total;
+}
+
+inline Arena* Arena::current() noexcept {
+    ///
+    return current_arena_;
+    ///
+}
+
+inline void Arena::set_current(Arena* arena) noexcept {
+    ///
+    current_arena_ = arena;
+    ///
+}
+
+inline void* Arena::allocate_slow(size_t size, size_t align) {
+    const size_t required = kChunkHeaderSize + size + align;
+
+    // chunks after the current one are free (left after rewind/reset): reuse the next one if it fits
+    Chunk* next = current_ != nullptr ? current_->next_ : head_;
+    if (next == nullptr || next->size_ < required) {
+        Chunk* fresh = map_chunk(required > chunk_size_ ? required : chunk_size_);
+        fresh->next_ = next;
+        if (current_ != nullptr) {
+            current_->next_ = fresh;
+        } else {
+            head_ = fresh;
+        }
+        next = fresh;
+    }
+
+    enter(next, data_of(next));
+
+    std::byte* ptr = align_up(cursor_, align);
+    cursor_ = ptr + size;
+    return ptr;
+}
+
+inline auto Arena::map_chunk(size_t size) -> Chunk* {
+    void* memory = nullptr;
+
+#if defined(__linux__)
+    if (huge_pages_) {
+        size = (size + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+        memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+    if (memory == nullptr || memory == MAP_FAILED) {
+        memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        if (huge_pages_) {
+            // no reserved huge pages => ask for transparent ones
+            ::madvise(memory, size, MADV_HUGEPAGE);
+        }
+    }
+#else
+    memory = ::operator new(size, std::align_val_t{utils::constants::CACHE_LINE_SIZE});
+#endif
+
+    auto* chunk = static_cast<Chunk*>(memory);
+    chunk->next_ = nullptr;
+    chunk->size_ = size;
+    return chunk;
+}
+
+inline void Arena::unmap_chunk(Chunk* chunk) noexcept {
+#if defined(__linux__)
+    ::munmap(chunk, chunk->size_);
+#else
+    ::operator delete(chunk, std::align_val_t{utils::constants::CACHE_LINE_SIZE});
+#endif
+}
+
+inline void Arena::enter(Chunk* chunk, std::byte* cursor) noexcept {
+    current_ = chunk;
+    cursor_ = cursor;
+    limit_ = reinterpret_cast<std::byte*>(chunk) + chunk->size_;
+}
+
+inline std::byte* Arena::data_of(Chunk* chunk) noexcept {
+    ///
+    return reinterpret_cast<std::byte*>(chunk) + kChunkHeaderSize;
+    ///
+}
+
+inline std::byte* Arena::align_up(std::byte* ptr, size_t align) noexcept {
+    assert((align & (align - 1)) == 0);
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    return reinterpret_cast<std::byte*>((address + align - 1) & ~(align - 1));
+}
+
+}  // namespace wr::memory
+
+namespace wr::this_worker {
+
+/*
+ * @brief Scratch arena of the current worker. Call only from tasks running on an executor.
+ */
+inline memory::Arena& arena() noexcept {
+    assert(memory::Arena::current() != nullptr && "this_worker::arena() outside of a worker thread");
+    return *memory::Arena::current();
+}
+
+}  // namespace wr::this_worker
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace wr::memory {
+
+/**
+ * @brief Per-worker pool of fixed-size blocks (size-class freelists).
+ *
+ * @section LAYOUT
+ *
+ *  Every block starts with a header, the payload follows it:
+ *
+ *  | owner | size class | ........ payload ........ |
+ *  |-------- 16 --------|
+ *
+ *  >> owner == nullptr => block came from the heap (oversized payload or no pool on this thread)
+ *  >> while the block is free, its payload stores the link to the next free block
+ *
+ * @section OWNERSHIP
+ *
+ *  >> allocate() is called only by the owner thread => local freelists need no synchronization
+ *  >> deallocate() may be called by any thread:
+ *      - owner thread pushes the block back to its local freelist
+ *      - others push it to the owner's remote-free list (lock-free MPSC stack),
+ *        which the owner takes at once (exchange) when its local freelist runs dry => no ABA
+ *
+ *  >> a pool is freed with its worker, blocks still out are not tracked => a block must come back before
+ *     that: the executor allocates its closures from its own workers' pools only (the heap otherwise)
+ *
+ *  >> Memory is obtained by slabs of kBlocksPerSlab blocks and is returned to the OS only with the pool
+ *  => in steady state there are no calls to malloc at all.
+ */
+class BlockPool {
+  public:  // nested types:
+    static constexpr size_t kHeaderSize = alignof(std::max_align_t);
+    static constexpr std::array<size_t, 4> kClassSizes = {64, 128, 256, 512};
+    static constexpr size_t kClassesCount = kClassSizes.size();
+    static constexpr size_t kBlocksPerSlab = 64;
+
+    /* size class of blocks taken from the heap */
+    static constexpr uint32_t kHeapClass = UINT32_MAX;
+
+  private:  // nested types:
+    struct Header {
+        BlockPool* owner_;
+        uint32_t size_class_;
+    };
+
+    static_assert(sizeof(Header) <= kHeaderSize);
+
+    struct FreeBlock {
+        FreeBlock* next_;
+    };
+
+  private:  // data members:
+    std::array<FreeBlock*, kClassesCount> local_free_{};
+
+    std::array<std::atomic<FreeBlock*>, kClassesCount> remote_free_{};
+
+    std::vector<void*> slabs_;
+
+    static inline thread_local BlockPool* current_ = nullptr;
+
+  public:  // member functions:
+    BlockPool() = default;
+    ~BlockPool();
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+    BlockPool(BlockPool&&) = delete;
+    BlockPool& operator=(BlockPool&&) = delete;
+
+    /*
+     * @brief Allocate a payload of at least `size` bytes. [owner thread only]
+     */
+    [[nodiscard]] void* allocate(size_t size);
+
+    /*
+     * @brief Allocate from the pool of the current thread or from the heap if there is no such pool.
+     */
+    [[nodiscard]] static void* allocate_local(size_t size);
+
+    /*
+     * @brief Allocate from `pool` (it must be the current thread's one) or from the heap if it is nullptr.
+     */
+    [[nodiscard]] static void* allocate_in(BlockPool* pool, size_t size);
+
+    /*
+     * @brief Return the payload to the pool it came from. [any thread]
+     */
+    static void deallocate(void* payload) noexcept;
+
+    /*
+     * @brief Pool which is bound to the current thread (nullptr for threads outside of executors).
+     */
+    static BlockPool* current() noexcept;
+
+    static void set_current(BlockPool* pool) noexcept;
+
+  private:  // member functions:
+    static constexpr uint32_t size_class_of(size_t size) noexcept;
+
+    static void* allocate_heap(size_t size);
+
+    void refill(uint32_t size_class);
+
+    void release_local(Header* header) noexcept;
+
+    void release_remote(Header* header) noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline BlockPool::~BlockPool() {
+    for (void* slab : slabs_) {
+        ::operator delete(slab);
+    }
+}
+
+inline void* BlockPool::allocate(size_t size) {
+    const uint32_t size_class = size_class_of(size);
+    if (size_class == kHeapClass) {
+        return allocate_heap(size);
+    }
+
+    if (local_free_[size_class] == nullptr) {
+        // blocks freed by other threads come first, fresh memory is the last resort
+        local_free_[size_class] = remote_free_[size_class].exchange(nullptr, std::memory_order::acquire);
+        if (local_free_[size_class] == nullptr) {
+            refill(size_class);
+        }
+    }
+
+    FreeBlock* block = local_free_[size_class];
+    local_free_[size_class] = block->next_;
+
+    auto* header = reinterpret_cast<Header*>(reinterpret_cast<std::byte*>(block) - kHeaderSize);
+    header->owner_ = this;
+    header->size_class_ = size_class;
+
+    return block;
+}
+
+inline void* BlockPool::allocate_local(size_t size) {
+    if (auto* pool = current()) {
+        return pool->allocate(size);
+    }
+    return allocate_heap(size);
+}
+
+inline void* BlockPool::allocate_in(BlockPool* pool, size_t size) {
+    assert(pool == nullptr || pool == current());
+    return pool != nullptr ? pool->allocate(size) : allocate_heap(size);
+}
+
+inline void BlockPool::deallocate(void* payload) noexcept {
+    auto* header = reinterpret_cast<Header*>(static_cast<std::byte*>(payload) - kHeaderSize);
+
+    if (header->owner_ == nullptr) {
+        ::operator delete(header);
+        return;
+    }
+
+    if (header->owner_ == current()) {
+        header->owner_->release_local(header);
+    } else {
+        header->owner_->release_remote(header);
+    }
+}
+
+inline BlockPool* BlockPool::current() noexcept {
+    ///
+    return current_;
+    ///
+}
+
+inline void BlockPool::set_current(BlockPool* pool) noexcept {
+    ///
+    current_ = pool;
+    ///
+}
+
+constexpr uint32_t BlockPool::size_class_of(size_t size) noexcept {
+    for (uint32_t i = 0; i < kClassesCount; ++i) {
+        if (size + kHeaderSize <= kClassSizes[i]) {
+            return i;
+        }
+    }
+    return kHeapClass;
+}
+
+inline void* BlockPool::allocate_heap(size_t size) {
+    auto* header = static_cast<Header*>(::operator new(size + kHeaderSize));
+    header->owner_ = nullptr;
+    header->size_class_ = kHeapClass;
+    return reinterpret_cast<std::byte*>(header) + kHeaderSize;
+}
+
+inline void BlockPool::refill(uint32_t size_class) {
+    const size_t block_size = kClassSizes[size_class];
+
+    auto* slab = static_cast<std::byte*>(::operator new(block_size * kBlocksPerSlab));
+    slabs_.push_back(slab);
+
+    // thread the blocks into a freelist: [0] -> [1] -> ... -> [N - 1] -> nullptr
+    FreeBlock* head = nullptr;
+    for (size_t i = kBlocksPerSlab; i-- > 0;) {
+        auto* block = reinterpret_cast<FreeBlock*>(slab + i * block_size + kHeaderSize);
+        block->next_ = head;
+        head = block;
+    }
+    local_free_[size_class] = head;
+}
+
+inline void BlockPool::release_local(Header* header) noexcept {
+    auto* block = reinterpret_cast<FreeBlock*>(reinterpret_cast<std::byte*>(header) + kHeaderSize);
+    block->next_ = local_free_[header->size_class_];
+    local_free_[header->size_class_] = block;
+}
+
+inline void BlockPool::release_remote(Header* header) noexcept {
+    auto* block = reinterpret_cast<FreeBlock*>(reinterpret_cast<std::byte*>(header) + kHeaderSize);
+    auto& head = remote_free_[header->size_class_];
+
+    block->next_ = head.load(std::memory_order::relaxed);
+    while (!head.compare_exchange_weak(block->next_, block, std::memory_order::release, std::memory_order::relaxed)) {
+        // `block->next_` is refreshed by the failed CAS
+    }
+}
+
+}  // namespace wr::memory
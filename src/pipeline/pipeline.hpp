@@ -0,0 +1,405 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../tasks/concept.hpp"
+
+namespace wr {
+
+enum class StageMode {
+    kParallel,           // any number of items at once
+    kSerialInOrder,      // one item at a time, in the order the input produced them
+    kSerialOutOfOrder,   // one item at a time, in any order
+};
+
+/**
+ * @brief TBB-style pipeline: a serial input followed by parallel / serial stages, on top of an executor.
+ *
+ * @section TOKENS
+ *
+ *  `max_tokens` tokens are allocated once, each one owns an `Item` and IS a task of the executor:
+ *  an item travels through the stages as its token, and a finished token goes back to the input for the
+ *  next item => at most `max_tokens` items are in flight, and nothing is allocated per item.
+ *
+ * @section STAGES
+ *
+ *  >> parallel: the token runs the stage function right in its task and moves on
+ *  >> serial:   the stage is a one-word mailbox (incoming stack | busy bit, as in `Strand`): a token pushes
+ *               itself, the one which sets the busy bit becomes the runner and drains the stage; processed
+ *               tokens are submitted to continue on their own => no lock, no blocked worker
+ *  >> in order: the runner moves incoming tokens to a private reorder buffer (slot = sequence number
+ *               modulo capacity) and processes only the contiguous prefix starting at the expected number;
+ *               the rest waits there for the next runner. At most `max_tokens` numbers lie between the expected
+ *               one and the newest one => the buffer of `max_tokens` slots never collides.
+ *
+ *  The input is a serial stage too: its runner fills free tokens until the input function returns false.
+ *  Stage functions are invoked from `run() noexcept`: an exception escaping them terminates the program.
+ */
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+class Pipeline {
+  public:  // nested types:
+    using TaskT = typename Executor::TaskT;
+
+  private:  // nested types:
+    class Token : public TaskT {
+      public:  // data members:
+        Pipeline* pipeline_ = nullptr;
+        Token* next_ = nullptr;
+        uint64_t sequence_ = 0;
+        size_t stage_ = 0;
+        Item item_{};
+
+      public:  // member functions:
+        Token() noexcept(std::is_nothrow_default_constructible_v<Item>) : TaskT(&Pipeline::trampoline) {}
+    };
+
+    struct Stage {
+        StageMode mode_;
+        std::function<void(Item&)> fun_;
+
+        /* incoming stack | busy bit */
+        std::atomic<uintptr_t> state_ = 0;
+
+        /* runner only */
+        std::unique_ptr<Token*[]> reorder_;
+        uint64_t expected_ = 0;
+    };
+
+    static constexpr uintptr_t kBusy = 1;
+
+    static_assert(alignof(Token) > kBusy, "low bit of the token address is used as the flag");
+
+  private:  // data members:
+    Executor* host_;
+
+    const size_t tokens_count_;
+    const size_t reorder_capacity_;  // power of two >= tokens_count_
+    std::unique_ptr<Token[]> tokens_;
+
+    std::function<bool(Item&)> input_;
+    std::vector<std::unique_ptr<Stage>> stages_;  // [0] is the input
+
+    /* input runner only */
+    uint64_t next_sequence_ = 0;
+    bool input_done_ = false;
+
+    /* current run */
+    std::atomic<size_t> retired_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable finished_;
+    bool running_ = false;
+
+  public:  // member functions:
+    Pipeline(Executor* host, size_t max_tokens);
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+    Pipeline(Pipeline&&) = delete;
+    Pipeline& operator=(Pipeline&&) = delete;
+
+    /*  -------------------- Building (not while running) -------------------- */
+
+    /*
+     * @brief Serial source: fills the item and returns true, or returns false at the end of the input.
+     */
+    template <typename F>
+        requires std::is_invocable_r_v<bool, F&, Item&>
+    Pipeline& input(F&& fun);
+
+    template <typename F>
+        requires std::invocable<F&, Item&>
+    Pipeline& stage(StageMode mode, F&& fun);
+
+    /*  -------------------- Running -------------------- */
+
+    /*
+     * @brief Start a run (asynchronously). The previous run must be finished.
+     */
+    void run();
+
+    /*
+     * @brief Block the calling thread until the input is exhausted and every item has left the pipeline.
+     * [not from the executor's tasks]
+     */
+    void wait();
+
+    void run_and_wait();
+
+  private:  // member functions:
+    static void trampoline(TaskT* self) noexcept;
+
+    // moves the token through parallel stages up to the next serial one
+    void advance(Token* token) noexcept;
+
+    // pushes the token to a serial stage, true if the caller has become its runner
+    bool enqueue(Stage& stage, Token* token) noexcept;
+
+    void drain(size_t index) noexcept;
+
+    // one token in the stage's runner: false if it has been retired (end of the input)
+    bool process(size_t index, Token* token) noexcept;
+
+    void retire(size_t count) noexcept;
+
+    static Token* top_of(uintptr_t state) noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+Pipeline<Executor, Item>::Pipeline(Executor* host, size_t max_tokens)
+    : host_(host),
+      tokens_count_(max_tokens),
+      reorder_capacity_(std::bit_ceil(max_tokens)),
+      tokens_(std::make_unique<Token[]>(max_tokens)) {
+    assert(max_tokens > 0);
+
+    for (size_t i = 0; i < tokens_count_; ++i) {
+        tokens_[i].pipeline_ = this;
+    }
+
+    auto source = std::make_unique<Stage>();
+    source->mode_ = StageMode::kSerialOutOfOrder;
+    stages_.push_back(std::move(source));
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+Pipeline<Executor, Item>::~Pipeline() {
+    ///
+    wait();
+    ///
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+template <typename F>
+    requires std::is_invocable_r_v<bool, F&, Item&>
+auto Pipeline<Executor, Item>::input(F&& fun) -> Pipeline& {
+    input_ = std::forward<F>(fun);
+    return *this;
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+template <typename F>
+    requires std::invocable<F&, Item&>
+auto Pipeline<Executor, Item>::stage(StageMode mode, F&& fun) -> Pipeline& {
+    auto stage = std::make_unique<Stage>();
+    stage->mode_ = mode;
+    stage->fun_ = std::forward<F>(fun);
+    if (mode == StageMode::kSerialInOrder) {
+        stage->reorder_ = std::make_unique<Token*[]>(reorder_capacity_);
+    }
+    stages_.push_back(std::move(stage));
+    return *this;
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+void Pipeline<Executor, Item>::run() {
+    assert(input_ && "pipeline has no input");
+
+    {
+        std::lock_guard lock(mutex_);
+        assert(!running_ && "previous run is not finished");
+        running_ = true;
+    }
+
+    next_sequence_ = 0;
+    input_done_ = false;
+    retired_.store(0, std::memory_order::relaxed);
+    for (auto& stage : stages_) {
+        stage->expected_ = 0;
+    }
+
+    // all the tokens are free: [1..] wait in the input stage, [0] enters it through its task and
+    // becomes the runner (the submit publishes everything above)
+    uintptr_t free = 0;
+    for (size_t i = tokens_count_; i-- > 1;) {
+        tokens_[i].next_ = top_of(free);
+        free = reinterpret_cast<uintptr_t>(&tokens_[i]);
+    }
+    stages_[0]->state_.store(free, std::memory_order::relaxed);
+
+    tokens_[0].stage_ = 0;
+    host_->submit(&tokens_[0]);
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+void Pipeline<Executor, Item>::wait() {
+    std::unique_lock lock(mutex_);
+    finished_.wait(lock, [this] { return !running_; });
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+void Pipeline<Executor, Item>::run_and_wait() {
+    run();
+    wait();
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+void Pipeline<Executor, Item>::trampoline(TaskT* self) noexcept {
+    auto* token = static_cast<Token*>(self);
+    token->pipeline_->advance(token);
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+void Pipeline<Executor, Item>::advance(Token* token) noexcept {
+    while (true) {
+        const size_t index = token->stage_;
+        Stage& stage = *stages_[index];
+
+        if (index != 0 && stage.mode_ == StageMode::kParallel) {
+            stage.fun_(token->item_);
+            token->stage_ = index + 1 == stages_.size() ? 0 : index + 1;
+            continue;
+        }
+
+        if (enqueue(stage, token)) {
+            drain(index);
+        }
+        return;
+    }
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+bool Pipeline<Executor, Item>::enqueue(Stage& stage, Token* token) noexcept {
+    auto state = stage.state_.load(std::memory_order::relaxed);
+    do {
+        token->next_ = top_of(state);
+    } while (!stage.state_.compare_exchange_weak(state, reinterpret_cast<uintptr_t>(token) | kBusy,
+                                                 std::memory_order::acq_rel, std::memory_order::relaxed));
+
+    return (state & kBusy) == 0;
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+void Pipeline<Executor, Item>::drain(size_t index) noexcept {
+    Stage& stage = *stages_[index];
+    Executor* host = host_;
+    const size_t mask = reorder_capacity_ - 1;
+
+    // The last processed token is held back until the stage is released: while it is not submitted, the run
+    // cannot complete => the pipeline stays alive as long as the runner touches it.
+    Token* held = nullptr;
+    size_t retired = 0;
+
+    auto pass = [&](Token* token) {
+        if (!process(index, token)) {
+            ++retired;
+            return;
+        }
+        if (held != nullptr) {
+            host->submit(held);
+        }
+        held = token;
+    };
+
+    while (true) {
+        // stack is LIFO => reverse it into arrival order
+        Token* fifo = nullptr;
+        for (Token* stack = top_of(stage.state_.exchange(kBusy, std::memory_order::acquire)); stack != nullptr;) {
+            Token* next = stack->next_;
+            stack->next_ = fifo;
+            fifo = stack;
+            stack = next;
+        }
+
+        while (fifo != nullptr) {
+            Token* token = std::exchange(fifo, fifo->next_);
+
+            if (stage.mode_ == StageMode::kSerialInOrder) {
+                stage.reorder_[token->sequence_ & mask] = token;
+            } else {
+                pass(token);
+            }
+        }
+
+        if (stage.mode_ == StageMode::kSerialInOrder) {
+            // the contiguous prefix only, the rest waits for the tokens in front of it
+            while (Token* token = stage.reorder_[stage.expected_ & mask]) {
+                assert(token->sequence_ == stage.expected_);
+                stage.reorder_[stage.expected_ & mask] = nullptr;
+                ++stage.expected_;
+                pass(token);
+            }
+        }
+
+        uintptr_t expected = kBusy;
+        if (stage.state_.compare_exchange_strong(expected, 0, std::memory_order::release,
+                                                 std::memory_order::relaxed)) {
+            break;
+        }
+        /* tokens arrived meanwhile */
+    }
+
+    if (held != nullptr) {
+        host->submit(held);
+    }
+    // goes last: it may complete the run (and free the pipeline)
+    if (retired > 0) {
+        retire(retired);
+    }
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+bool Pipeline<Executor, Item>::process(size_t index, Token* token) noexcept {
+    if (index == 0) {
+        if (input_done_ || !input_(token->item_)) {
+            input_done_ = true;
+            return false;
+        }
+        token->sequence_ = next_sequence_++;
+    } else {
+        stages_[index]->fun_(token->item_);
+    }
+
+    // past the last stage the token goes back to the input
+    token->stage_ = index + 1 == stages_.size() ? 0 : index + 1;
+    return true;
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+void Pipeline<Executor, Item>::retire(size_t count) noexcept {
+    if (retired_.fetch_add(count, std::memory_order::acq_rel) + count == tokens_count_) {
+        // notified under the lock: `wait()` cannot return (and the pipeline die) before we are done here
+        std::lock_guard lock(mutex_);
+        running_ = false;
+        finished_.notify_all();
+    }
+}
+
+template <typename Executor, typename Item>
+    requires task::TrampolineTask<typename Executor::TaskT> && std::default_initializable<Item>
+auto Pipeline<Executor, Item>::top_of(uintptr_t state) noexcept -> Token* {
+    ///
+    return reinterpret_cast<Token*>(state & ~kBusy);
+    ///
+}
+
+}  // namespace wr
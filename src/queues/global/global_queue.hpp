@@ -1,8 +1,12 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <limits>
 #include <mutex>
 #include <optional>
+#include <utility>
 
 #include <ntrusive/intrusive.hpp>
 
@@ -25,6 +29,12 @@ class GlobalQueue {
     // Point of contention:
     mutable std::mutex mutex_;  // `mutable` since it is used in the constant method `.empty()`
 
+    // `!buffer_.empty()`, refreshed under the lock by every operation => readable without it
+    std::atomic<bool> non_empty_ = false;
+
+    // length of `buffer_`, also refreshed under the lock (monitoring)
+    std::atomic<size_t> size_ = 0;
+
   public:  // member functions:
     GlobalQueue() = default;
     ~GlobalQueue() = default;
@@ -38,8 +48,11 @@ class GlobalQueue {
     // Pushes a single task to the back of the queue
     void push(TaskPtr task) noexcept;
 
-    // Docks a batch of tasks to GlobalQueue.
+    // Docks a batch of `count` tasks to GlobalQueue.
     // O(1) complexity thanks to IntrusiveList::splice
+    void push_batch(Batch&& batch, size_t count) noexcept;
+
+    // The same when the caller does not know the length: the batch is counted first (outside of the lock)
     void push_batch(Batch&& batch) noexcept;
 
     // -------------------- Consumer API --------------------
@@ -51,13 +64,20 @@ class GlobalQueue {
     // O(max_count) complexity
     auto try_pop_batch(size_t max_count) noexcept -> std::optional<Batch>;
 
-  private:  // member functions:
     // `empty()` needed not for the internal logic of shifting tasks, but for
-    // external monitoring of the system status and for the logic of scheduler's shutdown:
+    // external monitoring of the system status and for the parking logic of workers:
     auto empty() const noexcept -> bool;
 
-  private:  // TODO: friends declaration for .empty() users:
-            // . . .
+    // Lock-free, possibly stale `!empty()`: lets a consumer skip a queue which is (most likely)
+    // empty without touching the lock
+    auto maybe_non_empty() const noexcept -> bool;
+
+    // Lock-free, possibly stale length, for monitoring (see `introspect/`)
+    auto size() const noexcept -> size_t;
+
+  private:  // member functions:
+    void add_size(size_t count) noexcept;  // under the lock
+    void sub_size(size_t count) noexcept;  // under the lock
 };
 
 /* ---------------------------------- IMPLEMENTATION ---------------------------------- */
@@ -66,6 +86,8 @@ template <task::Task TaskT>
 void GlobalQueue<TaskT>::push(TaskPtr task) noexcept {
     std::lock_guard lock(mutex_);
     buffer_.push_back(*task);
+    non_empty_.store(true, std::memory_order::relaxed);
+    add_size(1);
 }
 
 template <task::Task TaskT>
@@ -76,11 +98,14 @@ auto GlobalQueue<TaskT>::try_pop() noexcept -> std::optional<typename GlobalQueu
         return std::nullopt;
     }
 
-    return buffer_.try_pop_front();
+    auto task = buffer_.try_pop_front();
+    non_empty_.store(!buffer_.empty(), std::memory_order::relaxed);
+    sub_size(1);
+    return task;
 }
 
 template <task::Task TaskT>
-void GlobalQueue<TaskT>::push_batch(Batch&& batch) noexcept {
+void GlobalQueue<TaskT>::push_batch(Batch&& batch, size_t count) noexcept {
     if (batch.empty()) {
         return;
     }
@@ -88,9 +113,18 @@ void GlobalQueue<TaskT>::push_batch(Batch&& batch) noexcept {
     {
         std::lock_guard lock(mutex_);
         buffer_.splice(buffer_.end(), batch);  // O(1)
+        non_empty_.store(true, std::memory_order::relaxed);
+        add_size(count);
     }
 }
 
+template <task::Task TaskT>
+void GlobalQueue<TaskT>::push_batch(Batch&& batch) noexcept {
+    Batch counted;
+    const size_t count = batch.extract_front(counted, std::numeric_limits<size_t>::max());
+    push_batch(std::move(counted), count);
+}
+
 template <task::Task TaskT>
 std::optional<typename GlobalQueue<TaskT>::Batch>
 GlobalQueue<TaskT>::try_pop_batch(size_t max_count) noexcept {
@@ -105,6 +139,8 @@ GlobalQueue<TaskT>::try_pop_batch(size_t max_count) noexcept {
 
     Batch result;
     size_t actual_count = buffer_.extract_front(result, max_count);
+    non_empty_.store(!buffer_.empty(), std::memory_order::relaxed);
+    sub_size(actual_count);
 
     if (actual_count == 0) {
         return std::nullopt;
@@ -119,4 +155,32 @@ bool GlobalQueue<TaskT>::empty() const noexcept {
     return buffer_.empty();
 }
 
+template <task::Task TaskT>
+bool GlobalQueue<TaskT>::maybe_non_empty() const noexcept {
+    ///
+    return non_empty_.load(std::memory_order::relaxed);
+    ///
+}
+
+template <task::Task TaskT>
+size_t GlobalQueue<TaskT>::size() const noexcept {
+    ///
+    return size_.load(std::memory_order::relaxed);
+    ///
+}
+
+template <task::Task TaskT>
+void GlobalQueue<TaskT>::add_size(size_t count) noexcept {
+    ///
+    size_.store(size_.load(std::memory_order::relaxed) + count, std::memory_order::relaxed);
+    ///
+}
+
+template <task::Task TaskT>
+void GlobalQueue<TaskT>::sub_size(size_t count) noexcept {
+    ///
+    size_.store(size_.load(std::memory_order::relaxed) - count, std::memory_order::relaxed);
+    ///
+}
+
 }  // namespace wr::queues
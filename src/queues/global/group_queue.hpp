@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "../../tasks/concept.hpp"
+#include "../../utils/constants.hpp"
+#include "global_queue.hpp"
+
+namespace wr::queues {
+
+/* Injection queue of a task group (tenant): a GlobalQueue with a weight and throughput counters.
+ * Workers choose between the groups with a deficit round robin (see `Worker::try_pop_global`).
+ * One cache line per group: the counters of different groups do not interfere. */
+template <task::Task TaskT>
+class alignas(utils::constants::CACHE_LINE_SIZE) GroupQueue {
+  public:  // nested types:
+    using TaskPtr = TaskT*;
+
+  private:  // data members:
+    GlobalQueue<TaskT> queue_;
+
+    // share of the group: tasks per round of the round robin; set once, before the group is published
+    size_t weight_ = 0;
+
+    std::atomic<uint64_t> submitted_ = 0;
+    std::atomic<uint64_t> executed_ = 0;  // taken by the workers
+
+  public:  // member functions:
+    GroupQueue() = default;
+    ~GroupQueue() = default;
+    GroupQueue(const GroupQueue&) = delete;             // non-copyable;
+    GroupQueue& operator=(const GroupQueue&) = delete;  // non-copyassignable;
+    GroupQueue(GroupQueue&&) = delete;                  // non-movable;
+    GroupQueue& operator=(GroupQueue&&) = delete;       // non-moveassignable;
+
+    void set_weight(size_t weight) noexcept;
+    size_t weight() const noexcept;
+
+    void push(TaskPtr task) noexcept;
+
+    auto try_pop() noexcept -> std::optional<TaskPtr>;
+
+    auto empty() const noexcept -> bool;
+    auto maybe_non_empty() const noexcept -> bool;
+    auto size() const noexcept -> size_t;
+
+    uint64_t submitted() const noexcept;
+    uint64_t executed() const noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <task::Task TaskT>
+void GroupQueue<TaskT>::set_weight(size_t weight) noexcept {
+    ///
+    weight_ = weight;
+    ///
+}
+
+template <task::Task TaskT>
+size_t GroupQueue<TaskT>::weight() const noexcept {
+    ///
+    return weight_;
+    ///
+}
+
+template <task::Task TaskT>
+void GroupQueue<TaskT>::push(TaskPtr task) noexcept {
+    submitted_.fetch_add(1, std::memory_order::relaxed);
+    queue_.push(task);
+}
+
+template <task::Task TaskT>
+auto GroupQueue<TaskT>::try_pop() noexcept -> std::optional<TaskPtr> {
+    auto task = queue_.try_pop();
+    if (task) {
+        executed_.fetch_add(1, std::memory_order::relaxed);
+    }
+    return task;
+}
+
+template <task::Task TaskT>
+bool GroupQueue<TaskT>::empty() const noexcept {
+    ///
+    return queue_.empty();
+    ///
+}
+
+template <task::Task TaskT>
+bool GroupQueue<TaskT>::maybe_non_empty() const noexcept {
+    ///
+    return queue_.maybe_non_empty();
+    ///
+}
+
+template <task::Task TaskT>
+size_t GroupQueue<TaskT>::size() const noexcept {
+    ///
+    return queue_.size();
+    ///
+}
+
+template <task::Task TaskT>
+uint64_t GroupQueue<TaskT>::submitted() const noexcept {
+    ///
+    return submitted_.load(std::memory_order::relaxed);
+    ///
+}
+
+template <task::Task TaskT>
+uint64_t GroupQueue<TaskT>::executed() const noexcept {
+    ///
+    return executed_.load(std::memory_order::relaxed);
+    ///
+}
+
+}  // namespace wr::queues
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+#include "../../tasks/concept.hpp"
+#include "../../utils/constants.hpp"
+#include "../global/global_queue.hpp"
+
+namespace wr::queues {
+
+// >> Bounded ring + unbounded overflow
+// >> Lock-free (ring)
+// >> MP-SC
+/**
+ * @brief Per-worker mailbox for affinity-targeted tasks. Tasks in it are never stolen.
+ *
+ * @section RING
+ *
+ *  Every slot carries a sequence number (D. Vyukov's bounded queue), which tells whose turn it is:
+ *
+ *  >> sequence == pos          => slot is free for the producer which claims `pos`
+ *  >> sequence == pos + 1      => slot is published for the consumer at `pos`
+ *  >> sequence == pos + Cap    => consumer has released the slot for the next lap
+ *
+ *  Producers claim positions with CAS on `tail_`, the consumer owns `head_` exclusively.
+ *
+ *  A ring of task pointers rather than a linked queue: `submit_to` accepts every task of the executor, and a
+ *  lock-free linked queue would need one more link in every task type (see `tasks/concept.hpp`). A push is
+ *  a CAS and two stores, and the consumer reads neighbouring slots.
+ *
+ * @section OVERFLOW
+ *
+ *  When the ring is full producers fall back to a mutex-protected list which belongs to the same
+ *  worker => affinity is kept. An atomic counter keeps `empty()`/`try_pop()` lock-free while it is unused.
+ *  Order between the ring and the overflow list is not preserved.
+ *
+ * @section HANDOFF
+ *
+ *  Another worker may hand a whole batch over (work pushing, see `Worker::push_local`): it is kept apart
+ *  from the targeted tasks, the owner adopts it at once into its local queue => the batch stays stealable.
+ */
+template <task::Task TaskT, size_t Capacity>
+    requires utils::constants::check::IsPowerOfTwo<Capacity>
+class Inbox {
+  public:  // nested types:
+    using TaskPtr = TaskT*;
+    using Batch = IntrusiveList<TaskT>;
+
+    static constexpr size_t kCapacity = Capacity;
+    static constexpr size_t kMask = Capacity - 1;
+
+  private:  // nested types:
+    struct Slot {
+        std::atomic<uint64_t> sequence_;
+        TaskPtr task_ = nullptr;
+    };
+
+  private:  // data members:
+    std::array<Slot, Capacity> slots_;
+
+    /* Next position to claim. Modify by producers. */
+    alignas(utils::constants::CACHE_LINE_SIZE) std::atomic<uint64_t> tail_ = 0;
+
+    /* Next position to consume. Modify by owner only. */
+    alignas(utils::constants::CACHE_LINE_SIZE) uint64_t head_ = 0;
+
+    alignas(utils::constants::CACHE_LINE_SIZE) std::atomic<size_t> overflow_size_ = 0;
+    GlobalQueue<TaskT> overflow_;
+
+    alignas(utils::constants::CACHE_LINE_SIZE) std::atomic<bool> has_handoff_ = false;
+    GlobalQueue<TaskT> handoff_;
+
+  public:  // member functions:
+    Inbox() noexcept;
+
+    Inbox(const Inbox&) = delete;
+    Inbox& operator=(const Inbox&) = delete;
+    Inbox(Inbox&&) = delete;
+    Inbox& operator=(Inbox&&) = delete;
+
+    /*  -------------------- Producer API [any thread] -------------------- */
+
+    /*
+     * @brief Push to the ring, returns false if it is full.
+     */
+    bool try_push(TaskPtr task) noexcept;
+
+    /*
+     * @brief Push to the ring or to the overflow list if the ring is full.
+     */
+    void push(TaskPtr task) noexcept;
+
+    /*
+     * @brief Hand a batch of `count` tasks over to the owner, O(1).
+     */
+    void push_batch(Batch&& batch, size_t count) noexcept;
+
+    /*
+     * @brief A batch is waiting to be adopted (lock-free hint).
+     */
+    bool has_handoff() const noexcept;
+
+    /*  -------------------- Consumer API [owner only] -------------------- */
+
+    std::optional<TaskPtr> try_pop() noexcept;
+
+    /*
+     * @brief Take everything handed over.
+     */
+    std::optional<Batch> try_take_handoff() noexcept;
+
+    /*
+     * @brief Seq-cst check: pairs with the producer's fence in `Worker::push_inbox` (parking protocol).
+     */
+    bool empty() const noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <task::Task TaskT, size_t Capacity>
+    requires utils::constants::check::IsPowerOfTwo<Capacity>
+Inbox<TaskT, Capacity>::Inbox() noexcept {
+    for (size_t i = 0; i < Capacity; ++i) {
+        slots_[i].sequence_.store(i, std::memory_order::relaxed);
+    }
+}
+
+template <task::Task TaskT, size_t Capacity>
+    requires utils::constants::check::IsPowerOfTwo<Capacity>
+bool Inbox<TaskT, Capacity>::try_push(TaskPtr task) noexcept {
+    auto pos = tail_.load(std::memory_order::relaxed);
+
+    while (true) {
+        Slot& slot = slots_[pos & kMask];
+        auto seq = slot.sequence_.load(std::memory_order::acquire);
+        auto diff = static_cast<int64_t>(seq - pos);
+
+        if (diff == 0) {
+            /* slot is free: try to claim the position */
+            if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order::relaxed)) {
+                slot.task_ = task;
+                slot.sequence_.store(pos + 1, std::memory_order::release);
+                return true;
+            }
+            /* `pos` is refreshed by the failed CAS */
+        } else if (diff < 0) {
+            /* consumer has not released the slot from the previous lap => full */
+            return false;
+        } else {
+            /* another producer took `pos` */
+            pos = tail_.load(std::memory_order::relaxed);
+        }
+    }
+}
+
+template <task::Task TaskT, size_t Capacity>
+    requires utils::constants::check::IsPowerOfTwo<Capacity>
+void Inbox<TaskT, Capacity>::push(TaskPtr task) noexcept {
+    if (try_push(task)) {
+        return;
+    }
+
+    /* counted before the push => the counter never underflows */
+    overflow_size_.fetch_add(1);
+    overflow_.push(task);
+}
+
+template <task::Task TaskT, size_t Capacity>
+    requires utils::constants::check::IsPowerOfTwo<Capacity>
+void Inbox<TaskT, Capacity>::push_batch(Batch&& batch, size_t count) noexcept {
+    handoff_.push_batch(std::move(batch), count);
+    has_handoff_.store(true);  // after the push => the owner never misses the batch
+}
+
+template <task::Task TaskT, size_t Capacity>
+    requires utils::constants::check::IsPowerOfTwo<Capacity>
+bool Inbox<TaskT, Capacity>::has_handoff() const noexcept {
+    ///
+    return has_handoff_.load(std::memory_order::relaxed);
+    ///
+}
+
+template <task::Task TaskT, size_t Capacity>
+    requires utils::constants::check::IsPowerOfTwo<Capacity>
+auto Inbox<TaskT, Capacity>::try_take_handoff() noexcept -> std::optional<Batch> {
+    if (!has_handoff_.load(std::memory_order::relaxed)) {
+        return std::nullopt;
+    }
+
+    // cleared before the take: a concurrent push sets it again
+    has_handoff_.store(false);
+    return handoff_.try_pop_batch(std::numeric_limits<size_t>::max());
+}
+
+template <task::Task TaskT, size_t Capacity>
+    requires utils::constants::check::IsPowerOfTwo<Capacity>
+auto Inbox<TaskT, Capacity>::try_pop() noexcept -> std::optional<TaskPtr> {
+    Slot& slot = slots_[head_ & kMask];
+
+    if (slot.sequence_.load(std::memory_order::acquire) == head_ + 1) {
+        auto* task = slot.task_;
+        /* release the slot for the producers of the next lap */
+        slot.sequence_.store(head_ + Capacity, std::memory_order::release);
+        ++head_;
+        return task;
+    }
+
+    if (overflow_size_.load(std::memory_order::relaxed) > 0) {
+        if (auto task = overflow_.try_pop()) {
+            overflow_size_.fetch_sub(1);
+            return task;
+        }
+    }
+
+    return std::nullopt;
+}
+
+template <task::Task TaskT, size_t Capacity>
+    requires utils::constants::check::IsPowerOfTwo<Capacity>
+bool Inbox<TaskT, Capacity>::empty() const noexcept {
+    /* a claimed-but-unpublished slot counts as non-empty: the task is about to appear */
+    return tail_.load() == head_ && overflow_size_.load() == 0 && !has_handoff_.load();
+}
+
+}  // namespace wr::queues
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
@@ -57,13 +58,13 @@ class SharedState {
      * @brief Load bottom index.
      */
     [[nodiscard]]
-    uint64_t load_bottom() const noexcept;
+    uint64_t load_bottom(std::memory_order mo = std::memory_order::seq_cst) const noexcept;
 
     /*
      * @brief Load top index.
      */
     [[nodiscard]]
-    uint64_t load_top() const noexcept;
+    uint64_t load_top(std::memory_order mo = std::memory_order::seq_cst) const noexcept;
 
     /*
      * @brief Store bottom index.
@@ -105,17 +106,17 @@ class SharedState {
 
 template <task::Task TaskType, size_t Capacity>
     requires utils::constants::check::IsPowerOfTwo<Capacity>
-uint64_t SharedState<TaskType, Capacity>::load_bottom() const noexcept {
+uint64_t SharedState<TaskType, Capacity>::load_bottom(std::memory_order mo) const noexcept {
     ///
-    return top_.load();
+    return bottom_.load(mo);
     ///
 }
 
 template <task::Task TaskType, size_t Capacity>
     requires utils::constants::check::IsPowerOfTwo<Capacity>
-uint64_t SharedState<TaskType, Capacity>::load_top() const noexcept {
+uint64_t SharedState<TaskType, Capacity>::load_top(std::memory_order mo) const noexcept {
     ///
-    return top_.load();
+    return top_.load(mo);
     ///
 }
 
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
 #include "fwd.hpp"
 #include "loot.hpp"
 #include "shared_state.hpp"
@@ -26,11 +30,19 @@ class StealHandle {
   public:  // member functions:
     explicit StealHandle(SharedState<TaskType, Capacity>* state) : state_(state) {}
 
+    /*
+     * @brief Try to steal a single task from the top of the victim's queue.
+     */
     [[nodiscard]]
-    /* !! TODO !! */ Loot<TaskType> steal() noexcept;
+    Loot<TaskType> steal() noexcept;
 
+    /*
+     * @brief Steal up to half of the victim's tasks: the last stolen task is returned to the caller,
+     * the rest are pushed into `dest` (the thief's own queue). The number of stolen tasks is stored
+     * to `stolen` (if given).
+     */
     [[nodiscard]]
-    /* !! TODO !! */ Loot<TaskType> steal_batch_and_pop(WorkStealingQueue<TaskType, Capacity>& dest) noexcept;
+    Loot<TaskType> steal_batch_and_pop(WorkStealingQueue<TaskType, Capacity>& dest, size_t* stolen = nullptr) noexcept;
 
     [[nodiscard]]
     bool empty() const noexcept;
@@ -43,8 +55,76 @@ class StealHandle {
 
 /* ---------------------------------- IMPLEMENTATION ---------------------------------- */
 
-/*
- * ...
- */
+template <task::Task TaskType, size_t Capacity>
+Loot<TaskType> StealHandle<TaskType, Capacity>::steal() noexcept {
+    auto top = state_->load_top();
+
+    /* pairs with the fence in owner's try_pop(): either we see the decremented bottom or owner sees our top */
+    std::atomic_thread_fence(std::memory_order::seq_cst);
+
+    auto bt = state_->load_bottom();
+
+    if (static_cast<int64_t>(bt - top) <= 0) {
+        return Loot<TaskType>::Empty();
+    }
+
+    /* the slot must be read before claiming it: after a successful CAS the owner may reuse it */
+    auto task = state_->load_task(top);
+
+    if (!state_->try_increment_top(top)) {
+        /* lost the race to the owner or another thief */
+        return Loot<TaskType>::Retry();
+    }
+
+    return Loot<TaskType>::Success(task);
+}
+
+template <task::Task TaskType, size_t Capacity>
+Loot<TaskType> StealHandle<TaskType, Capacity>::steal_batch_and_pop(WorkStealingQueue<TaskType, Capacity>& dest,
+                                                                    size_t* stolen) noexcept {
+    /* The batch is claimed one CAS at a time: claiming [top; top + n) with a single CAS would race with
+     * the owner popping from the bottom without touching top (it only CASes top for the last task). */
+    auto loot = steal();
+
+    if (!loot.success()) {
+        return loot;
+    }
+
+    auto last = std::move(loot).unwrap();
+
+    auto top = state_->load_top();
+    auto bt = state_->load_bottom();
+    auto half = static_cast<int64_t>(bt - top) / 2;
+
+    /* `dest` is owned by the calling thief => its free room can only grow while we are here */
+    auto dest_size = dest.state_.load_bottom(std::memory_order::relaxed) - dest.state_.load_top();
+    half = std::min<int64_t>(half, static_cast<int64_t>(Capacity - dest_size));
+
+    size_t count = 1;
+    for (int64_t i = 0; i < half; ++i) {
+        auto next = steal();
+        if (!next.success()) {
+            break;
+        }
+
+        dest.try_push(last);
+        last = std::move(next).unwrap();
+        ++count;
+    }
+
+    if (stolen != nullptr) {
+        *stolen = count;
+    }
+    return Loot<TaskType>::Success(last);
+}
+
+/* ---------------------------------- */
+
+template <task::Task TaskType, size_t Capacity>
+bool StealHandle<TaskType, Capacity>::empty() const noexcept {
+    ///
+    return static_cast<int64_t>(state_->load_bottom() - state_->load_top()) <= 0;
+    ///
+}
 
 };  // namespace wr::queues
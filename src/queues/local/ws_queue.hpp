@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <ntrusive/intrusive.hpp>
 #include <optional>
 
@@ -29,7 +30,7 @@ class WorkStealingQueue {
     friend class StealHandle<TaskT, Capacity>;
 
   public:  // member functions:
-    WorkStealingQueue();
+    WorkStealingQueue() = default;
     ~WorkStealingQueue() = default;
 
     WorkStealingQueue(const WorkStealingQueue&) = delete;             // non-copyable
@@ -55,12 +56,19 @@ class WorkStealingQueue {
      * @brief Offload half of all tasks from the local queue to the global one if the local queue turns out to be full
      * when attempting a push operation.
      *
-     * @return List of offloaded tasks.
+     * @return List of offloaded tasks, their number is stored to `offloaded` (if given).
      */
-    std::optional<Batch> offload_half() noexcept;
+    std::optional<Batch> offload_half(size_t* offloaded = nullptr) noexcept;
+
+    /*  -------------------- Monitoring -------------------- */
+
+    /*
+     * @brief `bottom - top` as seen from any thread: a racy estimate, never negative.
+     */
+    size_t size() const noexcept;
 
     [[nodiscard]]
-    /* !! TODO !! */ StealHandle<TaskT, Capacity> create_stealer() noexcept;
+    StealHandle<TaskT, Capacity> create_stealer() noexcept;
 };
 
 /* ---------------------------------- IMPLEMENTATION ---------------------------------- */
@@ -107,8 +115,8 @@ auto WorkStealingQueue<TaskT, Capacity>::try_pop() noexcept -> std::optional<Tas
 
     auto top = state_.load_top();
 
-    /* queue is empty... */
-    if (top >= bt) {
+    /* queue is empty... [indices are unsigned => compare the signed distance] */
+    if (static_cast<int64_t>(bt - top) < 0) {
         /* cancellation... */
         state_.store_bottom(++bt);
         return std::nullopt;
@@ -139,17 +147,28 @@ auto WorkStealingQueue<TaskT, Capacity>::try_pop() noexcept -> std::optional<Tas
     }
 }
 
+template <task::Task TaskT, size_t Capacity>
+    requires utils::constants::check::IsPowerOfTwo<Capacity>
+size_t WorkStealingQueue<TaskT, Capacity>::size() const noexcept {
+    auto top = state_.load_top(std::memory_order::relaxed);
+    auto bt = state_.load_bottom(std::memory_order::relaxed);
+
+    /* the owner may be in the middle of a pop (bottom is decremented first) */
+    auto size = static_cast<int64_t>(bt - top);
+    return size > 0 ? static_cast<size_t>(size) : 0;
+}
+
 template <task::Task TaskT, size_t Capacity>
     requires utils::constants::check::IsPowerOfTwo<Capacity>
 auto WorkStealingQueue<TaskT, Capacity>::create_stealer() noexcept -> StealHandle<TaskT, Capacity> {
     ///
-    return StealHandle<TaskT, Capacity>(state_);
+    return StealHandle<TaskT, Capacity>(&state_);
     ///
 }
 
 template <task::Task TaskT, size_t Capacity>
     requires utils::constants::check::IsPowerOfTwo<Capacity>
-auto WorkStealingQueue<TaskT, Capacity>::offload_half() noexcept -> std::optional<Batch> {
+auto WorkStealingQueue<TaskT, Capacity>::offload_half(size_t* offloaded) noexcept -> std::optional<Batch> {
 
     IntrusiveList<TaskT> batch;
 
@@ -171,9 +190,12 @@ auto WorkStealingQueue<TaskT, Capacity>::offload_half() noexcept -> std::optiona
     /* [top; top + count) */
     for (auto i = top; i < top + offload_count; ++i) {
         auto task = state_.load_task(i);
-        batch.PushBack(task);
+        batch.push_back(*task);
     }
 
+    if (offloaded != nullptr) {
+        *offloaded = offload_count;
+    }
     return batch;
 }
 
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "format.hpp"
+
+namespace wr::record {
+
+inline constexpr size_t kRoot = std::numeric_limits<size_t>::max();
+
+/* A task of the recording: who spawned it, when, and for how long it ran. Times are in ns. */
+struct Node {
+    size_t parent = kRoot;  // the node whose run submitted this one; kRoot => from outside of the pool
+    uint64_t offset = 0;    // submit: since the start of the parent's run (roots: since the first event)
+    uint64_t duration = 0;  // of the run
+    uint64_t wait = 0;      // recorded: from the submit to the start of the run
+    uint16_t worker = 0;    // recorded: ran on
+};
+
+/* The spawn tree of a recording: nodes in the order their runs started => a parent comes before its children */
+struct Dag {
+    std::vector<Node> nodes;
+    uint64_t makespan = 0;  // recorded: from the first event to the end of the last run, ns
+};
+
+/*
+ * @brief Rebuild the spawn tree of a recording.
+ *
+ *  >> a run is matched with the oldest pending submit of the same task pointer (pointers are reused only
+ *     after a task is done; a task which resubmits itself submits after its own start)
+ *  >> the parent of a submit is the innermost run in progress on the submitting worker at that moment (runs
+ *     nest when a task helps while it waits, `WsExecutor::submit_bounded`); external submits, timers,
+ *     I/O readiness (submitted between runs) are roots
+ *  >> a run without a recorded submit (started before the recording) is a root submitted at its start
+ */
+Dag build_dag(const Recording& recording);
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline Dag build_dag(const Recording& recording) {
+    struct Pending {
+        uint64_t tsc;
+        size_t parent;
+    };
+    struct Current {
+        size_t node = kRoot;
+        uint64_t end = 0;  // exclusive; saturated durations cover the rest of the recording
+    };
+
+    Dag dag;
+    if (recording.events.empty()) {
+        return dag;
+    }
+
+    const double ns = recording.ns_per_cycle;
+    const auto to_ns = [ns](uint64_t cycles) {
+        return static_cast<uint64_t>(static_cast<double>(cycles) * ns);
+    };
+    const uint64_t origin = recording.events.front().tsc;
+
+    std::unordered_map<uint64_t, std::deque<Pending>> pending;
+    std::vector<std::vector<Current>> running(recording.workers);  // per worker, the innermost run on top
+    std::vector<uint64_t> starts;  // tsc of the start of every node
+    uint64_t last_end = origin;
+
+    // the runs of the worker which are still in progress at `tsc`
+    const auto in_progress = [&running](uint16_t worker, uint64_t tsc) -> std::vector<Current>* {
+        if (worker >= running.size()) {
+            return nullptr;
+        }
+        auto& stack = running[worker];
+        while (!stack.empty() && stack.back().end <= tsc) {
+            stack.pop_back();
+        }
+        return &stack;
+    };
+
+    for (const Event& event : recording.events) {
+        if (event.kind == kSubmit) {
+            size_t parent = kRoot;
+            if (auto* stack = in_progress(event.worker, event.tsc); stack != nullptr && !stack->empty()) {
+                parent = stack->back().node;
+            }
+            pending[event.task].push_back(Pending{event.tsc, parent});
+            continue;
+        }
+
+        Node node;
+        node.duration = to_ns(event.duration);
+        node.worker = event.worker;
+
+        Pending submit{event.tsc, kRoot};
+        auto it = pending.find(event.task);
+        if (it != pending.end() && !it->second.empty()) {
+            submit = it->second.front();
+            it->second.pop_front();
+            if (it->second.empty()) {
+                pending.erase(it);
+            }
+        }
+
+        node.parent = submit.parent;
+        node.wait = to_ns(event.tsc - submit.tsc);
+        node.offset = submit.parent == kRoot ? to_ns(submit.tsc - origin) : to_ns(submit.tsc - starts[submit.parent]);
+
+        const uint64_t end = event.duration == kSaturated ? std::numeric_limits<uint64_t>::max()
+                                                          : event.tsc + event.duration;
+        if (auto* stack = in_progress(event.worker, event.tsc); stack != nullptr) {
+            stack->push_back(Current{dag.nodes.size(), end});
+        }
+        last_end = std::max(last_end, event.tsc + event.duration);
+
+        starts.push_back(event.tsc);
+        dag.nodes.push_back(node);
+    }
+
+    dag.makespan = to_ns(last_end - origin);
+    return dag;
+}
+
+}  // namespace wr::record
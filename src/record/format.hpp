@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "recorder.hpp"
+
+namespace wr::record {
+
+/*
+ * File of a recording: a header, then the events of all writers sorted by `tsc`.
+ * Native byte order and layout (`Event` is 24 bytes without padding): read it on the same kind of machine.
+ */
+struct FileHeader {
+    char magic[8] = {'W', 'R', '-', 'R', 'E', 'C', 'O', 'R'};
+    uint32_t version = 1;
+    uint32_t workers = 0;
+    double ns_per_cycle = 1.0;
+    uint64_t events = 0;
+};
+
+struct Recording {
+    uint32_t workers = 0;
+    double ns_per_cycle = 1.0;
+    std::vector<Event> events;  // sorted by `tsc`
+};
+
+/* sorts `events` and writes the file */
+void write(std::ostream& out, uint32_t workers, double ns_per_cycle, std::vector<Event> events);
+
+/* throws std::runtime_error on a file which is not a recording (or of another version) */
+Recording read(std::istream& in);
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline void write(std::ostream& out, uint32_t workers, double ns_per_cycle, std::vector<Event> events) {
+    // submit before run at the same tick: a task cannot start before it is submitted
+    std::stable_sort(events.begin(), events.end(), [](const Event& lhs, const Event& rhs) {
+        return lhs.tsc != rhs.tsc ? lhs.tsc < rhs.tsc : lhs.kind < rhs.kind;
+    });
+
+    FileHeader header;
+    header.workers = workers;
+    header.ns_per_cycle = ns_per_cycle;
+    header.events = events.size();
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(events.data()), static_cast<std::streamsize>(events.size() * sizeof(Event)));
+}
+
+inline Recording read(std::istream& in) {
+    FileHeader header;
+    const FileHeader expected;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("wr::record: not a recording");
+    }
+    if (header.version != expected.version) {
+        throw std::runtime_error("wr::record: unsupported version");
+    }
+
+    Recording recording;
+    recording.workers = header.workers;
+    recording.ns_per_cycle = header.ns_per_cycle;
+    recording.events.resize(header.events);
+    in.read(reinterpret_cast<char*>(recording.events.data()),
+            static_cast<std::streamsize>(header.events * sizeof(Event)));
+    if (!in) {
+        throw std::runtime_error("wr::record: truncated recording");
+    }
+    return recording;
+}
+
+}  // namespace wr::record
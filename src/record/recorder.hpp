@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "../utils/tsc.hpp"
+
+namespace wr::record {
+
+enum EventKind : uint8_t {
+    kSubmit = 0,  // the task entered the executor: `tsc` is the moment
+    kRun = 1,     // the task ran on `worker`: `tsc` is the start, `duration` the length
+};
+
+inline constexpr uint16_t kExternal = std::numeric_limits<uint16_t>::max();  // submitted outside of the pool
+inline constexpr uint32_t kSaturated = std::numeric_limits<uint32_t>::max();  // longer than 2^32 cycles
+
+/* One record of the log, 24 bytes. The task pointer identifies a task from its submit to its run
+ * (pointers are reused once a task is done: see `dag.hpp`) */
+struct Event {
+    uint64_t tsc = 0;
+    uint64_t task = 0;
+    uint32_t duration = 0;  // TSC cycles, saturated at kSaturated (~1 s)
+    uint16_t worker = kExternal;
+    uint8_t kind = kSubmit;
+    uint8_t reserved = 0;
+};
+
+static_assert(sizeof(Event) == 24);
+
+/**
+ * @brief Append-only log of one writer (`Config::kEnableRecording`): a worker's submits and runs, or the
+ * external submits of an executor (under its lock).
+ *
+ *  >> chunks of kChunkEvents: an append is a store and an increment, a new chunk every 4096 events
+ *     (no reallocation, no copy of what is already recorded)
+ *  >> unbounded: recording is meant for a session, not for a service which runs for days
+ *  >> read only after the writer has stopped (`WsExecutor::record_to` writes the file at shutdown)
+ *
+ *  Disabled => an empty type with no-op members.
+ */
+template <bool Enabled>
+class Recorder;
+
+template <>
+class Recorder<true> {
+  public:  // nested types:
+    static constexpr size_t kChunkEvents = 4096;
+
+  private:  // data members:
+    std::vector<std::unique_ptr<Event[]>> chunks_;
+    size_t used_ = kChunkEvents;  // in the last chunk
+
+  public:  // member functions:
+    void submitted(const void* task, uint16_t worker);
+
+    uint64_t begin() const noexcept;
+    void ran(const void* task, uint16_t worker, uint64_t started_at);
+
+    size_t size() const noexcept;
+
+    void append_to(std::vector<Event>& events) const;
+
+  private:  // member functions:
+    void append(const Event& event);
+};
+
+template <>
+class Recorder<false> {
+  public:  // member functions:
+    void submitted(const void*, uint16_t) noexcept {}
+
+    uint64_t begin() const noexcept {
+        return 0;
+    }
+    void ran(const void*, uint16_t, uint64_t) noexcept {}
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline void Recorder<true>::submitted(const void* task, uint16_t worker) {
+    ///
+    append(Event{utils::tsc::now(), reinterpret_cast<uintptr_t>(task), 0, worker, kSubmit, 0});
+    ///
+}
+
+inline uint64_t Recorder<true>::begin() const noexcept {
+    ///
+    return utils::tsc::now();
+    ///
+}
+
+inline void Recorder<true>::ran(const void* task, uint16_t worker, uint64_t started_at) {
+    const uint64_t cycles = utils::tsc::now() - started_at;
+    const auto duration = static_cast<uint32_t>(std::min<uint64_t>(cycles, kSaturated));
+    append(Event{started_at, reinterpret_cast<uintptr_t>(task), duration, worker, kRun, 0});
+}
+
+inline size_t Recorder<true>::size() const noexcept {
+    ///
+    return chunks_.empty() ? 0 : (chunks_.size() - 1) * kChunkEvents + used_;
+    ///
+}
+
+inline void Recorder<true>::append_to(std::vector<Event>& events) const {
+    for (size_t chunk = 0; chunk < chunks_.size(); ++chunk) {
+        const size_t count = chunk + 1 == chunks_.size() ? used_ : kChunkEvents;
+        events.insert(events.end(), chunks_[chunk].get(), chunks_[chunk].get() + count);
+    }
+}
+
+inline void Recorder<true>::append(const Event& event) {
+    if (used_ == kChunkEvents) {
+        chunks_.push_back(std::make_unique_for_overwrite<Event[]>(kChunkEvents));
+        used_ = 0;
+    }
+    chunks_.back()[used_++] = event;
+}
+
+}  // namespace wr::record
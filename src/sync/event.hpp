@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <utility>
+
+#include "waiter.hpp"
+
+namespace wr {
+
+/**
+ * @brief Manual-reset event for tasks: waiters are parked as intrusive nodes, `set()` submits all of them.
+ *
+ *  The state is one word:
+ *
+ *  >> kNotSet (nullptr)    => not set, nobody waits
+ *  >> kSet                 => set: waiters pass through
+ *  >> pointer to a Waiter  => not set, head of the (LIFO) stack of the waiters
+ *
+ *  >> wait:  push the waiter with a CAS unless the event is set
+ *  >> set:   exchange with kSet and submit everything that was taken (in arrival order)
+ *
+ * Usage:
+ *  >> coroutine:   co_await event.wait();
+ *  >> callbacks:   if (event.wait_or_enqueue(&waiter)) { ... }  // else `waiter` is submitted by `set()`
+ */
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+class Event {
+  public:  // nested types:
+    using TaskT = typename Executor::TaskT;
+    using WaiterT = Waiter<TaskT>;
+
+    class WaitAwaiter : public detail::CoroutineWaiter<TaskT> {
+      private:  // data members:
+        Event* event_;
+
+      public:  // member functions:
+        explicit WaitAwaiter(Event* event) noexcept : event_(event) {}
+
+        bool await_ready() noexcept;
+        bool await_suspend(std::coroutine_handle<> handle) noexcept;
+        void await_resume() noexcept {}
+    };
+
+  private:  // nested types:
+    static constexpr uintptr_t kNotSet = 0;
+    static constexpr uintptr_t kSet = 1;
+
+  private:  // data members:
+    Executor* host_;
+
+    std::atomic<uintptr_t> state_ = kNotSet;
+
+  public:  // member functions:
+    explicit Event(Executor* host) noexcept : host_(host) {}
+
+    Event(const Event&) = delete;
+    Event& operator=(const Event&) = delete;
+    Event(Event&&) = delete;
+    Event& operator=(Event&&) = delete;
+
+    /*
+     * @brief Set the event and submit all the waiters. [any thread]
+     */
+    void set() noexcept;
+
+    /*
+     * @brief Clear the event if it is set; waiters which arrive later wait for the next `set()`.
+     */
+    void reset() noexcept;
+
+    bool is_set() const noexcept;
+
+    /*
+     * @brief True if the event is set (`waiter` is not used), otherwise `waiter` is enqueued
+     * and submitted by the next `set()`.
+     */
+    bool wait_or_enqueue(WaiterT* waiter) noexcept;
+
+    [[nodiscard]] WaitAwaiter wait() noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void Event<Executor>::set() noexcept {
+    auto state = state_.exchange(kSet, std::memory_order::acq_rel);
+    if (state == kSet) {
+        return;
+    }
+
+    // stack is LIFO => reverse it, so that the waiters are submitted in arrival order
+    WaiterT* fifo = nullptr;
+    for (WaiterT* stack = detail::waiter_of<TaskT>(state); stack != nullptr;) {
+        WaiterT* next = stack->next_;
+        stack->next_ = fifo;
+        fifo = stack;
+        stack = next;
+    }
+
+    while (fifo != nullptr) {
+        // a waiter may be gone as soon as it is submitted => unlink first
+        WaiterT* waiter = std::exchange(fifo, fifo->next_);
+        host_->submit(waiter);
+    }
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void Event<Executor>::reset() noexcept {
+    uintptr_t expected = kSet;
+    state_.compare_exchange_strong(expected, kNotSet, std::memory_order::relaxed);
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool Event<Executor>::is_set() const noexcept {
+    ///
+    return state_.load(std::memory_order::acquire) == kSet;
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool Event<Executor>::wait_or_enqueue(WaiterT* waiter) noexcept {
+    auto state = state_.load(std::memory_order::acquire);
+
+    while (state != kSet) {
+        waiter->next_ = detail::waiter_of<TaskT>(state);  // kNotSet => nullptr
+        if (state_.compare_exchange_weak(state, detail::state_of(waiter), std::memory_order::release,
+                                         std::memory_order::acquire)) {
+            return false;
+        }
+        /* `state` is refreshed by the failed CAS */
+    }
+    return true;
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+auto Event<Executor>::wait() noexcept -> WaitAwaiter {
+    ///
+    return WaitAwaiter(this);
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool Event<Executor>::WaitAwaiter::await_ready() noexcept {
+    ///
+    return event_->is_set();
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool Event<Executor>::WaitAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept {
+    this->handle_ = handle;
+    // set meanwhile => do not suspend
+    return !event_->wait_or_enqueue(this);
+}
+
+}  // namespace wr
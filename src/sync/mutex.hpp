@@ -0,0 +1,187 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <cstdint>
+#include <utility>
+
+#include "waiter.hpp"
+
+namespace wr {
+
+/**
+ * @brief Mutex for tasks: a contender does not block its worker, it leaves a waiter and returns.
+ *
+ * @section DESIGN
+ *
+ *  All the state is one word:
+ *
+ *  >> kUnlocked            => free
+ *  >> kLocked              => taken, nobody waits
+ *  >> pointer to a Waiter  => taken, head of the (LIFO) stack of the waiters
+ *
+ *  >> lock:   CAS kUnlocked -> kLocked, or push the waiter onto the stack (CAS)
+ *  >> unlock: CAS kLocked -> kUnlocked; if it fails, the holder takes the whole stack (exchange),
+ *             reverses it into the private FIFO `ready_` and hands the mutex over to its first waiter
+ *             by submitting it. `ready_` is passed along with the ownership => no lock around it.
+ *
+ *  Handoff: the next owner is submitted from the releasing task, i.e. to the releaser's lifo slot, so it
+ *  is the very next task of this worker and finds the protected data hot in the cache.
+ *
+ * Usage:
+ *  >> coroutine:   co_await mutex.lock(); ...; mutex.unlock();
+ *  >> callbacks:   if (mutex.lock_or_wait(&waiter)) { ...; mutex.unlock(); }  // else `waiter` runs as the owner
+ */
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+class AsyncMutex {
+  public:  // nested types:
+    using TaskT = typename Executor::TaskT;
+    using WaiterT = Waiter<TaskT>;
+
+    class LockAwaiter : public detail::CoroutineWaiter<TaskT> {
+      private:  // data members:
+        AsyncMutex* mutex_;
+
+      public:  // member functions:
+        explicit LockAwaiter(AsyncMutex* mutex) noexcept : mutex_(mutex) {}
+
+        bool await_ready() noexcept;
+        bool await_suspend(std::coroutine_handle<> handle) noexcept;
+        void await_resume() noexcept {}
+    };
+
+  private:  // nested types:
+    static constexpr uintptr_t kUnlocked = 0;
+    static constexpr uintptr_t kLocked = 1;
+
+  private:  // data members:
+    Executor* host_;
+
+    std::atomic<uintptr_t> state_ = kUnlocked;
+
+    /* waiters taken from the stack, in FIFO order. Owner only */
+    WaiterT* ready_ = nullptr;
+
+  public:  // member functions:
+    explicit AsyncMutex(Executor* host) noexcept : host_(host) {}
+    ~AsyncMutex();
+
+    AsyncMutex(const AsyncMutex&) = delete;
+    AsyncMutex& operator=(const AsyncMutex&) = delete;
+    AsyncMutex(AsyncMutex&&) = delete;
+    AsyncMutex& operator=(AsyncMutex&&) = delete;
+
+    bool try_lock() noexcept;
+
+    /*
+     * @brief Acquire the mutex now (true, `waiter` is not used) or enqueue `waiter` (false):
+     * it is submitted to the executor when the mutex is handed over to it.
+     */
+    bool lock_or_wait(WaiterT* waiter) noexcept;
+
+    [[nodiscard]] LockAwaiter lock() noexcept;
+
+    void unlock() noexcept;
+
+  private:  // member functions:
+    static WaiterT* reverse(WaiterT* stack) noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+AsyncMutex<Executor>::~AsyncMutex() {
+    ///
+    assert(state_.load(std::memory_order::relaxed) == kUnlocked && "mutex is destroyed while taken");
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool AsyncMutex<Executor>::try_lock() noexcept {
+    uintptr_t expected = kUnlocked;
+    return state_.compare_exchange_strong(expected, kLocked, std::memory_order::acquire, std::memory_order::relaxed);
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool AsyncMutex<Executor>::lock_or_wait(WaiterT* waiter) noexcept {
+    auto state = state_.load(std::memory_order::relaxed);
+
+    while (true) {
+        if (state == kUnlocked) {
+            if (state_.compare_exchange_weak(state, kLocked, std::memory_order::acquire, std::memory_order::relaxed)) {
+                return true;
+            }
+            continue;
+        }
+
+        waiter->next_ = state == kLocked ? nullptr : detail::waiter_of<TaskT>(state);
+        if (state_.compare_exchange_weak(state, detail::state_of(waiter), std::memory_order::release,
+                                         std::memory_order::relaxed)) {
+            return false;
+        }
+        /* `state` is refreshed by the failed CAS */
+    }
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+auto AsyncMutex<Executor>::lock() noexcept -> LockAwaiter {
+    ///
+    return LockAwaiter(this);
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void AsyncMutex<Executor>::unlock() noexcept {
+    if (ready_ == nullptr) {
+        uintptr_t expected = kLocked;
+        if (state_.compare_exchange_strong(expected, kUnlocked, std::memory_order::release,
+                                           std::memory_order::relaxed)) {
+            return;
+        }
+
+        // somebody waits: take them all, the mutex stays taken (it is handed over below)
+        ready_ = reverse(detail::waiter_of<TaskT>(state_.exchange(kLocked, std::memory_order::acquire)));
+    }
+
+    // `ready_` belongs to the next owner as soon as it is submitted => unlink first
+    WaiterT* next = std::exchange(ready_, ready_->next_);
+    host_->submit(next);
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+auto AsyncMutex<Executor>::reverse(WaiterT* stack) noexcept -> WaiterT* {
+    WaiterT* fifo = nullptr;
+    while (stack != nullptr) {
+        WaiterT* next = stack->next_;
+        stack->next_ = fifo;
+        fifo = stack;
+        stack = next;
+    }
+    return fifo;
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool AsyncMutex<Executor>::LockAwaiter::await_ready() noexcept {
+    ///
+    return mutex_->try_lock();
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool AsyncMutex<Executor>::LockAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept {
+    this->handle_ = handle;
+    // acquired meanwhile => do not suspend
+    return !mutex_->lock_or_wait(this);
+}
+
+}  // namespace wr
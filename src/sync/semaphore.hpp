@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#include "waiter.hpp"
+
+namespace wr {
+
+/**
+ * @brief Counting semaphore for tasks: a task which finds no permits leaves a waiter instead of blocking.
+ *
+ *  >> permits and the FIFO of waiters are guarded by a short internal lock, which is never held
+ *     while anything runs (waiters are submitted after it is released)
+ *  >> `release(n)` hands permits directly to up to `n` waiters (no barging: a fresh `acquire`
+ *     cannot overtake a queued waiter), the rest is added to the counter
+ *
+ * Usage:
+ *  >> coroutine:   co_await semaphore.acquire(); ...; semaphore.release();
+ *  >> callbacks:   if (semaphore.acquire_or_wait(&waiter)) { ... }  // else `waiter` runs owning a permit
+ */
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+class AsyncSemaphore {
+  public:  // nested types:
+    using TaskT = typename Executor::TaskT;
+    using WaiterT = Waiter<TaskT>;
+
+    class AcquireAwaiter : public detail::CoroutineWaiter<TaskT> {
+      private:  // data members:
+        AsyncSemaphore* semaphore_;
+
+      public:  // member functions:
+        explicit AcquireAwaiter(AsyncSemaphore* semaphore) noexcept : semaphore_(semaphore) {}
+
+        bool await_ready() noexcept;
+        bool await_suspend(std::coroutine_handle<> handle) noexcept;
+        void await_resume() noexcept {}
+    };
+
+  private:  // data members:
+    Executor* host_;
+
+    std::mutex mutex_;
+    size_t permits_;
+
+    /* FIFO of the waiters */
+    WaiterT* head_ = nullptr;
+    WaiterT* tail_ = nullptr;
+
+  public:  // member functions:
+    AsyncSemaphore(Executor* host, size_t permits) noexcept : host_(host), permits_(permits) {}
+    ~AsyncSemaphore();
+
+    AsyncSemaphore(const AsyncSemaphore&) = delete;
+    AsyncSemaphore& operator=(const AsyncSemaphore&) = delete;
+    AsyncSemaphore(AsyncSemaphore&&) = delete;
+    AsyncSemaphore& operator=(AsyncSemaphore&&) = delete;
+
+    bool try_acquire() noexcept;
+
+    /*
+     * @brief Take a permit now (true, `waiter` is not used) or enqueue `waiter` (false):
+     * it is submitted to the executor when a permit is handed over to it.
+     */
+    bool acquire_or_wait(WaiterT* waiter) noexcept;
+
+    [[nodiscard]] AcquireAwaiter acquire() noexcept;
+
+    void release(size_t count = 1) noexcept;
+
+    size_t available() noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+AsyncSemaphore<Executor>::~AsyncSemaphore() {
+    ///
+    assert(head_ == nullptr && "semaphore is destroyed with waiters");
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool AsyncSemaphore<Executor>::try_acquire() noexcept {
+    std::lock_guard lock(mutex_);
+
+    if (permits_ == 0) {
+        return false;
+    }
+    --permits_;
+    return true;
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool AsyncSemaphore<Executor>::acquire_or_wait(WaiterT* waiter) noexcept {
+    std::lock_guard lock(mutex_);
+
+    if (permits_ > 0) {
+        --permits_;
+        return true;
+    }
+
+    waiter->next_ = nullptr;
+    if (tail_ == nullptr) {
+        head_ = waiter;
+    } else {
+        tail_->next_ = waiter;
+    }
+    tail_ = waiter;
+    return false;
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+auto AsyncSemaphore<Executor>::acquire() noexcept -> AcquireAwaiter {
+    ///
+    return AcquireAwaiter(this);
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void AsyncSemaphore<Executor>::release(size_t count) noexcept {
+    WaiterT* woken = nullptr;
+
+    {
+        std::lock_guard lock(mutex_);
+
+        // permits go to the queued waiters first: detach up to `count` of them from the head
+        WaiterT* last = nullptr;
+        for (WaiterT* waiter = head_; count > 0 && waiter != nullptr; waiter = waiter->next_, --count) {
+            last = waiter;
+        }
+        if (last != nullptr) {
+            woken = std::exchange(head_, last->next_);
+            last->next_ = nullptr;
+            if (head_ == nullptr) {
+                tail_ = nullptr;
+            }
+        }
+
+        permits_ += count;
+    }
+
+    // submitted outside of the lock: the waiters may run (and release) right away
+    while (woken != nullptr) {
+        WaiterT* waiter = std::exchange(woken, woken->next_);
+        host_->submit(waiter);
+    }
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+size_t AsyncSemaphore<Executor>::available() noexcept {
+    std::lock_guard lock(mutex_);
+    return permits_;
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool AsyncSemaphore<Executor>::AcquireAwaiter::await_ready() noexcept {
+    ///
+    return semaphore_->try_acquire();
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool AsyncSemaphore<Executor>::AcquireAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept {
+    this->handle_ = handle;
+    // a permit was released meanwhile => do not suspend
+    return !semaphore_->acquire_or_wait(this);
+}
+
+}  // namespace wr
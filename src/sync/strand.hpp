@@ -0,0 +1,287 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/block_pool.hpp"
+#include "../tasks/concept.hpp"
+
+namespace wr {
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+class Strand;
+
+/* Message of a strand: a plain link + trampoline (compare with `TaskBase`).
+ * >> `next_` links the strand's lock-free incoming stack
+ * >> user-owned messages derive from it and pass their trampoline, callables are posted as closures */
+class StrandTask {
+  public:  // nested types:
+    using RunFn = void (*)(StrandTask*) noexcept;
+
+  private:  // data members:
+    StrandTask* next_ = nullptr;
+    RunFn run_fn_;
+
+  public:  // friendship declaration:
+    template <typename Executor>
+        requires task::TrampolineTask<typename Executor::TaskT>
+    friend class Strand;
+
+  public:  // member functions:
+    explicit StrandTask(RunFn run_fn) noexcept : run_fn_(run_fn) {}
+
+    void run() noexcept;
+};
+
+namespace detail {
+
+/* Callable posted to a strand, stored like a closure task of the strand's executor
+ * (see `tasks/closure.hpp`) */
+template <typename Fun>
+class StrandClosure : public StrandTask {
+  private:  // data members:
+    Fun fun_;
+
+  public:  // member functions:
+    explicit StrandClosure(Fun&& fun) : StrandTask(&StrandClosure::trampoline), fun_(std::move(fun)) {}
+    explicit StrandClosure(const Fun& fun) : StrandTask(&StrandClosure::trampoline), fun_(fun) {}
+
+    StrandClosure(const StrandClosure&) = delete;
+    StrandClosure& operator=(const StrandClosure&) = delete;
+    StrandClosure(StrandClosure&&) = delete;
+    StrandClosure& operator=(StrandClosure&&) = delete;
+
+  private:  // member functions:
+    static void trampoline(StrandTask* self) noexcept;
+};
+
+}  // namespace detail
+
+/* ---------------------------------- */
+
+/**
+ * @brief Serial execution context on top of an executor: posted messages run one at a time, in FIFO
+ * order (per producer), without locks and without blocking workers.
+ *
+ * @section DESIGN
+ *
+ *  The strand IS a task of the executor. All its state lives in one atomic word:
+ *
+ *  | top of the incoming stack (StrandTask*) | scheduled bit |
+ *
+ *  >> post():   push onto the stack and set the bit with one CAS; whoever sets the bit submits the strand
+ *  >> run():    takes the whole stack at once (exchange), reverses it into the private FIFO `ready_`,
+ *               runs up to `budget` messages, then
+ *                  - defers itself if there is work left: back to the injection queue, behind the tasks
+ *                    queued meanwhile (a plain submit from the worker would land in its LIFO slot), or
+ *                  - clears the bit with a CAS, which fails if something was posted meanwhile
+ *
+ *  => at most one run of a strand is in flight, memory per strand is O(1) and a posted message never
+ *     waits for a lock: millions of strands cost millions of words, not millions of mutexes.
+ *
+ *  The successful "clear" CAS is the last access of the runner to the strand: after `idle()` returns
+ *  true (and nobody posts) the strand may be destroyed.
+ */
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+class Strand : private Executor::TaskT {
+  public:  // nested types:
+    using TaskT = typename Executor::TaskT;
+
+    static constexpr size_t kDefaultBudget = 64;
+
+  private:  // nested types:
+    static constexpr uintptr_t kScheduled = 1;
+
+    static_assert(alignof(StrandTask) > kScheduled, "low bit of the message address is used as the flag");
+
+  private:  // data members:
+    Executor* host_;
+    const size_t budget_;
+
+    /* incoming stack (LIFO) | scheduled bit. Modified by producers and by the runner */
+    std::atomic<uintptr_t> state_ = 0;
+
+    /* messages taken from the stack, in FIFO order. Runner only */
+    StrandTask* ready_ = nullptr;
+
+  public:  // member functions:
+    explicit Strand(Executor* host, size_t budget = kDefaultBudget) noexcept;
+    ~Strand();
+
+    Strand(const Strand&) = delete;
+    Strand& operator=(const Strand&) = delete;
+    Strand(Strand&&) = delete;
+    Strand& operator=(Strand&&) = delete;
+
+    /*
+     * @brief Enqueue a message. [any thread, including the strand's own messages]
+     */
+    void post(StrandTask* task) noexcept;
+
+    template <typename F>
+        requires std::invocable<std::decay_t<F>&> && (!std::is_convertible_v<F, StrandTask*>)
+    void post(F&& fun);
+
+    /*
+     * @brief True if the strand has no pending messages and is not scheduled.
+     */
+    bool idle() const noexcept;
+
+  private:  // member functions:
+    static void trampoline(TaskT* self) noexcept;
+
+    void drain() noexcept;
+
+    // moves the incoming stack to `ready_`, false if it is empty
+    bool take_incoming() noexcept;
+
+    // clears the scheduled bit if nothing was posted, false otherwise
+    bool try_release() noexcept;
+
+    static StrandTask* top_of(uintptr_t state) noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline void StrandTask::run() noexcept {
+    ///
+    run_fn_(this);
+    ///
+}
+
+template <typename Fun>
+void detail::StrandClosure<Fun>::trampoline(StrandTask* self) noexcept {
+    auto* closure = static_cast<StrandClosure*>(self);
+
+    closure->fun_();
+
+    closure->~StrandClosure();
+    memory::BlockPool::deallocate(closure);
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+Strand<Executor>::Strand(Executor* host, size_t budget) noexcept
+    : TaskT(&Strand::trampoline), host_(host), budget_(budget) {
+    assert(budget_ > 0);
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+Strand<Executor>::~Strand() {
+    ///
+    assert(idle() && "strand is destroyed with pending messages");
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void Strand<Executor>::post(StrandTask* task) noexcept {
+    auto state = state_.load(std::memory_order::relaxed);
+    do {
+        task->next_ = top_of(state);
+    } while (!state_.compare_exchange_weak(state, reinterpret_cast<uintptr_t>(task) | kScheduled,
+                                           std::memory_order::acq_rel, std::memory_order::relaxed));
+
+    // the bit was clear => the strand is neither queued nor running, it is ours to submit
+    if ((state & kScheduled) == 0) {
+        host_->submit(this);
+    }
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+template <typename F>
+    requires std::invocable<std::decay_t<F>&> && (!std::is_convertible_v<F, StrandTask*>)
+void Strand<Executor>::post(F&& fun) {
+    using Closure = detail::StrandClosure<std::decay_t<F>>;
+    static_assert(alignof(Closure) <= memory::BlockPool::kHeaderSize, "over-aligned closures are not supported");
+
+    void* memory = memory::BlockPool::allocate_in(host_->closure_pool(), sizeof(Closure));
+    post(::new (memory) Closure(std::forward<F>(fun)));
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool Strand<Executor>::idle() const noexcept {
+    ///
+    return state_.load(std::memory_order::acquire) == 0;
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void Strand<Executor>::trampoline(TaskT* self) noexcept {
+    ///
+    static_cast<Strand*>(self)->drain();
+    ///
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+void Strand<Executor>::drain() noexcept {
+    for (size_t budget = budget_; budget > 0;) {
+        if (ready_ == nullptr && !take_incoming()) {
+            if (try_release()) {
+                return;  // `this` must not be touched anymore
+            }
+            continue;  // raced with a post
+        }
+
+        // messages may free themselves (closures) => unlink first
+        StrandTask* task = std::exchange(ready_, ready_->next_);
+        task->run();
+        --budget;
+    }
+
+    if (ready_ == nullptr && !take_incoming() && try_release()) {
+        return;
+    }
+
+    // budget is exhausted: yield the worker to other tasks, the bit stays set
+    host_->defer(this);
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool Strand<Executor>::take_incoming() noexcept {
+    if (state_.load(std::memory_order::relaxed) == kScheduled) {
+        return false;
+    }
+
+    StrandTask* stack = top_of(state_.exchange(kScheduled, std::memory_order::acquire));
+
+    // stack is LIFO => reverse it into FIFO order
+    while (stack != nullptr) {
+        StrandTask* next = stack->next_;
+        stack->next_ = ready_;
+        ready_ = stack;
+        stack = next;
+    }
+    return ready_ != nullptr;
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+bool Strand<Executor>::try_release() noexcept {
+    uintptr_t expected = kScheduled;
+    return state_.compare_exchange_strong(expected, 0, std::memory_order::release, std::memory_order::relaxed);
+}
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+StrandTask* Strand<Executor>::top_of(uintptr_t state) noexcept {
+    ///
+    return reinterpret_cast<StrandTask*>(state & ~kScheduled);
+    ///
+}
+
+}  // namespace wr
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+
+#include "../tasks/concept.hpp"
+
+namespace wr {
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+class AsyncMutex;
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+class Event;
+
+template <typename Executor>
+    requires task::TrampolineTask<typename Executor::TaskT>
+class AsyncSemaphore;
+
+/* Waiter of the async primitives: an executor task + one more link.
+ *
+ *  >> while it waits, it sits in the primitive's own list (`next_`)
+ *  >> when its turn comes, the releaser submits it to the executor as an ordinary task:
+ *     from a worker it lands in the releaser's lifo slot => the handoff stays on the same core
+ *
+ * Waiters are never allocated by the primitives: they live in the caller's storage
+ * (a coroutine frame for `co_await`, or any user-owned object). */
+template <task::TrampolineTask TaskT>
+class Waiter : public TaskT {
+  private:  // data members:
+    Waiter* next_ = nullptr;
+
+  public:  // friendship declaration:
+    template <typename Executor>
+        requires task::TrampolineTask<typename Executor::TaskT>
+    friend class AsyncMutex;
+
+    template <typename Executor>
+        requires task::TrampolineTask<typename Executor::TaskT>
+    friend class Event;
+
+    template <typename Executor>
+        requires task::TrampolineTask<typename Executor::TaskT>
+    friend class AsyncSemaphore;
+
+  public:  // member functions:
+    explicit Waiter(void (*run_fn)(TaskT*) noexcept) noexcept : TaskT(run_fn) {}
+
+    Waiter(const Waiter&) = delete;
+    Waiter& operator=(const Waiter&) = delete;
+    Waiter(Waiter&&) = delete;
+    Waiter& operator=(Waiter&&) = delete;
+};
+
+namespace detail {
+
+/* Waiter which resumes a suspended coroutine: base of the primitives' awaiters.
+ * >> lives in the coroutine frame, so it may be destroyed by `resume()` - not touched after it */
+template <task::TrampolineTask TaskT>
+class CoroutineWaiter : public Waiter<TaskT> {
+  protected:  // data members:
+    std::coroutine_handle<> handle_;
+
+  public:  // member functions:
+    CoroutineWaiter() noexcept : Waiter<TaskT>(&CoroutineWaiter::trampoline) {}
+
+  private:  // member functions:
+    static void trampoline(TaskT* self) noexcept;
+};
+
+/* Lock-free list heads of the primitives pack a `Waiter*` and small tags into one word */
+template <task::TrampolineTask TaskT>
+Waiter<TaskT>* waiter_of(uintptr_t state) noexcept {
+    return reinterpret_cast<Waiter<TaskT>*>(state);
+}
+
+template <task::TrampolineTask TaskT>
+uintptr_t state_of(Waiter<TaskT>* waiter) noexcept {
+    return reinterpret_cast<uintptr_t>(waiter);
+}
+
+}  // namespace detail
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <task::TrampolineTask TaskT>
+void detail::CoroutineWaiter<TaskT>::trampoline(TaskT* self) noexcept {
+    ///
+    static_cast<CoroutineWaiter*>(self)->handle_.resume();
+    ///
+}
+
+}  // namespace wr
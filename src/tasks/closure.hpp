@@ -0,0 +1,61 @@
+#pragma once
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/block_pool.hpp"
+#include "concept.hpp"
+
+namespace wr::task {
+
+/* Task which owns a callable. The closure is stored inline, right after the task header, in a block
+ * of the current worker's `BlockPool` => `submit(lambda)` does not call malloc in steady state.
+ * The block is released by the task itself after the call (possibly on another worker, in which
+ * case it travels back to the owner through the remote-free list). The executor passes the pool only
+ * to its own workers (`WsExecutor::closure_pool`): the task runs before the pool is gone.
+ *
+ * `Fun` is invoked from `run() noexcept`: an exception escaping it terminates the program. */
+template <TrampolineTask TaskT, typename Fun>
+class ClosureTask : public TaskT {
+  private:  // data members:
+    Fun fun_;
+
+  public:  // member functions:
+    explicit ClosureTask(Fun&& fun) : TaskT(&ClosureTask::trampoline), fun_(std::move(fun)) {}
+    explicit ClosureTask(const Fun& fun) : TaskT(&ClosureTask::trampoline), fun_(fun) {}
+
+    ClosureTask(const ClosureTask&) = delete;
+    ClosureTask& operator=(const ClosureTask&) = delete;
+    ClosureTask(ClosureTask&&) = delete;
+    ClosureTask& operator=(ClosureTask&&) = delete;
+
+  private:  // member functions:
+    static void trampoline(TaskT* self) noexcept;
+};
+
+/*
+ * @brief Wrap a callable into a task stored in `pool` (the current thread's one), on the heap if nullptr.
+ */
+template <TrampolineTask TaskT, typename F>
+TaskT* make_closure(F&& fun, memory::BlockPool* pool = nullptr) {
+    using Closure = ClosureTask<TaskT, std::decay_t<F>>;
+    static_assert(alignof(Closure) <= memory::BlockPool::kHeaderSize, "over-aligned closures are not supported");
+
+    void* memory = memory::BlockPool::allocate_in(pool, sizeof(Closure));
+    return ::new (memory) Closure(std::forward<F>(fun));
+}
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <TrampolineTask TaskT, typename Fun>
+void ClosureTask<TaskT, Fun>::trampoline(TaskT* self) noexcept {
+    auto* closure = static_cast<ClosureTask*>(self);
+
+    closure->fun_();
+
+    closure->~ClosureTask();
+    memory::BlockPool::deallocate(closure);
+}
+
+}  // namespace wr::task
@@ -6,8 +6,27 @@
 
 namespace wr::task {
 
+// A task is linked into the executor's queues through its ntrusive node, which belongs to the queue it is in.
+// Structures which chain tasks by themselves carry a link of their own (`StrandTask`, `Waiter`): the node
+// offers no atomic link to build a lock-free list on. The worker inbox takes any task => it stores pointers.
 template <typename T>
 concept Task = requires(T task) {
     { task.run() } noexcept -> std::same_as<void>; } && std::derived_from<T, IntrusiveListNode>;
 
+// Task which can be constructed around a "trampoline" function and calls it from `run()`.
+// Executor-side wrappers (closures, sender operations) derive from such task type.
+template <typename T>
+concept TrampolineTask = Task<T> && std::constructible_from<T, void (*)(T*) noexcept>;
+
+// Code address of the concrete task behind `task` (its trampoline, see `TaskBase::run_fn`): the watchdog
+// resolves it to a symbol. nullptr for tasks without one => their static type is the concrete one.
+template <typename T>
+const void* entry_of(const T& task) noexcept {
+    if constexpr (requires { task.run_fn(); }) {
+        return reinterpret_cast<const void*>(task.run_fn());
+    } else {
+        return nullptr;
+    }
+}
+
 }  // namespace wr::task
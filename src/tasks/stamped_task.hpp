@@ -0,0 +1,63 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+
+#include "concept.hpp"
+
+namespace wr {
+
+namespace task {
+
+// Task which carries the time it was queued at (`Config::kEnableLatency`)
+template <typename T>
+concept StampedTask = Task<T> && requires(T& task, const T& const_task, uint64_t tsc) {
+    task.set_enqueued_at(tsc);
+    { const_task.enqueued_at() } noexcept -> std::same_as<uint64_t>;
+};
+
+}  // namespace task
+
+/* Adds the enqueue timestamp (TSC, see `utils/tsc.hpp`) to a trampoline task: `WsExecutor<StampedTask<TaskBase>,
+ * Config>` measures the queue wait of every task, closures and timers included (they derive from the pool's
+ * task type).
+ *
+ * The trampoline of the derived task is kept here and called through the base one => one more indirect
+ * call per task: the price of the measurement, paid only by the pools which use it. */
+template <task::TrampolineTask TaskT>
+class StampedTask : public TaskT {
+  public:  // nested types:
+    using RunFn = void (*)(StampedTask*) noexcept;
+
+  private:  // data members:
+    RunFn run_fn_;
+    uint64_t enqueued_at_ = 0;
+
+  public:  // member functions:
+    explicit StampedTask(RunFn run_fn) noexcept : TaskT(&StampedTask::dispatch), run_fn_(run_fn) {}
+
+    void set_enqueued_at(uint64_t tsc) noexcept {
+        enqueued_at_ = tsc;
+    }
+
+    uint64_t enqueued_at() const noexcept {
+        return enqueued_at_;
+    }
+
+    RunFn run_fn() const noexcept {  // the derived task's trampoline, not `dispatch`
+        return run_fn_;
+    }
+
+  private:  // member functions:
+    static void dispatch(TaskT* self) noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <task::TrampolineTask TaskT>
+void StampedTask<TaskT>::dispatch(TaskT* self) noexcept {
+    auto* task = static_cast<StampedTask*>(self);
+    task->run_fn_(task);
+}
+
+}  // namespace wr
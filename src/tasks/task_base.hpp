@@ -0,0 +1,63 @@
+#pragma once
+
+#include <ntrusive/intrusive.hpp>
+
+#include "concept.hpp"
+
+namespace wr {
+
+/* Type-erased task: a single function pointer stored next to the intrusive node ("manual vtable").
+ *
+ *  >> one executor can run tasks of many types: `WsExecutor<TaskBase>` (the default)
+ *  >> dispatch costs one indirect call - no vtable pointer to load first, no RTTI
+ *  >> `WsExecutor<ConcreteTask>` stays the zero-cost path when a pool runs a single task type
+ *
+ * Concrete tasks either pass their own trampoline to the constructor or derive from `TypedTask<Self>`. */
+class TaskBase : public IntrusiveListNode {
+  public:  // nested types:
+    using RunFn = void (*)(TaskBase*) noexcept;
+
+  private:  // data members:
+    RunFn run_fn_;
+
+  public:  // member functions:
+    explicit TaskBase(RunFn run_fn) noexcept : run_fn_(run_fn) {}
+
+    void run() noexcept;
+
+    RunFn run_fn() const noexcept {  // the concrete task's trampoline: names it in diagnostics
+        return run_fn_;
+    }
+};
+
+static_assert(task::TrampolineTask<TaskBase>);
+static_assert(sizeof(TaskBase) == sizeof(IntrusiveListNode) + sizeof(TaskBase::RunFn));
+
+/* ---------------------------------- */
+
+/* CRTP helper: generates the trampoline to `Derived::run() noexcept`
+ * (which hides `TaskBase::run()` for callers that know the concrete type). */
+template <typename Derived>
+class TypedTask : public TaskBase {
+  public:  // member functions:
+    TypedTask() noexcept : TaskBase(&TypedTask::trampoline) {}
+
+  private:  // member functions:
+    static void trampoline(TaskBase* self) noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline void TaskBase::run() noexcept {
+    ///
+    run_fn_(this);
+    ///
+}
+
+template <typename Derived>
+void TypedTask<Derived>::trampoline(TaskBase* self) noexcept {
+    static_assert(noexcept(static_cast<Derived*>(self)->run()), "Derived::run() must be noexcept");
+    static_cast<Derived*>(self)->run();
+}
+
+}  // namespace wr
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include <ntrusive/intrusive.hpp>
+
+#include "../tasks/concept.hpp"
+#include "timer_task.hpp"
+#include "timer_wheel.hpp"
+
+namespace wr::timer {
+
+/* Shared timer wheel of an executor: the wheel + its lock + a lock-free summary for the workers.
+ *
+ *  >> `next_deadline_` lets a worker check whether anything is due without the lock (one relaxed load,
+ *     no clock read while there are no timers)
+ *  >> `poll` does not wait for the lock: if another worker is advancing the wheel, it does the job
+ *  >> deadlines are rounded up to whole ticks => a timer never fires early */
+template <task::Task TaskT>
+class TimerQueue {
+  public:  // nested types:
+    using Clock = std::chrono::steady_clock;
+    using Entry = TimerTask<TaskT>;
+    using Batch = IntrusiveList<TaskT>;
+
+    static constexpr uint64_t kNever = TimerWheel::kNever;
+
+  private:  // data members:
+    const Clock::time_point origin_;
+    const Clock::duration resolution_;
+
+    std::mutex mutex_;
+    TimerWheel wheel_;
+
+    std::atomic<uint64_t> next_deadline_ = kNever;  // may be earlier than the real one, never later
+
+  public:  // member functions:
+    explicit TimerQueue(Clock::duration resolution) noexcept;
+
+    TimerQueue(const TimerQueue&) = delete;
+    TimerQueue& operator=(const TimerQueue&) = delete;
+    TimerQueue(TimerQueue&&) = delete;
+    TimerQueue& operator=(TimerQueue&&) = delete;
+
+    /*
+     * @brief Put `entry` into the wheel. Returns its deadline in ticks, or std::nullopt if the deadline
+     * has already passed (the entry is not scheduled: run it now).
+     */
+    std::optional<uint64_t> schedule(Entry* entry, Clock::time_point deadline) noexcept;
+
+    /*
+     * @brief True if the entry was removed before it expired. O(1).
+     */
+    bool cancel(Entry* entry) noexcept;
+
+    /*
+     * @brief Advance the wheel to the current time, expired entries are appended to `batch`.
+     * Returns their number (0 without waiting if another thread is polling).
+     */
+    size_t poll(Batch& batch) noexcept;
+
+    /* lock-free: something may be due */
+    bool due() const noexcept;
+
+    uint64_t next_deadline() const noexcept;
+
+    Clock::time_point time_of(uint64_t tick) const noexcept;
+
+  private:  // member functions:
+    uint64_t current_tick() const noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <task::Task TaskT>
+TimerQueue<TaskT>::TimerQueue(Clock::duration resolution) noexcept
+    : origin_(Clock::now()), resolution_(resolution) {}
+
+template <task::Task TaskT>
+std::optional<uint64_t> TimerQueue<TaskT>::schedule(Entry* entry, Clock::time_point deadline) noexcept {
+    const auto since_origin = deadline - origin_;
+    if (since_origin <= Clock::duration::zero()) {
+        return std::nullopt;
+    }
+    const auto tick = static_cast<uint64_t>((since_origin + resolution_ - Clock::duration{1}) / resolution_);
+
+    std::lock_guard lock(mutex_);
+    if (tick <= wheel_.now()) {
+        return std::nullopt;
+    }
+
+    wheel_.insert(entry, tick);
+    if (tick < next_deadline_.load(std::memory_order::relaxed)) {
+        next_deadline_.store(tick);  // seq_cst: pairs with the timekeeper's park, see `Worker::pick_task`
+    }
+    return tick;
+}
+
+template <task::Task TaskT>
+bool TimerQueue<TaskT>::cancel(Entry* entry) noexcept {
+    std::lock_guard lock(mutex_);
+
+    if (!entry->scheduled()) {
+        return false;  // already expired (or never scheduled)
+    }
+    wheel_.remove(entry);
+    // `next_deadline_` is left as is: an early summary costs one spurious poll at most
+    return true;
+}
+
+template <task::Task TaskT>
+size_t TimerQueue<TaskT>::poll(Batch& batch) noexcept {
+    std::unique_lock lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return 0;
+    }
+
+    size_t count = 0;
+    wheel_.advance(current_tick(), [&batch, &count](TimerNode* node) {
+        batch.push_back(*static_cast<Entry*>(node));
+        ++count;
+    });
+
+    next_deadline_.store(wheel_.next_expiration(), std::memory_order::relaxed);
+    return count;
+}
+
+template <task::Task TaskT>
+bool TimerQueue<TaskT>::due() const noexcept {
+    const uint64_t next = next_deadline_.load(std::memory_order::relaxed);
+    return next != kNever && next <= current_tick();
+}
+
+template <task::Task TaskT>
+uint64_t TimerQueue<TaskT>::next_deadline() const noexcept {
+    ///
+    return next_deadline_.load();
+    ///
+}
+
+template <task::Task TaskT>
+auto TimerQueue<TaskT>::time_of(uint64_t tick) const noexcept -> Clock::time_point {
+    ///
+    return origin_ + resolution_ * static_cast<int64_t>(tick);
+    ///
+}
+
+template <task::Task TaskT>
+uint64_t TimerQueue<TaskT>::current_tick() const noexcept {
+    ///
+    return static_cast<uint64_t>((Clock::now() - origin_) / resolution_);
+    ///
+}
+
+}  // namespace wr::timer
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../memory/block_pool.hpp"
+#include "../tasks/concept.hpp"
+#include "timer_wheel.hpp"
+
+namespace wr {
+
+/* Task which can wait in the timer wheel (`WsExecutor::submit_after` / `submit_at`): an executor task
+ * with the intrusive wheel entry next to it. While it waits it is in no queue; when it expires it is
+ * injected as a plain task.
+ *
+ * A scheduled timer must not be destroyed: cancel it first (`WsExecutor::cancel`). */
+template <task::Task TaskT>
+class TimerTask : public TaskT, public timer::TimerNode {
+  public:  // member functions:
+    using TaskT::TaskT;
+};
+
+namespace detail {
+
+/* Callable scheduled with a delay, stored like a closure task (see `tasks/closure.hpp`) */
+template <task::TrampolineTask TaskT, typename Fun>
+class TimerClosure : public TimerTask<TaskT> {
+  private:  // data members:
+    Fun fun_;
+
+  public:  // member functions:
+    explicit TimerClosure(Fun&& fun) : TimerTask<TaskT>(&TimerClosure::trampoline), fun_(std::move(fun)) {}
+    explicit TimerClosure(const Fun& fun) : TimerTask<TaskT>(&TimerClosure::trampoline), fun_(fun) {}
+
+    TimerClosure(const TimerClosure&) = delete;
+    TimerClosure& operator=(const TimerClosure&) = delete;
+    TimerClosure(TimerClosure&&) = delete;
+    TimerClosure& operator=(TimerClosure&&) = delete;
+
+  private:  // member functions:
+    static void trampoline(TaskT* self) noexcept;
+};
+
+template <task::TrampolineTask TaskT, typename F>
+TimerTask<TaskT>* make_timer_closure(F&& fun, memory::BlockPool* pool) {
+    using Closure = TimerClosure<TaskT, std::decay_t<F>>;
+    static_assert(alignof(Closure) <= memory::BlockPool::kHeaderSize, "over-aligned closures are not supported");
+
+    void* memory = memory::BlockPool::allocate_in(pool, sizeof(Closure));
+    return ::new (memory) Closure(std::forward<F>(fun));
+}
+
+}  // namespace detail
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <task::TrampolineTask TaskT, typename Fun>
+void detail::TimerClosure<TaskT, Fun>::trampoline(TaskT* self) noexcept {
+    auto* closure = static_cast<TimerClosure*>(self);
+
+    closure->fun_();
+
+    closure->~TimerClosure();
+    memory::BlockPool::deallocate(closure);
+}
+
+}  // namespace wr
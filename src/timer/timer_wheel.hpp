@@ -0,0 +1,288 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace wr::timer {
+
+class TimerWheel;
+
+/* Intrusive entry of the wheel: lives inside the timed object, the wheel never allocates.
+ * Doubly linked => removal from the middle of a slot is O(1). */
+class TimerNode {
+  private:  // data members:
+    TimerNode* prev_ = nullptr;
+    TimerNode* next_ = nullptr;
+
+    uint64_t deadline_ = 0;  // in ticks of the wheel
+
+    uint8_t level_ = 0;  // location, to clear the occupancy bit when the slot becomes empty
+    uint8_t slot_ = 0;
+    bool scheduled_ = false;
+
+  public:  // friendship declaration:
+    friend class TimerWheel;
+
+  public:  // member functions:
+    bool scheduled() const noexcept;
+    uint64_t deadline() const noexcept;
+};
+
+/**
+ * @brief Hierarchical hashed timer wheel (Varghese & Lauck): kLevels wheels of 64 slots, a slot of level `l`
+ * spans 64^l ticks. Not thread-safe: see `TimerQueue`.
+ *
+ *  >> insert:   the level is the highest 6-bit digit in which the deadline differs from `now`,
+ *               the slot is that digit of the deadline => O(1)
+ *  >> remove:   unlink => O(1)
+ *  >> advance:  the next occupied slot is found with one `countr_zero` per level (no empty ticks are walked);
+ *               a slot of a higher level is cascaded when its range begins: its entries go one level down,
+ *               an entry is touched at most kLevels times during its life
+ *
+ *  Deadlines beyond 64^kLevels ticks from `now` wait in the overflow list, which is re-sorted once per turn
+ *  of the top wheel.
+ */
+class TimerWheel {
+  public:  // nested types:
+    static constexpr uint64_t kNever = std::numeric_limits<uint64_t>::max();
+
+    static constexpr size_t kSlotBits = 6;
+    static constexpr size_t kSlots = size_t{1} << kSlotBits;
+    static constexpr size_t kLevels = 6;  // 2^36 ticks: ~2 years of 1 ms ticks
+
+  private:  // nested types:
+    static constexpr uint8_t kOverflow = kLevels;  // `level_` of the entries in the overflow list
+
+    struct Expiration {
+        uint64_t tick;
+        uint8_t level;  // kOverflow => the overflow list
+        uint8_t slot;
+    };
+
+  private:  // data members:
+    std::array<std::array<TimerNode*, kSlots>, kLevels> slots_{};
+    std::array<uint64_t, kLevels> occupied_{};  // bit per non-empty slot
+    TimerNode* overflow_ = nullptr;
+
+    uint64_t now_ = 0;
+    size_t size_ = 0;
+
+  public:  // member functions:
+    TimerWheel() = default;
+    ~TimerWheel() = default;
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+
+    uint64_t now() const noexcept;
+    size_t size() const noexcept;
+    bool empty() const noexcept;
+
+    /*
+     * @brief Schedule `node` (not scheduled yet) at `deadline` > `now()`.
+     */
+    void insert(TimerNode* node, uint64_t deadline) noexcept;
+
+    void remove(TimerNode* node) noexcept;
+
+    /*
+     * @brief The tick of the next wheel event (kNever if the wheel is empty). May be earlier than the
+     * nearest deadline: a cascade of a higher level is an event too.
+     */
+    uint64_t next_expiration() const noexcept;
+
+    /*
+     * @brief Move the time forward to `to`: `on_expired(TimerNode*)` is called for every entry with
+     * deadline <= `to` (the entry is already unlinked and may be reused right away).
+     */
+    template <typename F>
+    void advance(uint64_t to, F&& on_expired);
+
+  private:  // member functions:
+    Expiration find_next() const noexcept;
+
+    void link(TimerNode*& head, TimerNode* node) noexcept;
+
+    static uint8_t level_for(uint64_t now, uint64_t deadline) noexcept;
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline bool TimerNode::scheduled() const noexcept {
+    ///
+    return scheduled_;
+    ///
+}
+
+inline uint64_t TimerNode::deadline() const noexcept {
+    ///
+    return deadline_;
+    ///
+}
+
+inline uint64_t TimerWheel::now() const noexcept {
+    ///
+    return now_;
+    ///
+}
+
+inline size_t TimerWheel::size() const noexcept {
+    ///
+    return size_;
+    ///
+}
+
+inline bool TimerWheel::empty() const noexcept {
+    ///
+    return size_ == 0;
+    ///
+}
+
+inline void TimerWheel::insert(TimerNode* node, uint64_t deadline) noexcept {
+    assert(!node->scheduled_ && deadline > now_);
+
+    node->deadline_ = deadline;
+    node->scheduled_ = true;
+    ++size_;
+
+    const uint8_t level = level_for(now_, deadline);
+    node->level_ = level;
+
+    if (level == kOverflow) {
+        link(overflow_, node);
+        return;
+    }
+
+    const auto slot = static_cast<uint8_t>((deadline >> (level * kSlotBits)) & (kSlots - 1));
+    node->slot_ = slot;
+    link(slots_[level][slot], node);
+    occupied_[level] |= uint64_t{1} << slot;
+}
+
+inline void TimerWheel::remove(TimerNode* node) noexcept {
+    assert(node->scheduled_);
+
+    TimerNode*& head = node->level_ == kOverflow ? overflow_ : slots_[node->level_][node->slot_];
+
+    if (node->prev_ != nullptr) {
+        node->prev_->next_ = node->next_;
+    } else {
+        head = node->next_;
+    }
+    if (node->next_ != nullptr) {
+        node->next_->prev_ = node->prev_;
+    }
+
+    if (head == nullptr && node->level_ != kOverflow) {
+        occupied_[node->level_] &= ~(uint64_t{1} << node->slot_);
+    }
+
+    node->prev_ = node->next_ = nullptr;
+    node->scheduled_ = false;
+    --size_;
+}
+
+inline uint64_t TimerWheel::next_expiration() const noexcept {
+    ///
+    return find_next().tick;
+    ///
+}
+
+template <typename F>
+void TimerWheel::advance(uint64_t to, F&& on_expired) {
+    while (true) {
+        const Expiration next = find_next();
+        if (next.tick > to) {
+            break;
+        }
+        now_ = std::max(now_, next.tick);
+
+        // detach the whole slot: its entries either expire or go one level down
+        TimerNode* list = nullptr;
+        if (next.level == kOverflow) {
+            list = overflow_;
+            overflow_ = nullptr;
+        } else {
+            list = slots_[next.level][next.slot];
+            slots_[next.level][next.slot] = nullptr;
+            occupied_[next.level] &= ~(uint64_t{1} << next.slot);
+        }
+
+        while (list != nullptr) {
+            TimerNode* node = list;
+            list = node->next_;
+
+            node->prev_ = node->next_ = nullptr;
+            node->scheduled_ = false;
+            --size_;
+
+            if (node->deadline_ <= now_) {
+                on_expired(node);  // the last touch of the node
+            } else {
+                insert(node, node->deadline_);
+            }
+        }
+    }
+
+    now_ = std::max(now_, to);
+}
+
+inline auto TimerWheel::find_next() const noexcept -> Expiration {
+    Expiration best{kNever, 0, 0};
+
+    for (uint8_t level = 0; level < kLevels; ++level) {
+        const size_t shift = level * kSlotBits;
+        const auto position = static_cast<size_t>((now_ >> shift) & (kSlots - 1));
+
+        // slots behind the position belong to the past turn of this level => they are empty
+        const uint64_t ahead = occupied_[level] & (~uint64_t{0} << position);
+        if (ahead == 0) {
+            continue;
+        }
+
+        const auto slot = static_cast<uint8_t>(std::countr_zero(ahead));
+        const uint64_t turn_begin = now_ & ~((uint64_t{1} << (shift + kSlotBits)) - 1);
+        const uint64_t tick = turn_begin + (uint64_t{slot} << shift);
+
+        if (tick < best.tick) {
+            best = Expiration{tick, level, slot};
+        }
+    }
+
+    if (overflow_ != nullptr) {
+        // the overflow list is re-sorted when the top wheel begins its next turn
+        constexpr size_t kTopBits = kLevels * kSlotBits;
+        const uint64_t next_turn = ((now_ >> kTopBits) + 1) << kTopBits;
+        if (next_turn < best.tick) {
+            best = Expiration{next_turn, kOverflow, 0};
+        }
+    }
+
+    return best;
+}
+
+inline void TimerWheel::link(TimerNode*& head, TimerNode* node) noexcept {
+    node->prev_ = nullptr;
+    node->next_ = head;
+    if (head != nullptr) {
+        head->prev_ = node;
+    }
+    head = node;
+}
+
+inline uint8_t TimerWheel::level_for(uint64_t now, uint64_t deadline) noexcept {
+    // the highest differing digit; `| (kSlots - 1)` => level 0 for the deadlines within the current slot row
+    const uint64_t masked = (now ^ deadline) | (kSlots - 1);
+    const auto significant = static_cast<size_t>(63 - std::countl_zero(masked));
+    const size_t level = significant / kSlotBits;
+    return static_cast<uint8_t>(std::min(level, size_t{kOverflow}));
+}
+
+}  // namespace wr::timer
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "trace_ring.hpp"
+
+namespace wr::trace {
+
+enum class Format : uint8_t {
+    kChromeJson,  // chrome://tracing, ui.perfetto.dev
+    kPerfetto,    // binary `perfetto.protos.Trace`, ui.perfetto.dev / trace_processor
+};
+
+/* Events of one worker, oldest first (`WsExecutor::dump_trace`) */
+struct WorkerTrace {
+    size_t worker = 0;
+    std::vector<Event> events;
+};
+
+/* Cycles => nanoseconds since the start of the executor */
+struct Timebase {
+    uint64_t origin = 0;
+    double ns_per_cycle = 1.0;
+
+    double ns(uint64_t tsc) const noexcept;
+};
+
+/*
+ * @brief Write the traces in `format`. Task and park events become slices (a slice whose beginning has been
+ * overwritten in the ring is dropped), the rest are instants; one thread / track per worker.
+ */
+void write(std::ostream& out, Format format, const std::vector<WorkerTrace>& traces, const Timebase& timebase);
+
+void write_chrome_json(std::ostream& out, const std::vector<WorkerTrace>& traces, const Timebase& timebase);
+void write_perfetto(std::ostream& out, const std::vector<WorkerTrace>& traces, const Timebase& timebase);
+
+namespace detail {
+
+enum class Phase : uint8_t {
+    kBegin,
+    kEnd,
+    kInstant,
+};
+
+struct Decoded {
+    std::string_view name;
+    Phase phase;
+};
+
+Decoded decode(EventType type) noexcept;
+
+/* Walks the events of a worker, skipping the ends of the slices which began before the ring window:
+ * `on_event(const Event&, const Decoded&)` */
+template <typename F>
+void for_each_balanced(const std::vector<Event>& events, F&& on_event);
+
+/* Minimal protobuf encoder: varint and length-delimited fields appended to a string */
+class ProtoWriter {
+  private:  // data members:
+    std::string bytes_;
+
+  public:  // member functions:
+    void varint_field(uint32_t field, uint64_t value);
+    void bytes_field(uint32_t field, std::string_view value);
+
+    const std::string& bytes() const noexcept;
+
+  private:  // member functions:
+    void varint(uint64_t value);
+};
+
+}  // namespace detail
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline double Timebase::ns(uint64_t tsc) const noexcept {
+    ///
+    return tsc <= origin ? 0.0 : static_cast<double>(tsc - origin) * ns_per_cycle;
+    ///
+}
+
+inline detail::Decoded detail::decode(EventType type) noexcept {
+    switch (type) {
+        case EventType::kTaskBegin:
+            return {"task", Phase::kBegin};
+        case EventType::kTaskEnd:
+            return {"task", Phase::kEnd};
+        case EventType::kSteal:
+            return {"steal", Phase::kInstant};
+        case EventType::kPark:
+            return {"parked", Phase::kBegin};
+        case EventType::kUnpark:
+            return {"parked", Phase::kEnd};
+        case EventType::kGlobalPop:
+            return {"global pop", Phase::kInstant};
+        case EventType::kOffload:
+            return {"offload", Phase::kInstant};
+    }
+    return {"unknown", Phase::kInstant};
+}
+
+template <typename F>
+void detail::for_each_balanced(const std::vector<Event>& events, F&& on_event) {
+    size_t open_tasks = 0;  // `Worker::help` nests tasks
+    bool parked = false;
+
+    for (const Event& event : events) {
+        switch (event.type) {
+            case EventType::kTaskBegin:
+                ++open_tasks;
+                break;
+            case EventType::kTaskEnd:
+                if (open_tasks == 0) {
+                    continue;
+                }
+                --open_tasks;
+                break;
+            case EventType::kPark:
+                parked = true;
+                break;
+            case EventType::kUnpark:
+                if (!parked) {
+                    continue;
+                }
+                parked = false;
+                break;
+            default:
+                break;
+        }
+        on_event(event, decode(event.type));
+    }
+}
+
+inline void detail::ProtoWriter::varint_field(uint32_t field, uint64_t value) {
+    varint(uint64_t{field} << 3);  // wire type 0
+    varint(value);
+}
+
+inline void detail::ProtoWriter::bytes_field(uint32_t field, std::string_view value) {
+    varint(uint64_t{field} << 3 | 2);  // wire type 2
+    varint(value.size());
+    bytes_.append(value);
+}
+
+inline const std::string& detail::ProtoWriter::bytes() const noexcept {
+    ///
+    return bytes_;
+    ///
+}
+
+inline void detail::ProtoWriter::varint(uint64_t value) {
+    while (value >= 0x80) {
+        bytes_.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    bytes_.push_back(static_cast<char>(value));
+}
+
+inline void write(std::ostream& out, Format format, const std::vector<WorkerTrace>& traces,
+                  const Timebase& timebase) {
+    if (format == Format::kPerfetto) {
+        write_perfetto(out, traces, timebase);
+    } else {
+        write_chrome_json(out, traces, timebase);
+    }
+}
+
+inline void write_chrome_json(std::ostream& out, const std::vector<WorkerTrace>& traces, const Timebase& timebase) {
+    char buffer[64];
+    bool first = true;
+    auto separator = [&out, &first] {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (const WorkerTrace& trace : traces) {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << trace.worker
+            << ",\"args\":{\"name\":\"wr-worker-" << trace.worker << "\"}}";
+
+        detail::for_each_balanced(trace.events, [&](const Event& event, const detail::Decoded& decoded) {
+            static constexpr const char* kPhases[] = {"B", "E", "i"};
+
+            std::snprintf(buffer, sizeof(buffer), "%.3f", timebase.ns(event.tsc) / 1000.0);  // µs
+            separator();
+            out << "{\"name\":\"" << decoded.name << "\",\"cat\":\"wr\",\"ph\":\""
+                << kPhases[static_cast<size_t>(decoded.phase)] << "\",\"ts\":" << buffer
+                << ",\"pid\":1,\"tid\":" << trace.worker;
+
+            if (decoded.phase == detail::Phase::kInstant) {
+                out << ",\"s\":\"t\"";
+            }
+            if (event.type == EventType::kSteal) {
+                out << ",\"args\":{\"victim\":" << event.arg << ",\"tasks\":" << event.aux << "}";
+            } else if (event.type == EventType::kOffload) {
+                out << ",\"args\":{\"tasks\":" << event.aux << "}";
+            }
+            out << "}";
+        });
+    }
+    out << "\n]}\n";
+}
+
+inline void write_perfetto(std::ostream& out, const std::vector<WorkerTrace>& traces, const Timebase& timebase) {
+    // field numbers of perfetto/protos/perfetto/trace/{trace,trace_packet}.proto, track_event/*.proto
+    enum : uint32_t {
+        kTracePacket = 1,
+
+        kTimestamp = 8,
+        kSequenceId = 10,
+        kTrackEvent = 11,
+        kSequenceFlags = 13,
+        kTrackDescriptor = 60,
+
+        kDescriptorUuid = 1,
+        kDescriptorName = 2,
+
+        kEventDebugAnnotation = 4,
+        kEventType = 9,
+        kEventTrackUuid = 11,
+        kEventName = 23,
+
+        kAnnotationUint = 3,
+        kAnnotationName = 10,
+    };
+    constexpr uint64_t kSequence = 1;
+    constexpr uint64_t kIncrementalStateCleared = 1;
+    constexpr uint64_t kTypes[] = {1, 2, 3};  // SLICE_BEGIN, SLICE_END, INSTANT
+
+    auto emit = [&out](const detail::ProtoWriter& packet) {
+        detail::ProtoWriter trace;
+        trace.bytes_field(kTracePacket, packet.bytes());
+        out.write(trace.bytes().data(), static_cast<std::streamsize>(trace.bytes().size()));
+    };
+    auto annotation = [](detail::ProtoWriter& event, std::string_view name, uint64_t value) {
+        detail::ProtoWriter debug;
+        debug.bytes_field(kAnnotationName, name);
+        debug.varint_field(kAnnotationUint, value);
+        event.bytes_field(kEventDebugAnnotation, debug.bytes());
+    };
+
+    bool first = true;
+    for (const WorkerTrace& trace : traces) {
+        const uint64_t uuid = trace.worker + 1;
+
+        detail::ProtoWriter descriptor;
+        descriptor.varint_field(kDescriptorUuid, uuid);
+        descriptor.bytes_field(kDescriptorName, "wr-worker-" + std::to_string(trace.worker));
+
+        detail::ProtoWriter packet;
+        packet.varint_field(kSequenceId, kSequence);
+        if (first) {
+            packet.varint_field(kSequenceFlags, kIncrementalStateCleared);
+            first = false;
+        }
+        packet.bytes_field(kTrackDescriptor, descriptor.bytes());
+        emit(packet);
+
+        detail::for_each_balanced(trace.events, [&](const Event& event, const detail::Decoded& decoded) {
+            detail::ProtoWriter track_event;
+            track_event.varint_field(kEventType, kTypes[static_cast<size_t>(decoded.phase)]);
+            track_event.varint_field(kEventTrackUuid, uuid);
+            if (decoded.phase != detail::Phase::kEnd) {
+                track_event.bytes_field(kEventName, decoded.name);
+            }
+            if (event.type == EventType::kSteal) {
+                annotation(track_event, "victim", event.arg);
+                annotation(track_event, "tasks", event.aux);
+            } else if (event.type == EventType::kOffload) {
+                annotation(track_event, "tasks", event.aux);
+            }
+
+            detail::ProtoWriter event_packet;
+            event_packet.varint_field(kTimestamp, static_cast<uint64_t>(timebase.ns(event.tsc)));
+            event_packet.varint_field(kSequenceId, kSequence);
+            event_packet.bytes_field(kTrackEvent, track_event.bytes());
+            emit(event_packet);
+        });
+    }
+}
+
+}  // namespace wr::trace
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../utils/constants.hpp"
+#include "../utils/tsc.hpp"
+
+namespace wr::trace {
+
+enum class EventType : uint8_t {
+    kTaskBegin,
+    kTaskEnd,
+    kSteal,      // arg: victim worker, aux: tasks taken
+    kPark,
+    kUnpark,
+    kGlobalPop,  // a task from an injection queue
+    kOffload,    // aux: tasks moved out of the full local queue
+};
+
+struct Event {
+    uint64_t tsc;
+    EventType type;
+    uint16_t aux;
+    uint32_t arg;
+};
+
+/**
+ * @brief Per-worker flight recorder (`Config::kEnableTracing`): fixed-size binary events in an overwriting ring.
+ *
+ *  >> the owner writes two words per event and publishes the position (release) => no locks, no RMW
+ *  >> `read` copies the last events from any thread, while the owner keeps writing; the slots which may have
+ *     been overwritten during the copy are dropped (the position is read again afterwards)
+ *  >> the ring is allocated once, with the worker
+ *
+ *  Disabled => an empty type with no-op members: nothing is recorded, nothing is branched on.
+ */
+template <bool Enabled>
+class TraceRing;
+
+template <>
+class TraceRing<true> {
+  private:  // nested types:
+    struct Slot {
+        std::atomic<uint64_t> tsc;
+        std::atomic<uint64_t> data;  // type << 56 | aux << 32 | arg
+    };
+
+  private:  // data members:
+    std::unique_ptr<Slot[]> slots_;
+    const size_t mask_;
+
+    alignas(utils::constants::CACHE_LINE_SIZE) std::atomic<uint64_t> head_ = 0;  // events written so far
+
+  public:  // member functions:
+    explicit TraceRing(size_t capacity);  // power of two
+
+    TraceRing(const TraceRing&) = delete;
+    TraceRing& operator=(const TraceRing&) = delete;
+    TraceRing(TraceRing&&) = delete;
+    TraceRing& operator=(TraceRing&&) = delete;
+
+    void record(EventType type, uint32_t arg = 0, uint16_t aux = 0) noexcept;  // owner only
+
+    std::vector<Event> read() const;  // any thread, oldest first
+};
+
+template <>
+class TraceRing<false> {
+  public:  // member functions:
+    explicit TraceRing(size_t) noexcept {}
+
+    void record(EventType, uint32_t = 0, uint16_t = 0) noexcept {}
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline TraceRing<true>::TraceRing(size_t capacity) : slots_(new Slot[capacity]), mask_(capacity - 1) {}
+
+inline void TraceRing<true>::record(EventType type, uint32_t arg, uint16_t aux) noexcept {
+    const uint64_t position = head_.load(std::memory_order::relaxed);
+    Slot& slot = slots_[position & mask_];
+
+    slot.tsc.store(utils::tsc::now(), std::memory_order::relaxed);
+    slot.data.store(uint64_t{static_cast<uint8_t>(type)} << 56 | uint64_t{aux} << 32 | arg,
+                    std::memory_order::relaxed);
+    head_.store(position + 1, std::memory_order::release);
+}
+
+inline std::vector<Event> TraceRing<true>::read() const {
+    const uint64_t capacity = mask_ + 1;
+    const uint64_t end = head_.load(std::memory_order::acquire);
+    const uint64_t begin = end > capacity ? end - capacity : 0;
+
+    std::vector<Event> events;
+    events.reserve(static_cast<size_t>(end - begin));
+    for (uint64_t position = begin; position < end; ++position) {
+        const Slot& slot = slots_[position & mask_];
+        const uint64_t data = slot.data.load(std::memory_order::relaxed);
+        events.push_back(Event{slot.tsc.load(std::memory_order::relaxed), static_cast<EventType>(data >> 56),
+                               static_cast<uint16_t>(data >> 32), static_cast<uint32_t>(data)});
+    }
+
+    // the owner may have lapped us meanwhile: those slots are torn => drop them
+    std::atomic_thread_fence(std::memory_order::acquire);
+    const uint64_t lapped = head_.load(std::memory_order::relaxed);
+    const uint64_t valid_from = lapped > capacity ? lapped - capacity : 0;
+    if (valid_from > begin) {
+        const auto torn = static_cast<size_t>(std::min(valid_from - begin, end - begin));
+        events.erase(events.begin(), events.begin() + static_cast<std::ptrdiff_t>(torn));
+    }
+    return events;
+}
+
+}  // namespace wr::trace
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace wr::utils {
+
+/* HDR-style log-linear bucketing: 2^kSubBucketBits linear sub-buckets per power of two
+ * => the relative error of a recorded value is below 1 / 2^kSubBucketBits (6.25%), over the whole uint64_t range.
+ * Fixed number of buckets => no allocation, histograms merge by adding the buckets. */
+struct LogLinearBuckets {
+    static constexpr size_t kSubBucketBits = 4;
+    static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+    static constexpr size_t kBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+    static constexpr size_t index_of(uint64_t value) noexcept;
+
+    /* the smallest value of the bucket */
+    static constexpr uint64_t lower_bound(size_t index) noexcept;
+};
+
+/* Plain histogram: a snapshot or a merge result */
+class Histogram {
+  private:  // data members:
+    std::array<uint64_t, LogLinearBuckets::kBuckets> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t max_ = 0;
+
+  public:  // friendship declaration:
+    friend class ConcurrentHistogram;
+
+  public:  // member functions:
+    void record(uint64_t value) noexcept;
+
+    Histogram& operator+=(const Histogram& other) noexcept;
+
+    uint64_t count() const noexcept;
+    uint64_t max() const noexcept;
+    double mean() const noexcept;
+
+    /* `quantile` in [0; 1]: the lower bound of the bucket which holds it (0 if empty) */
+    uint64_t percentile(double quantile) const noexcept;
+};
+
+/* Histogram written by one thread and read by any: relaxed loads and stores, no RMW */
+class ConcurrentHistogram {
+  private:  // data members:
+    std::array<std::atomic<uint64_t>, LogLinearBuckets::kBuckets> buckets_{};
+    std::atomic<uint64_t> sum_ = 0;
+    std::atomic<uint64_t> max_ = 0;
+
+  public:  // member functions:
+    void record(uint64_t value) noexcept;  // owner only
+    Histogram snapshot() const noexcept;   // any thread
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+constexpr size_t LogLinearBuckets::index_of(uint64_t value) noexcept {
+    if (value < kSubBuckets) {
+        return static_cast<size_t>(value);
+    }
+    const auto msb = static_cast<size_t>(63 - std::countl_zero(value));
+    const size_t exponent = msb - kSubBucketBits + 1;
+    const auto sub = static_cast<size_t>((value >> (msb - kSubBucketBits)) & (kSubBuckets - 1));
+    return exponent * kSubBuckets + sub;
+}
+
+constexpr uint64_t LogLinearBuckets::lower_bound(size_t index) noexcept {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    const size_t exponent = index / kSubBuckets;
+    const size_t sub = index % kSubBuckets;
+    return (uint64_t{kSubBuckets} + sub) << (exponent - 1);
+}
+
+static_assert(LogLinearBuckets::index_of(~uint64_t{0}) == LogLinearBuckets::kBuckets - 1);
+static_assert(LogLinearBuckets::lower_bound(LogLinearBuckets::index_of(1000)) <= 1000);
+
+inline void Histogram::record(uint64_t value) noexcept {
+    ++buckets_[LogLinearBuckets::index_of(value)];
+    ++count_;
+    sum_ += value;
+    max_ = value > max_ ? value : max_;
+}
+
+inline Histogram& Histogram::operator+=(const Histogram& other) noexcept {
+    for (size_t i = 0; i < buckets_.size(); ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = other.max_ > max_ ? other.max_ : max_;
+    return *this;
+}
+
+inline uint64_t Histogram::count() const noexcept {
+    ///
+    return count_;
+    ///
+}
+
+inline uint64_t Histogram::max() const noexcept {
+    ///
+    return max_;
+    ///
+}
+
+inline double Histogram::mean() const noexcept {
+    ///
+    return count_ == 0 ? 0.0 : static_cast<double>(sum_) / static_cast<double>(count_);
+    ///
+}
+
+inline uint64_t Histogram::percentile(double quantile) const noexcept {
+    if (count_ == 0) {
+        return 0;
+    }
+
+    // rank of the wanted value, 1-based
+    auto rank = static_cast<uint64_t>(quantile * static_cast<double>(count_) + 0.5);
+    rank = rank == 0 ? 1 : (rank > count_ ? count_ : rank);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets_.size(); ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            return LogLinearBuckets::lower_bound(i);
+        }
+    }
+    return max_;
+}
+
+inline void ConcurrentHistogram::record(uint64_t value) noexcept {
+    auto bump = [](std::atomic<uint64_t>& counter, uint64_t delta) {
+        counter.store(counter.load(std::memory_order::relaxed) + delta, std::memory_order::relaxed);
+    };
+
+    bump(buckets_[LogLinearBuckets::index_of(value)], 1);
+    bump(sum_, value);
+    if (value > max_.load(std::memory_order::relaxed)) {
+        max_.store(value, std::memory_order::relaxed);
+    }
+}
+
+inline Histogram ConcurrentHistogram::snapshot() const noexcept {
+    Histogram result;
+    for (size_t i = 0; i < buckets_.size(); ++i) {
+        result.buckets_[i] = buckets_[i].load(std::memory_order::relaxed);
+    }
+    // the count is the sum of the buckets: the copy is consistent with itself
+    for (uint64_t bucket : result.buckets_) {
+        result.count_ += bucket;
+    }
+    result.sum_ = sum_.load(std::memory_order::relaxed);
+    result.max_ = max_.load(std::memory_order::relaxed);
+    return result;
+}
+
+}  // namespace wr::utils
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+ * USDT (SystemTap SDT) probes: `WR_PROBE2(steal, worker, victim)` leaves a `nop` in the code and a
+ * `.note.stapsdt` entry (provider `white_rabbit`) in the binary. Nothing runs until a tracer attaches:
+ *
+ *      perf buildid-cache --add <binary> && perf probe sdt_white_rabbit:steal && perf record -e sdt_white_rabbit:steal
+ *      bpftrace -e 'usdt:<binary>:white_rabbit:park { @[arg0] = count(); }'
+ *
+ * The notes are emitted here (the format of <sys/sdt.h>) => no systemtap headers, no runtime library.
+ * Arguments are passed as uint64_t. Compiled in with `-DWR_ENABLE_PROBES=ON` (Linux, x86-64 / AArch64),
+ * otherwise the macros expand to nothing.
+ */
+
+#if defined(WR_ENABLE_PROBES) && defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+
+#    define WR_PROBE_NOTE(name, args)                                                  \
+        "990: nop\n"                                                                   \
+        ".pushsection .note.stapsdt,\"?\",\"note\"\n"                                  \
+        ".balign 4\n"                                                                  \
+        ".4byte 992f-991f, 994f-993f, 3\n"                                             \
+        "991: .asciz \"stapsdt\"\n"                                                    \
+        "992: .balign 4\n"                                                             \
+        "993: .8byte 990b\n"                                                           \
+        ".8byte _.stapsdt.base\n"                                                      \
+        ".8byte 0\n"                                                                   \
+        ".asciz \"white_rabbit\"\n"                                                    \
+        ".asciz \"" #name "\"\n"                                                       \
+        ".asciz \"" args "\"\n"                                                        \
+        "994: .balign 4\n"                                                             \
+        ".popsection\n"                                                                \
+        ".ifndef _.stapsdt.base\n"                                                     \
+        ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n"        \
+        ".weak _.stapsdt.base\n"                                                       \
+        ".hidden _.stapsdt.base\n"                                                     \
+        "_.stapsdt.base: .space 1\n"                                                   \
+        ".size _.stapsdt.base, 1\n"                                                    \
+        ".popsection\n"                                                                \
+        ".endif\n"
+
+#    define WR_PROBE1(name, x0) \
+        __asm__ __volatile__(WR_PROBE_NOTE(name, "8@%[a0]")::[a0] "nor"(static_cast<uint64_t>(x0)))
+
+#    define WR_PROBE2(name, x0, x1)                                                    \
+        __asm__ __volatile__(WR_PROBE_NOTE(name, "8@%[a0] 8@%[a1]")::[a0] "nor"(    \
+                                 static_cast<uint64_t>(x0)),                         \
+                             [a1] "nor"(static_cast<uint64_t>(x1)))
+
+#    define WR_PROBE3(name, x0, x1, x2)                                                \
+        __asm__ __volatile__(WR_PROBE_NOTE(name, "8@%[a0] 8@%[a1] 8@%[a2]")::[a0] "nor"( \
+                                 static_cast<uint64_t>(x0)),                         \
+                             [a1] "nor"(static_cast<uint64_t>(x1)), [a2] "nor"(static_cast<uint64_t>(x2)))
+
+#else
+
+#    define WR_PROBE1(name, x0) static_cast<void>(0)
+#    define WR_PROBE2(name, x0, x1) static_cast<void>(0)
+#    define WR_PROBE3(name, x0, x1, x2) static_cast<void>(0)
+
+#endif
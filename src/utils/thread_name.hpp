@@ -0,0 +1,22 @@
+#pragma once
+
+#if defined(__linux__) || defined(__APPLE__)
+#    include <pthread.h>
+#endif
+
+namespace wr::utils {
+
+/* Names the calling thread for perf / top / gdb (`wr-worker-3`): at most 15 characters on Linux */
+void set_thread_name(const char* name) noexcept;
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline void set_thread_name([[maybe_unused]] const char* name) noexcept {
+#if defined(__linux__)
+    ::pthread_setname_np(::pthread_self(), name);
+#elif defined(__APPLE__)
+    ::pthread_setname_np(name);
+#endif
+}
+
+}  // namespace wr::utils
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#endif
+
+namespace wr::utils::tsc {
+
+/* Cheap timestamp for the instrumentation: the time stamp counter on x86 (no serialization, ~20 cycles),
+ * steady_clock nanoseconds elsewhere. Units are "cycles": convert with a `Calibration`. */
+inline uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/* Cycles => nanoseconds without a calibration spin: the rate is measured between the construction
+ * (e.g. the start of an executor) and the moment of the conversion */
+class Calibration {
+  private:  // data members:
+    std::chrono::steady_clock::time_point wall_origin_ = std::chrono::steady_clock::now();
+    uint64_t tsc_origin_ = now();
+
+  public:  // member functions:
+    double ns_per_cycle() const noexcept;
+    uint64_t origin() const noexcept;  // the counter at the construction
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline double Calibration::ns_per_cycle() const noexcept {
+    const auto wall = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - wall_origin_);
+    const uint64_t cycles = now() - tsc_origin_;
+    return cycles == 0 ? 1.0 : wall.count() / static_cast<double>(cycles);
+}
+
+inline uint64_t Calibration::origin() const noexcept {
+    ///
+    return tsc_origin_;
+    ///
+}
+
+}  // namespace wr::utils::tsc
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+
+#if defined(__GLIBC__)
+#    include <execinfo.h>
+#    include <signal.h>
+
+#    include <cstdlib>
+#endif
+
+namespace wr::watchdog {
+
+/*
+ * @brief Stack of another thread of this process: `thread` is signalled with `signal`, the handler unwinds
+ * its own stack into a shared buffer. Empty if the thread does not answer within `timeout` (or unsupported:
+ * glibc only). One capture at a time per process.
+ */
+std::vector<void*> capture_backtrace(pthread_t thread, int signal, std::chrono::milliseconds timeout);
+
+/* "binary(symbol+offset) [address]" per frame */
+std::vector<std::string> symbolize(const std::vector<void*>& frames);
+
+namespace detail {
+
+#if defined(__GLIBC__)
+
+struct Capture {
+    static constexpr int kMaxFrames = 64;
+
+    void* frames[kMaxFrames];
+    std::atomic<int> size = -1;  // -1 => not captured yet
+};
+
+inline std::atomic<Capture*> pending_capture = nullptr;
+
+inline void on_capture_signal(int) {
+    // async-signal-safe enough: `backtrace` has been called once outside of the handler (libgcc is loaded)
+    Capture* capture = pending_capture.exchange(nullptr);
+    if (capture != nullptr) {
+        const int size = ::backtrace(capture->frames, Capture::kMaxFrames);
+        capture->size.store(size, std::memory_order::release);
+    }
+}
+
+inline void install_capture_handler(int signal) {
+    static std::once_flag installed;
+    std::call_once(installed, [signal] {
+        void* warm_up[1];
+        ::backtrace(warm_up, 1);
+
+        struct sigaction action {};
+        action.sa_handler = &on_capture_signal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        ::sigaction(signal, &action, nullptr);
+    });
+}
+
+#endif
+
+}  // namespace detail
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+#if defined(__GLIBC__)
+
+inline std::vector<void*> capture_backtrace(pthread_t thread, int signal, std::chrono::milliseconds timeout) {
+    static std::mutex one_at_a_time;
+    std::lock_guard lock(one_at_a_time);
+
+    detail::install_capture_handler(signal);
+
+    // the buffer outlives a late answer: the handler takes it from `pending_capture` or never sees it
+    static detail::Capture capture;
+    capture.size.store(-1, std::memory_order::relaxed);
+    detail::pending_capture.store(&capture);
+
+    if (::pthread_kill(thread, signal) != 0) {
+        detail::pending_capture.store(nullptr);
+        return {};
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (capture.size.load(std::memory_order::acquire) < 0) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            if (detail::pending_capture.exchange(nullptr) != nullptr) {
+                return {};  // the handler has not started: it will not touch the buffer
+            }
+            // the handler is running: it will be done shortly
+        }
+        std::this_thread::yield();
+    }
+
+    const int size = capture.size.load(std::memory_order::acquire);
+    return std::vector<void*>(capture.frames, capture.frames + size);
+}
+
+inline std::vector<std::string> symbolize(const std::vector<void*>& frames) {
+    std::vector<std::string> lines;
+    if (frames.empty()) {
+        return lines;
+    }
+
+    char** symbols = ::backtrace_symbols(frames.data(), static_cast<int>(frames.size()));
+    if (symbols == nullptr) {
+        return lines;
+    }
+    for (size_t i = 0; i < frames.size(); ++i) {
+        lines.emplace_back(symbols[i]);
+    }
+    std::free(symbols);
+    return lines;
+}
+
+#else
+
+inline std::vector<void*> capture_backtrace(pthread_t, int, std::chrono::milliseconds) {
+    ///
+    return {};
+    ///
+}
+
+inline std::vector<std::string> symbolize(const std::vector<void*>&) {
+    ///
+    return {};
+    ///
+}
+
+#endif
+
+}  // namespace wr::watchdog
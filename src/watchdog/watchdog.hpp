@@ -0,0 +1,191 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUG__)
+#    include <cxxabi.h>
+#endif
+
+#if defined(__GLIBC__)
+#    include <dlfcn.h>
+#endif
+
+#include "../utils/thread_name.hpp"
+
+namespace wr::watchdog {
+
+/* A task which has been running for longer than the threshold */
+struct StallReport {
+    size_t worker = 0;
+    const void* task = nullptr;  // may be gone by the time the report is read: never dereference it
+    std::string type;            // the concrete task: the symbol of its trampoline, else the executor's task type
+    std::chrono::nanoseconds duration{0};
+    std::vector<std::string> backtrace;  // empty unless `Config::kWatchdogBacktrace`
+};
+
+using StallHandler = std::function<void(const StallReport&)>;
+
+/* "worker 2: task 0x... (wr::TypedTask<Job>::trampoline) has been running for 1500 ms" + the frames */
+void print(std::ostream& out, const StallReport& report);
+
+std::string demangle(const std::type_info& type);
+
+/*
+ * @brief Demangled name of the function at `entry` (a task trampoline, see `task::entry_of`) without its
+ * parameter list, e.g. "wr::TypedTask<Job>::trampoline". Empty if it cannot be resolved: glibc only, and the
+ * symbols of the main executable are only visible when it exports them (`-rdynamic`, CMake `ENABLE_EXPORTS`).
+ */
+std::string function_name(const void* entry);
+
+namespace detail {
+
+std::string demangle(const char* mangled);
+
+}  // namespace detail
+
+/**
+ * @brief Watchdog thread of an executor (`Config::kWatchdogThresholdMs`): every period it calls
+ * `check(Watchdog&)`, which compares the start stamps of the workers (`TaskWatch`) with the clock and
+ * `report`s the stalled ones.
+ *
+ * The workers only pay for the stamps; the clock is read here. The handler runs on this thread,
+ * serialized with `set_handler`: a slow handler delays the next check, not the workers.
+ */
+class Watchdog {
+  private:  // data members:
+    std::mutex handler_mutex_;
+    StallHandler handler_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+
+    std::thread thread_;
+
+  public:  // member functions:
+    template <typename Check>
+    Watchdog(std::chrono::milliseconds period, StallHandler handler, Check check);
+    ~Watchdog();
+
+    Watchdog(const Watchdog&) = delete;
+    Watchdog& operator=(const Watchdog&) = delete;
+    Watchdog(Watchdog&&) = delete;
+    Watchdog& operator=(Watchdog&&) = delete;
+
+    void set_handler(StallHandler handler);
+
+    void report(const StallReport& report);
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline void print(std::ostream& out, const StallReport& report) {
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(report.duration).count();
+    out << "wr watchdog: worker " << report.worker << ": task " << report.task << " (" << report.type
+        << ") has been running for " << ms << " ms\n";
+    for (const auto& frame : report.backtrace) {
+        out << "    " << frame << '\n';
+    }
+}
+
+inline std::string demangle(const std::type_info& type) {
+    ///
+    return detail::demangle(type.name());
+    ///
+}
+
+inline std::string function_name([[maybe_unused]] const void* entry) {
+#if defined(__GLIBC__)
+    Dl_info info{};
+    if (entry == nullptr || ::dladdr(entry, &info) == 0 || info.dli_sname == nullptr) {
+        return {};
+    }
+    std::string name = detail::demangle(info.dli_sname);
+
+    // "ns::Type<A, B>::trampoline(ns::Base*)": drop the parameters, their parentheses may nest
+    if (!name.empty() && name.back() == ')') {
+        size_t depth = 0;
+        for (size_t i = name.size(); i-- > 0;) {
+            if (name[i] == ')') {
+                ++depth;
+            } else if (name[i] == '(' && --depth == 0) {
+                name.resize(i);
+                break;
+            }
+        }
+    }
+    return name;
+#else
+    return {};
+#endif
+}
+
+namespace detail {
+
+inline std::string demangle(const char* mangled) {
+#if defined(__GNUG__)
+    int status = 0;
+    std::unique_ptr<char, void (*)(void*)> name(abi::__cxa_demangle(mangled, nullptr, nullptr, &status), &std::free);
+    if (status == 0 && name != nullptr) {
+        return name.get();
+    }
+#endif
+    return mangled;
+}
+
+}  // namespace detail
+
+template <typename Check>
+Watchdog::Watchdog(std::chrono::milliseconds period, StallHandler handler, Check check)
+    : handler_(std::move(handler)) {
+    thread_ = std::thread([this, period, check = std::move(check)]() mutable {
+        utils::set_thread_name("wr-watchdog");
+        std::unique_lock lock(mutex_);
+        while (!stop_) {
+            // a polling period, not a deadline: the system clock will do (plain pthread_cond_timedwait)
+            wake_.wait_until(lock, std::chrono::system_clock::now() + period, [this] { return stop_; });
+            if (stop_) {
+                break;
+            }
+
+            lock.unlock();
+            check(*this);
+            lock.lock();
+        }
+    });
+}
+
+inline Watchdog::~Watchdog() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+inline void Watchdog::set_handler(StallHandler handler) {
+    std::lock_guard lock(handler_mutex_);
+    handler_ = std::move(handler);
+}
+
+inline void Watchdog::report(const StallReport& report) {
+    std::lock_guard lock(handler_mutex_);
+    if (handler_) {
+        handler_(report);
+    }
+}
+
+}  // namespace wr::watchdog
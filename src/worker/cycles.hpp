@@ -0,0 +1,172 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../utils/constants.hpp"
+#include "../utils/tsc.hpp"
+
+namespace wr::stats {
+
+/* Phases of the run loop of a worker (see `Worker::pick_task`) */
+enum class Phase : uint8_t {
+    kRunning,      // inside `TaskType::run`
+    kLocalPop,     // inbox, handoff, LIFO slot, local deques (and the aging tick)
+    kGlobalPoll,   // injection queues, timers, non-blocking reactor polls
+    kCoordinator,  // `Coordinator::ask_to_steal`
+    kStealing,     // the victims one by one (see `Utilization::steal_cycles`)
+    kParked,       // asleep on the condvar or in epoll
+    kCount,
+};
+
+/* Cycles of one worker per phase: where its time went */
+struct Utilization {
+    std::array<uint64_t, static_cast<size_t>(Phase::kCount)> cycles{};
+    std::vector<uint64_t> steal_cycles;  // per victim worker (its own entry stays 0), sums to kStealing
+
+    uint64_t total() const noexcept;
+    uint64_t of(Phase phase) const noexcept;
+    double share(Phase phase) const noexcept;  // of the total, 0 if nothing has been accounted yet
+
+    Utilization& operator+=(const Utilization& other);
+};
+
+/**
+ * @brief Cycle accounting of a worker (`Config::kEnableCycleAccounting`): one rdtsc per phase transition.
+ *
+ *  >> `lap(phase)` charges the cycles since the previous lap to `phase` => the phases tile the life of the worker,
+ *     nothing is double counted (a task which helps the pool charges its scheduling to the scheduler phases)
+ *  >> owner-only writes (a relaxed load + a relaxed store), `snapshot` from any thread
+ *
+ *  Disabled => an empty type with no-op members: no timestamps are taken.
+ */
+template <bool Enabled>
+class PhaseClock;
+
+template <>
+class alignas(utils::constants::CACHE_LINE_SIZE) PhaseClock<true> {
+  private:  // data members:
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(Phase::kCount)> cycles_{};
+    std::unique_ptr<std::atomic<uint64_t>[]> steal_cycles_;
+    const size_t workers_;
+
+    uint64_t last_ = 0;  // owner only
+
+  public:  // member functions:
+    explicit PhaseClock(size_t workers);
+
+    PhaseClock(const PhaseClock&) = delete;
+    PhaseClock& operator=(const PhaseClock&) = delete;
+    PhaseClock(PhaseClock&&) = delete;
+    PhaseClock& operator=(PhaseClock&&) = delete;
+
+    void start() noexcept;                   // owner: the accounting begins now
+    void lap(Phase phase) noexcept;          // owner
+    void lap_steal(size_t victim) noexcept;  // owner: an attempt on `victim` => kStealing
+
+    Utilization snapshot() const;  // any thread
+
+  private:  // member functions:
+    uint64_t elapsed() noexcept;
+    static void add(std::atomic<uint64_t>& value, uint64_t cycles) noexcept;
+};
+
+template <>
+class PhaseClock<false> {
+  public:  // member functions:
+    explicit PhaseClock(size_t) noexcept {}
+
+    void start() noexcept {}
+    void lap(Phase) noexcept {}
+    void lap_steal(size_t) noexcept {}
+
+    Utilization snapshot() const {
+        return {};
+    }
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline uint64_t Utilization::total() const noexcept {
+    uint64_t sum = 0;
+    for (uint64_t value : cycles) {
+        sum += value;
+    }
+    return sum;
+}
+
+inline uint64_t Utilization::of(Phase phase) const noexcept {
+    ///
+    return cycles[static_cast<size_t>(phase)];
+    ///
+}
+
+inline double Utilization::share(Phase phase) const noexcept {
+    const uint64_t sum = total();
+    return sum == 0 ? 0.0 : static_cast<double>(of(phase)) / static_cast<double>(sum);
+}
+
+inline Utilization& Utilization::operator+=(const Utilization& other) {
+    for (size_t i = 0; i < cycles.size(); ++i) {
+        cycles[i] += other.cycles[i];
+    }
+    if (steal_cycles.size() < other.steal_cycles.size()) {
+        steal_cycles.resize(other.steal_cycles.size());
+    }
+    for (size_t i = 0; i < other.steal_cycles.size(); ++i) {
+        steal_cycles[i] += other.steal_cycles[i];
+    }
+    return *this;
+}
+
+inline PhaseClock<true>::PhaseClock(size_t workers)
+    : steal_cycles_(new std::atomic<uint64_t>[workers] {}), workers_(workers) {}
+
+inline void PhaseClock<true>::start() noexcept {
+    ///
+    last_ = utils::tsc::now();
+    ///
+}
+
+inline void PhaseClock<true>::lap(Phase phase) noexcept {
+    ///
+    add(cycles_[static_cast<size_t>(phase)], elapsed());
+    ///
+}
+
+inline void PhaseClock<true>::lap_steal(size_t victim) noexcept {
+    const uint64_t cycles = elapsed();
+    add(cycles_[static_cast<size_t>(Phase::kStealing)], cycles);
+    add(steal_cycles_[victim], cycles);
+}
+
+inline Utilization PhaseClock<true>::snapshot() const {
+    Utilization utilization;
+    for (size_t i = 0; i < cycles_.size(); ++i) {
+        utilization.cycles[i] = cycles_[i].load(std::memory_order::relaxed);
+    }
+    utilization.steal_cycles.resize(workers_);
+    for (size_t i = 0; i < workers_; ++i) {
+        utilization.steal_cycles[i] = steal_cycles_[i].load(std::memory_order::relaxed);
+    }
+    return utilization;
+}
+
+inline uint64_t PhaseClock<true>::elapsed() noexcept {
+    const uint64_t now = utils::tsc::now();
+    const uint64_t cycles = now - last_;
+    last_ = now;
+    return cycles;
+}
+
+inline void PhaseClock<true>::add(std::atomic<uint64_t>& value, uint64_t cycles) noexcept {
+    ///
+    value.store(value.load(std::memory_order::relaxed) + cycles, std::memory_order::relaxed);
+    ///
+}
+
+}  // namespace wr::stats
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../utils/constants.hpp"
+#include "../utils/histogram.hpp"
+#include "../utils/tsc.hpp"
+
+namespace wr::stats {
+
+/* Where the worker took the task from: the queue wait is kept per path */
+enum class Source : uint8_t {
+    kLifo,
+    kLocal,   // own deque (the rest of a stolen batch and adopted handoffs included)
+    kGlobal,  // injection queues: global, task groups
+    kStolen,  // the task returned by a steal
+    kInbox,   // `WsExecutor::submit_to`
+    kCount,
+};
+
+/* Latency histograms of one worker, in TSC cycles */
+struct WorkerLatency {
+    std::array<utils::Histogram, static_cast<size_t>(Source::kCount)> wait;  // enqueue => `run()`, per source
+    utils::Histogram exec;                                                    // `run()`
+
+    const utils::Histogram& wait_from(Source source) const noexcept;
+
+    WorkerLatency& operator+=(const WorkerLatency& other) noexcept;
+};
+
+/* `WsExecutor::latency()`: the workers one by one + their merge */
+struct LatencySnapshot {
+    std::vector<WorkerLatency> workers;
+    WorkerLatency total;
+    double ns_per_cycle = 1.0;  // cycles => nanoseconds
+};
+
+/**
+ * @brief Queue-wait and execution time of the tasks run by a worker (`Config::kEnableLatency`).
+ *
+ *  >> the task is stamped when it enters the scheduler (`WsExecutor::submit*`, the LIFO slot of the spawner,
+ *     expired timers, ready I/O); moving between queues (offload, steal) keeps the stamp
+ *  >> the worker notes the source when it pops the task, the wait goes to the histogram of that source
+ *  >> owner-only writes into `ConcurrentHistogram`s => `snapshot` from any thread, the workers are not stopped
+ *
+ *  Disabled => an empty type with no-op members.
+ */
+template <bool Enabled>
+class LatencyRecorder;
+
+template <>
+class alignas(utils::constants::CACHE_LINE_SIZE) LatencyRecorder<true> {
+  private:  // data members:
+    Source source_ = Source::kLocal;
+
+    std::array<utils::ConcurrentHistogram, static_cast<size_t>(Source::kCount)> wait_;
+    utils::ConcurrentHistogram exec_;
+
+  public:  // member functions:
+    void note_source(Source source) noexcept;
+    Source source() const noexcept;
+
+    // right before `run()` (the task may be gone after it), returns the start for `end`
+    template <typename TaskT>
+    uint64_t begin(const TaskT* task) noexcept;
+    void end(uint64_t started_at) noexcept;
+
+    WorkerLatency snapshot() const noexcept;
+};
+
+template <>
+class LatencyRecorder<false> {
+  public:  // member functions:
+    void note_source(Source) noexcept {}
+    Source source() const noexcept {
+        return Source::kLocal;
+    }
+
+    template <typename TaskT>
+    uint64_t begin(const TaskT*) noexcept {
+        return 0;
+    }
+    void end(uint64_t) noexcept {}
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline const utils::Histogram& WorkerLatency::wait_from(Source source) const noexcept {
+    ///
+    return wait[static_cast<size_t>(source)];
+    ///
+}
+
+inline WorkerLatency& WorkerLatency::operator+=(const WorkerLatency& other) noexcept {
+    for (size_t i = 0; i < wait.size(); ++i) {
+        wait[i] += other.wait[i];
+    }
+    exec += other.exec;
+    return *this;
+}
+
+inline void LatencyRecorder<true>::note_source(Source source) noexcept {
+    ///
+    source_ = source;
+    ///
+}
+
+inline Source LatencyRecorder<true>::source() const noexcept {
+    ///
+    return source_;
+    ///
+}
+
+template <typename TaskT>
+uint64_t LatencyRecorder<true>::begin(const TaskT* task) noexcept {
+    const uint64_t now = utils::tsc::now();
+    const uint64_t enqueued_at = task->enqueued_at();
+    // the TSCs of different cores may be slightly apart
+    wait_[static_cast<size_t>(source_)].record(now > enqueued_at ? now - enqueued_at : 0);
+    return now;
+}
+
+inline void LatencyRecorder<true>::end(uint64_t started_at) noexcept {
+    const uint64_t now = utils::tsc::now();
+    exec_.record(now > started_at ? now - started_at : 0);
+}
+
+inline WorkerLatency LatencyRecorder<true>::snapshot() const noexcept {
+    WorkerLatency latency;
+    for (size_t i = 0; i < wait_.size(); ++i) {
+        latency.wait[i] = wait_[i].snapshot();
+    }
+    latency.exec = exec_.snapshot();
+    return latency;
+}
+
+}  // namespace wr::stats
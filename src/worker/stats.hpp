@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../utils/constants.hpp"
+#include "cycles.hpp"
+
+namespace wr::stats {
+
+enum class Counter : uint8_t {
+    kTasksRun,
+    kLifoHits,
+    kLocalPops,
+    kGlobalPops,
+    kStealAttempts,  // one per victim asked
+    kStealSuccess,
+    kStealEmpty,
+    kStealRetry,
+    kTasksStolen,  // the whole batch, the returned task included
+    kParks,
+    kUnparks,
+    kOffloads,  // local queue overflows (half of it moved out)
+    kCount,
+};
+
+/* Snapshot of the counters of one worker */
+struct WorkerStats {
+    uint64_t tasks_run = 0;
+    uint64_t lifo_hits = 0;
+    uint64_t local_pops = 0;
+    uint64_t global_pops = 0;
+    uint64_t steal_attempts = 0;
+    uint64_t steal_success = 0;
+    uint64_t steal_empty = 0;
+    uint64_t steal_retry = 0;
+    uint64_t tasks_stolen = 0;
+    uint64_t parks = 0;
+    uint64_t unparks = 0;
+    uint64_t offloads = 0;
+
+    Utilization utilization;  // `Config::kEnableCycleAccounting`, zeros otherwise
+
+    WorkerStats& operator+=(const WorkerStats& other) noexcept;
+};
+
+/* `WsExecutor::stats()`: the workers one by one + their sum */
+struct Snapshot {
+    std::vector<WorkerStats> workers;
+    WorkerStats total;
+    double ns_per_cycle = 1.0;  // of the utilization cycles
+};
+
+/**
+ * @brief Counters of a worker (`Config::kEnableStats`).
+ *
+ *  >> owner-only writes: a relaxed load + a relaxed store, no RMW, no fence
+ *  >> readers (`snapshot`) load relaxed from any thread => the workers are never stopped,
+ *     a snapshot is not atomic as a whole (counters may be a few events apart)
+ *  >> the counters of a worker occupy cache lines of their own
+ *
+ *  Disabled => an empty type with no-op members: the calls compile away.
+ */
+template <bool Enabled>
+class Counters;
+
+template <>
+class alignas(utils::constants::CACHE_LINE_SIZE) Counters<true> {
+  private:  // data members:
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(Counter::kCount)> values_{};
+
+  public:  // member functions:
+    void add(Counter counter, uint64_t count = 1) noexcept;  // owner only
+    WorkerStats snapshot() const noexcept;                    // any thread
+};
+
+template <>
+class Counters<false> {
+  public:  // member functions:
+    void add(Counter, uint64_t = 1) noexcept {}
+    WorkerStats snapshot() const noexcept {
+        return {};
+    }
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline WorkerStats& WorkerStats::operator+=(const WorkerStats& other) noexcept {
+    tasks_run += other.tasks_run;
+    lifo_hits += other.lifo_hits;
+    local_pops += other.local_pops;
+    global_pops += other.global_pops;
+    steal_attempts += other.steal_attempts;
+    steal_success += other.steal_success;
+    steal_empty += other.steal_empty;
+    steal_retry += other.steal_retry;
+    tasks_stolen += other.tasks_stolen;
+    parks += other.parks;
+    unparks += other.unparks;
+    offloads += other.offloads;
+    utilization += other.utilization;
+    return *this;
+}
+
+inline void Counters<true>::add(Counter counter, uint64_t count) noexcept {
+    auto& value = values_[static_cast<size_t>(counter)];
+    value.store(value.load(std::memory_order::relaxed) + count, std::memory_order::relaxed);
+}
+
+inline WorkerStats Counters<true>::snapshot() const noexcept {
+    auto get = [this](Counter counter) {
+        return values_[static_cast<size_t>(counter)].load(std::memory_order::relaxed);
+    };
+
+    WorkerStats stats;
+    stats.tasks_run = get(Counter::kTasksRun);
+    stats.lifo_hits = get(Counter::kLifoHits);
+    stats.local_pops = get(Counter::kLocalPops);
+    stats.global_pops = get(Counter::kGlobalPops);
+    stats.steal_attempts = get(Counter::kStealAttempts);
+    stats.steal_success = get(Counter::kStealSuccess);
+    stats.steal_empty = get(Counter::kStealEmpty);
+    stats.steal_retry = get(Counter::kStealRetry);
+    stats.tasks_stolen = get(Counter::kTasksStolen);
+    stats.parks = get(Counter::kParks);
+    stats.unparks = get(Counter::kUnparks);
+    stats.offloads = get(Counter::kOffloads);
+    return stats;
+}
+
+}  // namespace wr::stats
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "../utils/constants.hpp"
+#include "../utils/tsc.hpp"
+
+namespace wr::watchdog {
+
+/* What a worker is running, as seen by the watchdog */
+struct Running {
+    uint64_t started_at = 0;  // TSC, 0 => no task
+    const void* task = nullptr;
+    const void* entry = nullptr;  // `task::entry_of(task)`: names the task type in the report
+};
+
+/**
+ * @brief The current task of a worker for the watchdog (`Config::kWatchdogThresholdMs`).
+ *
+ *  >> `start` is the only hot-path cost: relaxed stores to a line of its own, no fence, no clear at the end
+ *     (the next task overwrites it, parking clears it)
+ *  >> the watchdog reads the stamp from another thread; it never dereferences the task
+ *
+ *  Disabled => an empty type with no-op members.
+ */
+template <bool Enabled>
+class TaskWatch;
+
+template <>
+class alignas(utils::constants::CACHE_LINE_SIZE) TaskWatch<true> {
+  private:  // data members:
+    std::atomic<uint64_t> started_at_ = 0;
+    std::atomic<const void*> task_ = nullptr;
+    std::atomic<const void*> entry_ = nullptr;
+
+  public:  // member functions:
+    void start(const void* task, const void* entry) noexcept;  // owner
+    void resume(const Running& running) noexcept;               // owner: back to a task which ran a nested one
+    void idle() noexcept;                                       // owner: about to park
+
+    Running running() const noexcept;  // any thread: the fields may be one task apart
+};
+
+template <>
+class TaskWatch<false> {
+  public:  // member functions:
+    void start(const void*, const void*) noexcept {}
+    void resume(const Running&) noexcept {}
+    void idle() noexcept {}
+
+    Running running() const noexcept {
+        return Running{};
+    }
+};
+
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+inline void TaskWatch<true>::start(const void* task, const void* entry) noexcept {
+    task_.store(task, std::memory_order::relaxed);
+    entry_.store(entry, std::memory_order::relaxed);
+    started_at_.store(utils::tsc::now(), std::memory_order::relaxed);
+}
+
+inline void TaskWatch<true>::resume(const Running& running) noexcept {
+    task_.store(running.task, std::memory_order::relaxed);
+    entry_.store(running.entry, std::memory_order::relaxed);
+    started_at_.store(running.started_at, std::memory_order::relaxed);
+}
+
+inline void TaskWatch<true>::idle() noexcept {
+    ///
+    started_at_.store(0, std::memory_order::relaxed);
+    ///
+}
+
+inline Running TaskWatch<true>::running() const noexcept {
+    ///
+    return Running{started_at_.load(std::memory_order::relaxed), task_.load(std::memory_order::relaxed),
+                   entry_.load(std::memory_order::relaxed)};
+    ///
+}
+
+}  // namespace wr::watchdog
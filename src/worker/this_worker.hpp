@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+namespace wr::this_worker {
+
+namespace detail {
+
+/* set by `Worker` for the lifetime of its thread */
+inline thread_local std::optional<size_t> index;
+
+}  // namespace detail
+
+/*
+ * @brief Index of the worker running on the current thread (nullopt for threads outside of executors).
+ */
+inline std::optional<size_t> index() noexcept {
+    ///
+    return detail::index;
+    ///
+}
+
+}  // namespace wr::this_worker
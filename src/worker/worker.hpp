@@ -2,12 +2,38 @@
 
 #include "../exec/config/concept.hpp"
 #include "../exec/config/config.hpp"
+#include "../exec/config/options.hpp"
+#include "../memory/arena.hpp"
+#include "../memory/block_pool.hpp"
+#include "../queues/inbox/inbox.hpp"
 #include "../queues/local/ws_queue.hpp"
+#include "../record/recorder.hpp"
+#include "../tasks/stamped_task.hpp"
+#include "../tasks/task_base.hpp"
+#include "../timer/timer_wheel.hpp"
+#include "../trace/trace_ring.hpp"
+#include "../utils/probes.hpp"
+#include "../utils/thread_name.hpp"
+#include "../utils/tsc.hpp"
+#include "cycles.hpp"
+#include "latency.hpp"
+#include "stats.hpp"
+#include "task_watch.hpp"
+#include "this_worker.hpp"
 
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <ntrusive/ntrusive.hpp>
 #include <optional>
 #include <random>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace wr {
@@ -16,17 +42,43 @@ namespace wr {
 template <task::Task TaskType, config::ExecutionConfig Config>
 class WsExecutor;
 
-template <task::Task TaskType, config::ExecutionConfig Config = config::DefaultConfig>
+template <task::Task TaskType = TaskBase, config::ExecutionConfig Config = config::DefaultConfig>
 class Worker {
   public:  // nested types:
     static constexpr size_t kCapacity = Config::kLocalQueueCapacity;
     static constexpr size_t kMaxLifoStreak = Config::kMaxLifoStreak;
     static constexpr size_t kFairnessPeriod = Config::kFairnessPeriod;
 
+    using Options = config::Options<Config>;
+
+    static constexpr size_t kPriorityLevels = Options::kPriorityLevels;
+    static constexpr size_t kAgingPeriod = Options::kPriorityAgingPeriod;
+    static constexpr size_t kMaxTaskGroups = Options::kMaxTaskGroups;
+    static constexpr uint64_t kNoAlarm = timer::TimerWheel::kNever;
+    static constexpr bool kEnableReactor = Options::kEnableReactor;
+    static constexpr bool kPushOverflow = Options::kOverflowPolicy == config::OverflowPolicy::kIdleWorker;
+    static constexpr bool kEnableStats = Options::kEnableStats;
+    static constexpr bool kEnableLatency = Options::kEnableLatency;
+    static constexpr bool kEnableTracing = Options::kEnableTracing;
+    static constexpr bool kEnableCycleAccounting = Options::kEnableCycleAccounting;
+    static constexpr bool kEnableWatchdog = Options::kWatchdogThresholdMs > 0;
+    static constexpr bool kEnableRecording = Options::kEnableRecording;
+
+    // `help` from inside a helped task: every level is one more frame of the worker's stack
+    static constexpr size_t kMaxHelpDepth = 4;
+
+    static_assert(!kEnableLatency || task::StampedTask<TaskType>,
+                  "kEnableLatency needs the enqueue timestamp: use WsExecutor<wr::StampedTask<TaskBase>, Config>");
+    static_assert(!kEnableTracing || std::has_single_bit(Options::kTraceCapacity),
+                  "kTraceCapacity must be a power of two");
+
+    static_assert(kPriorityLevels >= 1, "at least one priority level is required");
+
     using TaskPtr = TaskType*;
     using LocalQueue = queues::WorkStealingQueue<TaskType, kCapacity>;
     using StealHandle = queues::StealHandle<TaskType, kCapacity>;
     using LootType = queues::Loot<TaskType>;
+    using Inbox = queues::Inbox<TaskType, Options::kInboxCapacity>;
 
   private:  // data members:
     // We introduce a ownership relationship: the executor owns the Worker objects,
@@ -53,37 +105,809 @@ class Worker {
     uint64_t tick_ = 0;
 
     std::atomic<TaskType*> lifo_slot_ = nullptr;
+    size_t lifo_level_ = 0;  // priority of the task in the lifo slot
     size_t lifo_streak_ = 0;
 
-    LocalQueue local_queue_;
+    size_t help_depth_ = 0;  // tasks run by `help` on top of each other
+
+    // one deque per priority level (0 is the highest)
+    std::array<LocalQueue, kPriorityLevels> local_queues_;
+
+    // tasks targeted at this worker (`WsExecutor::submit_to`): drained before the local queue, never stolen
+    Inbox inbox_;
+    std::atomic<bool> parked_ = false;
+    std::atomic<bool> searching_ = false;  // stealing: a target for the overflow of the others
+
+    // deficit round robin over the injection queues: slot 0 is the work submitted outside of groups,
+    // slot `i` is the group `i - 1`. Every worker runs its own round => no shared scheduling state
+    size_t drr_cursor_ = 0;
+    std::array<size_t, kMaxTaskGroups + 1> drr_deficit_{};
 
     std::mt19937_64 rng_;
-    std::vector<StealHandle> victims_;
+    std::array<std::vector<StealHandle>, kPriorityLevels> victims_;  // per priority level
 
     std::atomic<bool> stop_flag_ = false;
 
+    // written by this worker only, read by `WsExecutor::stats` (an empty type when the stats are off)
+    [[no_unique_address]] stats::Counters<kEnableStats> stats_;
+    [[no_unique_address]] stats::LatencyRecorder<kEnableLatency> latency_;
+    [[no_unique_address]] trace::TraceRing<kEnableTracing> trace_{Options::kTraceCapacity};
+    [[no_unique_address]] stats::PhaseClock<kEnableCycleAccounting> cycles_{host_.workers_count()};
+    [[no_unique_address]] watchdog::TaskWatch<kEnableWatchdog> watch_;  // read by the watchdog thread
+    [[no_unique_address]] record::Recorder<kEnableRecording> recorder_;  // read after the worker has stopped
+
+    // storage for closure tasks spawned on this worker (see `tasks/closure.hpp`)
+    memory::BlockPool pool_;
+
+    // scratch memory for tasks: `this_worker::arena()`
+    memory::Arena arena_{Options::kArenaChunkSize, Options::kArenaHugePages};
+
+    std::thread thread_;
+
+    // Worker which runs on the current thread (nullptr for external threads).
+    // Used by the host to route `submit` from inside a task to the local queue.
+    static inline thread_local Worker* current_ = nullptr;
+
+  public:  // friendship declaration:
+    friend class WsExecutor<TaskType, Config>;
+
   public:  // member-functions:
     Worker(WsExecutor<TaskType, Config>& host, size_t worker_index);
 
     void start();  // auto-join;
     void stop();   // auto-join;
 
-    void push_task(TaskType* /*, SchedHint */) noexcept;
+    void push_task(TaskType* task, size_t priority) noexcept;
 
     std::optional<IntrusiveList<TaskType>> yawn_tasks(size_t requested_size);
     WsExecutor<TaskType, Config>& host() const;
 
+    size_t index() const noexcept;
+
+    // Runs one task of the executor if there is any (from inside a task: the arena is not reset).
+    // Used by producers which wait for room in the injection queues. False past `kMaxHelpDepth` nested calls.
+    bool help() noexcept;
+    bool may_help() const noexcept;
+
+    static Worker* current() noexcept;
+
   private:  // member-functions:
     [[nodiscard]] TaskPtr pick_task() noexcept;
 
     std::optional<TaskPtr> try_pick_fast() noexcept;
+    std::optional<TaskPtr> try_pick_aged() noexcept;
     std::optional<TaskPtr> try_steal_any() noexcept;
 
-    std::optional<TaskPtr> try_pop_lifo() noexcept;
-    std::optional<TaskPtr> try_pop_local() noexcept;
+    std::optional<TaskPtr> try_pop_inbox() noexcept;
+    std::optional<TaskPtr> try_pop_lifo(size_t level) noexcept;
+    std::optional<TaskPtr> try_pop_local(size_t level) noexcept;
     std::optional<TaskPtr> try_pop_global() noexcept;
+    std::optional<TaskPtr> try_pop_ungrouped() noexcept;
+    std::optional<TaskPtr> try_pop_slot(size_t slot) noexcept;
+    size_t slot_weight(size_t slot) const noexcept;
+
+    template <typename Queue>
+    std::optional<TaskPtr> try_take_injected(Queue& queue) noexcept;
+
+    void push_local(TaskType* task, size_t level) noexcept;
+
+    // the task enters the scheduler: its queue wait starts now (`kEnableLatency`)
+    static void stamp(TaskType* task) noexcept;
+
+    void run_task(TaskType* task) noexcept;
+
+    void push_inbox(TaskType* task) noexcept;  // any thread
+
+    // work pushing: the overflow goes to an idle worker; false if nobody is idle
+    bool try_hand_over(IntrusiveList<TaskType>&& batch, size_t batch_size) noexcept;
+    std::optional<TaskPtr> try_adopt_handoff() noexcept;
+
+    // becomes the timekeeper with `alarm` (published before the caller reads the deadline), false if
+    // another worker keeps time
+    bool try_keep_time(uint64_t alarm) noexcept;
+    void stop_keeping_time() noexcept;
+
+    // false if another worker is the poller
+    bool poll_reactor(bool may_block) noexcept
+        requires kEnableReactor;
+
+    bool has_global_work() const noexcept;
+
+    // position in `victims_` => index of the worker (the list skips this one)
+    uint32_t victim_index(size_t position) const noexcept;
 
     void work();  // run-loop;
 };
 
+/* ---------------------------------- IMPLEMENTATION ---------------------------------- */
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+Worker<TaskType, Config>::Worker(WsExecutor<TaskType, Config>& host, size_t worker_index)
+    : host_(host), worker_index_(worker_index), rng_(worker_index) {}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void Worker<TaskType, Config>::start() {
+    // All workers of the host are constructed at this point => victims can be collected:
+    for (auto& other : host_.workers_) {
+        if (other.get() != this) {
+            for (size_t level = 0; level < kPriorityLevels; ++level) {
+                victims_[level].push_back(other->local_queues_[level].create_stealer());
+            }
+        }
+    }
+
+    thread_ = std::thread([this] {
+        utils::set_thread_name(("wr-worker-" + std::to_string(worker_index_)).c_str());
+        current_ = this;
+        this_worker::detail::index = worker_index_;
+        memory::BlockPool::set_current(&pool_);
+        memory::Arena::set_current(&arena_);
+        work();
+        memory::Arena::set_current(nullptr);
+        memory::BlockPool::set_current(nullptr);
+        this_worker::detail::index.reset();
+        current_ = nullptr;
+    });
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void Worker<TaskType, Config>::stop() {
+    stop_flag_.store(true);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void Worker<TaskType, Config>::push_task(TaskType* task, size_t priority) noexcept {
+    stamp(task);
+    recorder_.submitted(task, static_cast<uint16_t>(worker_index_));
+
+    // The newest task goes to the LIFO slot (whatever its priority), the displaced one becomes stealable:
+    auto* displaced = lifo_slot_.exchange(task, std::memory_order::relaxed);
+    const size_t displaced_level = std::exchange(lifo_level_, priority);
+
+    if (displaced != nullptr) {
+        push_local(displaced, displaced_level);
+        host_.coordinator_.notify_worker();
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+WsExecutor<TaskType, Config>& Worker<TaskType, Config>::host() const {
+    ///
+    return host_;
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+size_t Worker<TaskType, Config>::index() const noexcept {
+    ///
+    return worker_index_;
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+Worker<TaskType, Config>* Worker<TaskType, Config>::current() noexcept {
+    ///
+    return current_;
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+bool Worker<TaskType, Config>::help() noexcept {
+    if (!may_help()) {
+        return false;
+    }
+    cycles_.lap(stats::Phase::kRunning);  // the calling task so far
+
+    auto task = try_pick_fast();
+    cycles_.lap(stats::Phase::kLocalPop);
+    if (!task) {
+        task = try_pop_global();
+        cycles_.lap(stats::Phase::kGlobalPoll);
+    }
+    if (!task) {
+        task = try_steal_any();
+        cycles_.lap(stats::Phase::kStealing);
+    }
+    if (!task) {
+        return false;
+    }
+
+    // the calling task is still running: the watchdog and the latency source are its own again afterwards
+    const auto caller = watch_.running();
+    const auto source = latency_.source();
+    ++help_depth_;
+    run_task(*task);
+    --help_depth_;
+    latency_.note_source(source);
+    watch_.resume(caller);
+    return true;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+bool Worker<TaskType, Config>::may_help() const noexcept {
+    ///
+    return help_depth_ < kMaxHelpDepth;  // the helped tasks help in turn: the stack would grow with the backlog
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto Worker<TaskType, Config>::pick_task() noexcept -> TaskPtr {
+    ++tick_;
+
+    // anti-starvation: from time to time the lowest non-empty priority level goes first
+    if constexpr (kPriorityLevels > 1 && kAgingPeriod > 0) {
+        if (tick_ % kAgingPeriod == 0) {
+            auto task = try_pick_aged();
+            cycles_.lap(stats::Phase::kLocalPop);
+            if (task) {
+                return *task;
+            }
+        }
+    }
+
+    // fairness: from time to time the injection queues go first (groups take turns, see `try_pop_global`)
+    if (tick_ % kFairnessPeriod == 0) {
+        host_.poll_timers();  // busy workers keep the timers going too
+        if constexpr (kEnableReactor) {
+            poll_reactor(/*may_block=*/false);
+        }
+
+        auto task = try_pop_global();
+        cycles_.lap(stats::Phase::kGlobalPoll);
+        if (task) {
+            return *task;
+        }
+    }
+
+    while (true) {
+        auto task = try_pick_fast();
+        cycles_.lap(stats::Phase::kLocalPop);
+        if (task) {
+            return *task;
+        }
+
+        task = try_pop_global();
+        cycles_.lap(stats::Phase::kGlobalPoll);
+        if (task) {
+            return *task;
+        }
+
+        auto directive = host_.coordinator_.ask_to_steal();
+        cycles_.lap(stats::Phase::kCoordinator);
+
+        if (directive.should_terminate()) {
+            return nullptr;
+        }
+
+        if (directive.should_retry()) {
+            continue;
+        }
+
+        if (directive.should_steal()) {
+            auto permit = std::move(directive).unwrap_permit();
+            if constexpr (kPushOverflow) {
+                searching_.store(true, std::memory_order::relaxed);
+            }
+            task = try_steal_any();
+            if constexpr (kPushOverflow) {
+                searching_.store(false, std::memory_order::relaxed);
+            }
+            cycles_.lap(stats::Phase::kStealing);
+            if (task) {
+                return *task;
+            }
+            // nothing to steal => give the permit back and fall asleep
+        }
+
+        // expired timers are work: inject them instead of parking
+        const size_t expired = host_.poll_timers();
+        cycles_.lap(stats::Phase::kGlobalPoll);
+        if (expired > 0) {
+            continue;
+        }
+
+        // the first idle worker sleeps in epoll instead of the condvar
+        if constexpr (kEnableReactor) {
+            const bool polled = poll_reactor(/*may_block=*/true);
+            cycles_.lap(stats::Phase::kParked);
+            if (polled) {
+                continue;
+            }
+        }
+
+        // `parked_` is published before the wake condition is checked (pairs with `push_inbox`)
+        parked_.store(true);
+        watch_.idle();
+        stats_.add(stats::Counter::kParks);
+        trace_.record(trace::EventType::kPark);
+        WR_PROBE1(park, worker_index_);
+
+        // one parked worker keeps time: it sleeps until the next deadline, the others sleep until notified.
+        // Its alarm is published before the wake condition reads the deadline (pairs with `submit_at`)
+        const uint64_t alarm = host_.timers_.next_deadline();
+        if (try_keep_time(alarm)) {
+            host_.coordinator_.park_worker_until(worker_index_, host_.timers_.time_of(alarm), [this, alarm] {
+                return !inbox_.empty() || has_global_work() || host_.timers_.next_deadline() < alarm;
+            });
+            stop_keeping_time();
+
+            // woken up for other work before the alarm => pass the duty on to another sleeper
+            // (woken up for an earlier timer => this worker parks again with the new alarm)
+            const uint64_t next = host_.timers_.next_deadline();
+            if (next != kNoAlarm && next >= alarm && !host_.timers_.due()) {
+                host_.coordinator_.notify_worker();
+            }
+        } else {
+            host_.coordinator_.park_worker(worker_index_, [this] {
+                return !inbox_.empty() || has_global_work();
+            });
+        }
+        parked_.store(false, std::memory_order::relaxed);
+        stats_.add(stats::Counter::kUnparks);
+        trace_.record(trace::EventType::kUnpark);
+        WR_PROBE1(unpark, worker_index_);
+        cycles_.lap(stats::Phase::kParked);
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto Worker<TaskType, Config>::try_pick_fast() noexcept -> std::optional<TaskPtr> {
+    if (auto task = try_pop_inbox()) {
+        return task;
+    }
+    if constexpr (kPushOverflow) {
+        if (auto task = try_adopt_handoff()) {
+            return task;
+        }
+    }
+
+    for (size_t level = 0; level < kPriorityLevels; ++level) {
+        if (auto task = try_pop_lifo(level)) {
+            return task;
+        }
+        if (auto task = try_pop_local(level)) {
+            return task;
+        }
+
+        // strict priorities: injected work of a level goes before the local work of the lower ones
+        // (the lowest level keeps the usual order, its global queue is polled by `pick_task`)
+        if (level + 1 < kPriorityLevels && host_.global_queues_[level].maybe_non_empty()) {
+            if (auto task = try_take_injected(host_.global_queues_[level])) {
+                return task;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto Worker<TaskType, Config>::try_pick_aged() noexcept -> std::optional<TaskPtr> {
+    for (size_t level = kPriorityLevels - 1; level > 0; --level) {
+        if (auto task = try_pop_local(level)) {
+            return task;
+        }
+        if (host_.global_queues_[level].maybe_non_empty()) {
+            if (auto task = try_take_injected(host_.global_queues_[level])) {
+                return task;
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto Worker<TaskType, Config>::try_steal_any() noexcept -> std::optional<TaskPtr> {
+    const size_t count = victims_[0].size();
+    if (count == 0) {
+        return std::nullopt;
+    }
+
+    const size_t start = rng_() % count;
+
+    // the high-priority deques of all the victims are looked at before the low-priority ones
+    for (size_t level = 0; level < kPriorityLevels; ++level) {
+        // the second round only happens if someone has interrupted us during the first one
+        for (size_t round = 0; round < 2; ++round) {
+            bool contended = false;
+
+            for (size_t i = 0; i < count; ++i) {
+                auto& victim = victims_[level][(start + i) % count];
+                size_t stolen = 0;
+                auto loot = victim.steal_batch_and_pop(local_queues_[level], &stolen);
+                cycles_.lap_steal(victim_index((start + i) % count));
+
+                stats_.add(stats::Counter::kStealAttempts);
+                if (loot.success()) {
+                    stats_.add(stats::Counter::kStealSuccess);
+                    stats_.add(stats::Counter::kTasksStolen, stolen);
+                    latency_.note_source(stats::Source::kStolen);
+                    trace_.record(trace::EventType::kSteal, victim_index((start + i) % count),
+                                  static_cast<uint16_t>(std::min<size_t>(stolen, UINT16_MAX)));
+                    WR_PROBE3(steal, worker_index_, victim_index((start + i) % count), stolen);
+                    return std::move(loot).unwrap();
+                }
+                stats_.add(loot.retry() ? stats::Counter::kStealRetry : stats::Counter::kStealEmpty);
+                contended |= loot.retry();
+            }
+
+            if (!contended) {
+                break;
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto Worker<TaskType, Config>::try_pop_inbox() noexcept -> std::optional<TaskPtr> {
+    auto task = inbox_.try_pop();
+    if (task) {
+        latency_.note_source(stats::Source::kInbox);
+    }
+    return task;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto Worker<TaskType, Config>::try_pop_lifo(size_t level) noexcept -> std::optional<TaskPtr> {
+    if (level != lifo_level_) {
+        return std::nullopt;
+    }
+
+    // LIFO slot may starve the local queue (ping-pong tasks) => limit the streak
+    if (lifo_streak_ >= kMaxLifoStreak) {
+        lifo_streak_ = 0;
+        return std::nullopt;
+    }
+
+    auto* task = lifo_slot_.exchange(nullptr, std::memory_order::relaxed);
+    if (task == nullptr) {
+        return std::nullopt;
+    }
+
+    ++lifo_streak_;
+    stats_.add(stats::Counter::kLifoHits);
+    latency_.note_source(stats::Source::kLifo);
+    return task;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto Worker<TaskType, Config>::try_pop_local(size_t level) noexcept -> std::optional<TaskPtr> {
+    if (level != lifo_level_) {
+        auto task = local_queues_[level].try_pop();
+        if (task) {
+            stats_.add(stats::Counter::kLocalPops);
+            latency_.note_source(stats::Source::kLocal);
+        }
+        return task;
+    }
+
+    lifo_streak_ = 0;
+    if (auto task = local_queues_[level].try_pop()) {
+        stats_.add(stats::Counter::kLocalPops);
+        latency_.note_source(stats::Source::kLocal);
+        return task;
+    }
+
+    // LIFO slot was skipped because of the streak limit, but local queue is empty:
+    if (auto* task = lifo_slot_.exchange(nullptr, std::memory_order::relaxed)) {
+        stats_.add(stats::Counter::kLifoHits);
+        latency_.note_source(stats::Source::kLifo);
+        return task;
+    }
+    return std::nullopt;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto Worker<TaskType, Config>::try_pop_global() noexcept -> std::optional<TaskPtr> {
+    if constexpr (kMaxTaskGroups == 0) {
+        return try_pop_ungrouped();
+    } else {
+        const size_t slots = 1 + host_.groups_count_.load(std::memory_order::acquire);
+
+        // the slot under the cursor spends its deficit (one per task); an exhausted or empty slot passes
+        // the turn, and the next one is credited with its weight. An empty slot loses its credit (DRR)
+        // => one full round (+ the current slot) visits every slot with a positive deficit
+        for (size_t step = 0; step <= slots; ++step) {
+            if (drr_deficit_[drr_cursor_] > 0) {
+                if (auto task = try_pop_slot(drr_cursor_)) {
+                    --drr_deficit_[drr_cursor_];
+                    return task;
+                }
+                drr_deficit_[drr_cursor_] = 0;
+            }
+            drr_cursor_ = (drr_cursor_ + 1) % slots;
+            drr_deficit_[drr_cursor_] += slot_weight(drr_cursor_);
+        }
+        return std::nullopt;
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto Worker<TaskType, Config>::try_pop_ungrouped() noexcept -> std::optional<TaskPtr> {
+    for (auto& queue : host_.global_queues_) {
+        // several levels => do not lock the ones which are most likely empty
+        if constexpr (kPriorityLevels > 1) {
+            if (!queue.maybe_non_empty()) {
+                continue;
+            }
+        }
+        if (auto task = try_take_injected(queue)) {
+            return task;
+        }
+    }
+    return std::nullopt;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto Worker<TaskType, Config>::try_pop_slot(size_t slot) noexcept -> std::optional<TaskPtr> {
+    if (slot == 0) {
+        return try_pop_ungrouped();
+    }
+
+    auto& group = host_.groups_[slot - 1];
+    if (!group.maybe_non_empty()) {
+        return std::nullopt;
+    }
+    return try_take_injected(group);
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+size_t Worker<TaskType, Config>::slot_weight(size_t slot) const noexcept {
+    ///
+    return slot == 0 ? Options::kDefaultGroupWeight : host_.groups_[slot - 1].weight();
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+template <typename Queue>
+auto Worker<TaskType, Config>::try_take_injected(Queue& queue) noexcept -> std::optional<TaskPtr> {
+    auto task = queue.try_pop();
+    if (task) {
+        host_.on_taken();
+        stats_.add(stats::Counter::kGlobalPops);
+        latency_.note_source(stats::Source::kGlobal);
+        trace_.record(trace::EventType::kGlobalPop);
+        WR_PROBE1(global_pop, worker_index_);
+    }
+    return task;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void Worker<TaskType, Config>::push_local(TaskType* task, size_t level) noexcept {
+    auto& local_queue = local_queues_[level];
+    if (local_queue.try_push(task)) {
+        return;
+    }
+
+    // local queue is full => move half of it to the global queue of the same level
+    size_t offloaded = 0;
+    if (auto batch = local_queue.offload_half(&offloaded)) {
+        stats_.add(stats::Counter::kOffloads);
+        trace_.record(trace::EventType::kOffload, 0, static_cast<uint16_t>(std::min<size_t>(offloaded, UINT16_MAX)));
+        // priorities: a handoff is adopted at the default level => only the single-level pools push
+        bool handed_over = false;
+        if constexpr (kPushOverflow && kPriorityLevels == 1) {
+            handed_over = try_hand_over(std::move(*batch), offloaded);
+        }
+        if (!handed_over) {
+            host_.on_injected(offloaded);
+            host_.global_queues_[level].push_batch(std::move(*batch), offloaded);
+        }
+        if (local_queue.try_push(task)) {
+            return;
+        }
+    }
+
+    // thieves have interrupted offloading
+    host_.on_injected(1);
+    host_.global_queues_[level].push(task);
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void Worker<TaskType, Config>::stamp(TaskType* task) noexcept {
+    if constexpr (kEnableLatency) {
+        task->set_enqueued_at(utils::tsc::now());
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void Worker<TaskType, Config>::run_task(TaskType* task) noexcept {
+    trace_.record(trace::EventType::kTaskBegin);
+    const uint64_t started_at = latency_.begin(task);
+    watch_.start(task, task::entry_of(*task));
+    const uint64_t recorded_at = recorder_.begin();
+    task->run();
+    recorder_.ran(task, static_cast<uint16_t>(worker_index_), recorded_at);
+    latency_.end(started_at);
+    trace_.record(trace::EventType::kTaskEnd);
+    cycles_.lap(stats::Phase::kRunning);
+    stats_.add(stats::Counter::kTasksRun);
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void Worker<TaskType, Config>::push_inbox(TaskType* task) noexcept {
+    inbox_.push(task);
+
+    // Dekker-style handshake with the parking worker: either it sees the task in its wake condition,
+    // or we see it parked and wake it up (it alone: the others cannot run the task)
+    std::atomic_thread_fence(std::memory_order::seq_cst);
+    if (parked_.load(std::memory_order::relaxed)) {
+        host_.coordinator_.wake_worker(worker_index_);
+    }
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+bool Worker<TaskType, Config>::try_hand_over(IntrusiveList<TaskType>&& batch, size_t batch_size) noexcept {
+    const size_t count = host_.workers_.size();
+    const size_t start = rng_() % count;
+
+    for (size_t i = 0; i < count; ++i) {
+        auto& other = *host_.workers_[(start + i) % count];
+        if (&other == this || other.inbox_.has_handoff()) {
+            continue;  // one pending batch per worker: it has enough to do
+        }
+        if (!other.parked_.load(std::memory_order::relaxed) && !other.searching_.load(std::memory_order::relaxed)) {
+            continue;
+        }
+
+        other.inbox_.push_batch(std::move(batch), batch_size);
+
+        // the same handshake as `push_inbox`: either it sees the batch, or we see it parked (and wake it alone)
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+        if (other.parked_.load(std::memory_order::relaxed)) {
+            host_.coordinator_.wake_worker(other.worker_index_);
+        }
+        return true;
+    }
+    return false;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+auto Worker<TaskType, Config>::try_adopt_handoff() noexcept -> std::optional<TaskPtr> {
+    auto batch = inbox_.try_take_handoff();
+    if (!batch) {
+        return std::nullopt;
+    }
+
+    // into the local queue: the batch stays stealable
+    std::optional<TaskPtr> first;
+    while (!batch->empty()) {
+        std::optional<TaskPtr> task = batch->try_pop_front();
+        if (!first) {
+            first = task;
+        } else {
+            push_local(*task, 0);
+        }
+    }
+    host_.coordinator_.notify_worker();  // more than we can run at once => let the others steal
+    latency_.note_source(stats::Source::kLocal);
+    return first;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+bool Worker<TaskType, Config>::try_keep_time(uint64_t alarm) noexcept {
+    uint64_t no_alarm = kNoAlarm;
+    if (alarm == kNoAlarm || !host_.timekeeper_deadline_.compare_exchange_strong(no_alarm, alarm)) {
+        return false;
+    }
+    host_.timekeeper_.store(worker_index_);  // before the wake condition is checked (pairs with `submit_at`)
+    return true;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void Worker<TaskType, Config>::stop_keeping_time() noexcept {
+    ///
+    host_.timekeeper_deadline_.store(kNoAlarm);  // the index is left as is: the next timekeeper overwrites it
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+bool Worker<TaskType, Config>::poll_reactor(bool may_block) noexcept
+    requires kEnableReactor
+{
+    auto& reactor = *host_.reactor_;
+    if (!reactor.try_acquire_poller()) {
+        return false;
+    }
+
+    int timeout_ms = 0;
+    uint64_t alarm = kNoAlarm;
+
+    if (may_block) {
+        timeout_ms = -1;
+
+        // the poller keeps time if nobody does: epoll_wait times out at the next deadline
+        const uint64_t next = host_.timers_.next_deadline();
+        if (try_keep_time(next)) {
+            alarm = next;
+            const auto left = host_.timers_.time_of(alarm) - std::chrono::steady_clock::now();
+            const auto left_ms = std::chrono::ceil<std::chrono::milliseconds>(left).count();
+            timeout_ms = static_cast<int>(std::max<decltype(left_ms)>(left_ms, 0));
+        }
+        parked_.store(true);
+        watch_.idle();
+        stats_.add(stats::Counter::kParks);
+        trace_.record(trace::EventType::kPark);
+        WR_PROBE1(park, worker_index_);
+    }
+
+    const size_t ready = reactor.wait(
+        timeout_ms,
+        [this, alarm] {
+            if (host_.coordinator_.should_shutdown() || !inbox_.empty() || has_global_work()) {
+                return true;
+            }
+            // without an alarm of its own the poller returns only for timers which nobody keeps: the ones
+            // of another timekeeper are not its business (it would spin until their deadline)
+            const uint64_t next = host_.timers_.next_deadline();
+            return alarm != kNoAlarm ? next < alarm
+                                     : next != kNoAlarm && host_.timekeeper_deadline_.load() == kNoAlarm;
+        },
+        [this](TaskType* task) {
+            // queued locally in one go: this worker runs them, the others steal
+            stamp(task);
+            recorder_.submitted(task, static_cast<uint16_t>(worker_index_));
+            push_local(task, kPriorityLevels - 1);  // the default priority
+        });
+
+    if (may_block) {
+        parked_.store(false, std::memory_order::relaxed);
+        stats_.add(stats::Counter::kUnparks);
+        trace_.record(trace::EventType::kUnpark);
+        WR_PROBE1(unpark, worker_index_);
+        if (alarm != kNoAlarm) {
+            stop_keeping_time();
+        }
+    }
+    reactor.release_poller();
+
+    if (ready > 1) {
+        host_.coordinator_.notify_worker();
+    }
+    return true;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+uint32_t Worker<TaskType, Config>::victim_index(size_t position) const noexcept {
+    ///
+    return static_cast<uint32_t>(position < worker_index_ ? position : position + 1);
+    ///
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+bool Worker<TaskType, Config>::has_global_work() const noexcept {
+    for (const auto& queue : host_.global_queues_) {
+        if (!queue.empty()) {
+            return true;
+        }
+    }
+
+    if constexpr (kMaxTaskGroups > 0) {
+        const size_t groups = host_.groups_count_.load(std::memory_order::acquire);
+        for (size_t group = 0; group < groups; ++group) {
+            if (!host_.groups_[group].empty()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template <task::Task TaskType, config::ExecutionConfig Config>
+void Worker<TaskType, Config>::work() {
+    cycles_.start();
+    while (auto* task = pick_task()) {
+        run_task(task);
+
+        if constexpr (Options::kArenaResetPerTask) {
+            arena_.reset();
+        }
+    }
+    watch_.idle();
+}
+
 };  // namespace wr
@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <thread>
 #include <vector>
 
+#include "coordination/admission.hpp"
 #include "coordination/coordinator.hpp"
 
 using namespace std::chrono_literals;
@@ -72,7 +74,7 @@ TEST_F(CoordinatorTest, ThreadParkingAndWakeup) {
     std::atomic<bool> thread_woke_up = false;
 
     std::thread worker([&]() {
-        coord.park_worker();
+        coord.park_worker(0);
         thread_woke_up = true;
     });
 
@@ -105,8 +107,8 @@ TEST_F(CoordinatorTest, ShutdownWakesUpAllParkedThreads) {
     std::vector<std::thread> threads;
 
     for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&]() {
-            coord.park_worker();
+        threads.emplace_back([&, i]() {
+            coord.park_worker(i);
             awoken_count++;
         });
     }
@@ -123,6 +125,32 @@ TEST_F(CoordinatorTest, ShutdownWakesUpAllParkedThreads) {
     EXPECT_EQ(awoken_count.load(), num_threads);
 }
 
+TEST_F(CoordinatorTest, WakeWorkerIsTargeted) {
+    wr::coord::Coordinator coord(4);
+    std::atomic<bool> woke[2] = {false, false};
+
+    std::thread first([&] {
+        coord.park_worker(0);
+        woke[0] = true;
+    });
+    std::thread second([&] {
+        coord.park_worker(1);
+        woke[1] = true;
+    });
+
+    wait_a_bit();
+    coord.wake_worker(1);
+    second.join();
+    EXPECT_TRUE(woke[1].load());
+
+    wait_a_bit();
+    EXPECT_FALSE(woke[0].load());
+
+    coord.shutdown();
+    first.join();
+    EXPECT_TRUE(woke[0].load());
+}
+
 TEST_F(CoordinatorTest, UnwrapPermitWorks) {
     wr::coord::Coordinator coord(2);
 
@@ -134,3 +162,51 @@ TEST_F(CoordinatorTest, UnwrapPermitWorks) {
     auto dir_fail = coord.ask_to_steal();
     EXPECT_TRUE(dir_fail.should_park());
 }
+
+TEST(AdmissionTest, CapacityAndWatermarks) {
+    wr::coord::Admission</*Capacity=*/8, /*HighWatermark=*/6, /*LowWatermark=*/2> admission;
+
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(admission.try_acquire());
+        EXPECT_EQ(admission.overloaded(), i + 1 >= 6);
+    }
+    EXPECT_FALSE(admission.try_acquire());
+    EXPECT_FALSE(admission.has_room());
+
+    // unconditional: counted even beyond the capacity
+    admission.acquire(2);
+    EXPECT_EQ(admission.size(), 10u);
+
+    // hysteresis: stays on until the low watermark
+    while (admission.size() > 3) {
+        admission.release();
+        EXPECT_TRUE(admission.overloaded());
+    }
+    admission.release();
+    EXPECT_FALSE(admission.overloaded());
+
+    // ... and turns on again only at the high one
+    admission.acquire(3);
+    EXPECT_FALSE(admission.overloaded());
+    admission.acquire(1);
+    EXPECT_TRUE(admission.overloaded());
+}
+
+TEST(AdmissionTest, WaitForRoom) {
+    wr::coord::Admission<4, 3, 1> admission;
+    admission.acquire(4);
+
+    std::atomic<bool> admitted = false;
+    std::thread producer([&] {
+        admission.wait_for_room();
+        admitted.store(admission.try_acquire());
+    });
+
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(admitted.load());
+
+    admission.release();
+    producer.join();
+    EXPECT_TRUE(admitted.load());
+    EXPECT_EQ(admission.size(), 4u);
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "exec/executor.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+using wr::test::Gate;
+
+// -------------------- Test prerequisites --------------------
+
+struct BoundedConfig : wr::test::SmallQueueConfig {
+    static constexpr size_t kInjectionCapacity = 32;
+    static constexpr size_t kInjectionHighWatermark = 24;
+    static constexpr size_t kInjectionLowWatermark = 8;
+};
+
+using BoundedExecutor = wr::WsExecutor<wr::TaskBase, BoundedConfig>;
+using BoundedWorker = wr::Worker<wr::TaskBase, BoundedConfig>;
+
+struct Tick : wr::TaskBase {
+    std::atomic<size_t>* counter = nullptr;
+
+    Tick() : wr::TaskBase(&Tick::trampoline) {}
+
+    static void trampoline(wr::TaskBase* self) noexcept {
+        static_cast<Tick*>(self)->counter->fetch_add(1);
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST(AdmissionTest, TrySubmitReportsSaturation) {
+    BoundedExecutor executor(1);
+    std::atomic<size_t> done = 0;
+    std::vector<Tick> ticks(BoundedConfig::kInjectionCapacity + 1);
+    for (auto& tick : ticks) {
+        tick.counter = &done;
+    }
+
+    Gate gate;
+    gate.close(executor);
+    EXPECT_EQ(executor.injected(), 0u);
+
+    for (size_t i = 0; i < BoundedConfig::kInjectionCapacity; ++i) {
+        EXPECT_TRUE(executor.try_submit(&ticks[i]));
+    }
+    EXPECT_FALSE(executor.try_submit(&ticks.back()));
+    EXPECT_EQ(executor.injected(), BoundedConfig::kInjectionCapacity);
+    EXPECT_TRUE(executor.overloaded());
+
+    gate.open();
+    ASSERT_TRUE(eventually([&] { return done.load() == BoundedConfig::kInjectionCapacity; }));
+    EXPECT_EQ(executor.injected(), 0u);
+    EXPECT_FALSE(executor.overloaded());
+
+    EXPECT_TRUE(executor.try_submit(&ticks.back()));
+    ASSERT_TRUE(eventually([&] { return done.load() == ticks.size(); }));
+}
+
+TEST(AdmissionTest, PlainSubmitTakesRoom) {
+    BoundedExecutor executor(1);
+    std::atomic<size_t> done = 0;
+    Tick tick;
+    tick.counter = &done;
+
+    Gate gate;
+    gate.close(executor);
+
+    // never refused, but counted
+    for (size_t i = 0; i < BoundedConfig::kInjectionCapacity + 10; ++i) {
+        executor.submit([&] { done.fetch_add(1); });
+    }
+    EXPECT_EQ(executor.injected(), BoundedConfig::kInjectionCapacity + 10);
+    EXPECT_FALSE(executor.try_submit(&tick));
+
+    gate.open();
+    ASSERT_TRUE(eventually([&] { return done.load() == BoundedConfig::kInjectionCapacity + 10; }));
+    EXPECT_EQ(executor.injected(), 0u);
+}
+
+TEST(AdmissionTest, SubmitBoundedWaitsOutside) {
+    BoundedExecutor executor(1);
+    std::atomic<size_t> done = 0;
+
+    Gate gate;
+    gate.close(executor);
+    for (size_t i = 0; i < BoundedConfig::kInjectionCapacity; ++i) {
+        executor.submit([&] { done.fetch_add(1); });
+    }
+
+    std::atomic<bool> submitted = false;
+    std::thread producer([&] {
+        executor.submit_bounded([&] { done.fetch_add(1); });
+        submitted.store(true);
+    });
+
+    std::this_thread::sleep_for(20ms);
+    EXPECT_FALSE(submitted.load());
+
+    gate.open();
+    producer.join();
+    EXPECT_TRUE(submitted.load());
+    ASSERT_TRUE(eventually([&] { return done.load() == BoundedConfig::kInjectionCapacity + 1; }));
+}
+
+TEST(AdmissionTest, SubmitBoundedHelpsOnWorker) {
+    constexpr size_t kTasks = 10000;
+
+    BoundedExecutor executor(2);
+    std::atomic<size_t> done = 0;
+    std::atomic<size_t> peak = 0;
+
+    // a worker floods the pool: local overflow fills the injection queues, the producer has to help
+    executor.submit([&] {
+        for (size_t i = 0; i < kTasks; ++i) {
+            executor.submit_bounded([&] {
+                size_t queued = executor.injected();
+                size_t seen = peak.load();
+                while (queued > seen && !peak.compare_exchange_weak(seen, queued)) {
+                }
+                done.fetch_add(1);
+            });
+        }
+    });
+
+    ASSERT_TRUE(eventually([&] { return done.load() == kTasks; }));
+    // one overflow (half of the local queue) may go over the capacity
+    EXPECT_LE(peak.load(), BoundedConfig::kInjectionCapacity + BoundedConfig::kLocalQueueCapacity);
+    EXPECT_TRUE(eventually([&] { return executor.injected() == 0; }));
+}
+
+TEST(AdmissionTest, NestedWaitsAreCapped) {
+    constexpr size_t kProducers = 64;  // twice the capacity: a producer helps by running the next one
+    constexpr size_t kPerProducer = 8;
+
+    BoundedExecutor executor(1);
+    std::atomic<size_t> done = 0;
+    std::atomic<size_t> depth = 0;
+    std::atomic<size_t> deepest = 0;
+
+    Gate gate;
+    gate.close(executor);
+    for (size_t p = 0; p < kProducers; ++p) {
+        executor.submit([&] {
+            const size_t mine = depth.fetch_add(1) + 1;
+            size_t seen = deepest.load();
+            while (mine > seen && !deepest.compare_exchange_weak(seen, mine)) {
+            }
+            for (size_t i = 0; i < kPerProducer; ++i) {
+                executor.submit_bounded([&] { done.fetch_add(1); });
+            }
+            depth.fetch_sub(1);
+        });
+    }
+    gate.open();
+
+    ASSERT_TRUE(eventually([&] { return done.load() == kProducers * kPerProducer; }));
+    // the producer picked by the worker + one per nested `help`
+    EXPECT_LE(deepest.load(), BoundedWorker::kMaxHelpDepth + 1);
+}
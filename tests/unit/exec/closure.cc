@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "exec/executor.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+
+// -------------------- Test prerequisites --------------------
+
+struct FnTask : IntrusiveListNode {
+    using RunFn = void (*)(FnTask*) noexcept;
+
+    RunFn run_fn;
+
+    explicit FnTask(RunFn fn) : run_fn(fn) {}
+
+    void run() noexcept {
+        run_fn(this);
+    }
+};
+
+using ClosureExecutor = wr::WsExecutor<FnTask>;
+
+// -------------------- Tests --------------------
+
+TEST(ClosureTest, SubmitLambdaFromOutside) {
+    std::atomic<int> counter = 0;
+
+    ClosureExecutor executor(4);
+    for (int i = 0; i < 1000; ++i) {
+        executor.submit([&counter] {
+            counter.fetch_add(1);
+        });
+    }
+
+    EXPECT_TRUE(eventually([&] { return counter.load() == 1000; }));
+}
+
+TEST(ClosureTest, NestedSubmitsUseWorkerPools) {
+    constexpr int kChildren = 100;
+    constexpr int kGrandChildren = 100;
+
+    std::atomic<int> counter = 0;
+    ClosureExecutor executor(4);
+
+    executor.submit([&] {
+        for (int i = 0; i < kChildren; ++i) {
+            executor.submit([&] {
+                for (int j = 0; j < kGrandChildren; ++j) {
+                    executor.submit([&] {
+                        counter.fetch_add(1);
+                    });
+                }
+            });
+        }
+    });
+
+    EXPECT_TRUE(eventually([&] { return counter.load() == kChildren * kGrandChildren; }));
+}
+
+TEST(ClosureTest, LargeCapturesAndDestruction) {
+    std::atomic<int> sum = 0;
+    auto alive = std::make_shared<int>(0);
+
+    {
+        ClosureExecutor executor(2);
+        std::array<int, 512> payload{};  // does not fit into any size class
+        payload[511] = 7;
+
+        executor.submit([&sum, payload, alive] {
+            sum.fetch_add(payload[511]);
+        });
+
+        EXPECT_TRUE(eventually([&] { return sum.load() == 7; }));
+    }
+
+    // the closure (and its captures) are destroyed after the call
+    EXPECT_TRUE(eventually([&] { return alive.use_count() == 1; }));
+}
+
+TEST(ClosureTest, TasksUseWorkerArena) {
+    std::atomic<int> done = 0;
+    std::atomic<int> reused = 0;
+
+    ClosureExecutor executor(1);
+    for (int i = 0; i < 100; ++i) {
+        executor.submit([&] {
+            auto& arena = wr::this_worker::arena();
+
+            // arena is rewound after every task => every task starts from the same spot
+            static thread_local void* first = nullptr;
+            void* ptr = arena.allocate(64);
+            if (first == nullptr) {
+                first = ptr;
+            }
+            reused.fetch_add(ptr == first ? 1 : 0);
+
+            std::vector<int, wr::memory::ArenaAllocator<int>> scratch{wr::memory::ArenaAllocator<int>(arena)};
+            scratch.resize(1000, 1);
+            done.fetch_add(1);
+        });
+    }
+
+    EXPECT_TRUE(eventually([&] { return done.load() == 100; }));
+    EXPECT_EQ(reused.load(), 100);
+}
+
+TEST(ClosureTest, ClosuresOutliveTheSubmittingExecutor) {
+    constexpr int kTasks = 1000;
+    std::atomic<int> done = 0;
+
+    ClosureExecutor second(1);
+    wr::test::Gate gate;
+    gate.close(second);
+    {
+        ClosureExecutor first(1);
+        std::atomic<bool> submitted = false;
+        first.submit([&] {
+            for (int i = 0; i < kTasks; ++i) {
+                second.submit([&done] { done.fetch_add(1); });
+            }
+            submitted.store(true);
+        });
+        ASSERT_TRUE(eventually([&] { return submitted.load(); }));
+    }  // the workers of `first` and their pools are gone, the closures wait on `second`
+
+    gate.open();
+    ASSERT_TRUE(eventually([&] { return done.load() == kTasks; }));
+}
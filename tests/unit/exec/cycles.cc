@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+
+#include "exec/executor.hpp"
+#include "worker/this_worker.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+using wr::test::busy_for;
+
+// -------------------- Test prerequisites --------------------
+
+struct AccountingConfig : wr::test::SmallQueueConfig {
+    static constexpr bool kEnableCycleAccounting = true;  // without kEnableStats: the counters stay 0
+};
+
+using AccountingExecutor = wr::WsExecutor<wr::TaskBase, AccountingConfig>;
+using wr::stats::Phase;
+
+// off by default and then no timestamps are taken
+static_assert(std::is_empty_v<wr::stats::PhaseClock<false>>);
+static_assert(!wr::WsExecutor<>::kEnableCycleAccounting);
+
+double ms_of(const wr::stats::Snapshot& stats, const wr::stats::Utilization& utilization, Phase phase) {
+    return static_cast<double>(utilization.of(phase)) * stats.ns_per_cycle / 1e6;
+}
+
+// -------------------- Tests --------------------
+
+TEST(CyclesTest, RunningTasksAreWork) {
+    constexpr size_t kTasks = 10;
+
+    AccountingExecutor executor(1);
+    std::atomic<size_t> done = 0;
+    for (size_t i = 0; i < kTasks; ++i) {
+        executor.submit([&] {
+            busy_for(2ms);
+            done.fetch_add(1);
+        });
+    }
+
+    ASSERT_TRUE(eventually([&] { return done.load() == kTasks; }));
+    // the running phase is charged right after `run` returns
+    ASSERT_TRUE(eventually([&] {
+        auto stats = executor.stats();
+        return ms_of(stats, stats.total.utilization, Phase::kRunning) >= 15.0;
+    }));
+
+    auto stats = executor.stats();
+    EXPECT_EQ(stats.total.tasks_run, 0u);  // kEnableStats is off
+    EXPECT_GT(stats.total.utilization.of(Phase::kGlobalPoll), 0u);
+    ASSERT_EQ(stats.total.utilization.steal_cycles.size(), 1u);
+    EXPECT_EQ(stats.total.utilization.steal_cycles[0], 0u);  // nobody to steal from
+}
+
+TEST(CyclesTest, IdleTimeIsParked) {
+    AccountingExecutor executor(1);
+    std::this_thread::sleep_for(30ms);
+
+    // a park is charged when it ends
+    std::atomic<bool> done = false;
+    executor.submit([&] { done.store(true); });
+    ASSERT_TRUE(eventually([&] { return done.load(); }));
+
+    auto stats = executor.stats();
+    EXPECT_GE(ms_of(stats, stats.workers[0].utilization, Phase::kParked), 20.0);
+    EXPECT_GT(stats.workers[0].utilization.share(Phase::kParked), 0.5);
+}
+
+TEST(CyclesTest, StealingIsChargedPerVictim) {
+    AccountingExecutor executor(2);
+    std::atomic<size_t> producer = 0;
+    std::atomic<bool> stolen = false;
+    std::atomic<size_t> done = 0;
+
+    executor.submit([&] {
+        producer.store(*wr::this_worker::index());
+        for (size_t i = 0; i < 8; ++i) {
+            executor.submit([&] {
+                if (*wr::this_worker::index() != producer.load()) {
+                    stolen.store(true);
+                }
+                done.fetch_add(1);
+            });
+        }
+        // keep the worker busy until the other one steals
+        eventually([&] { return stolen.load(); });
+    });
+
+    ASSERT_TRUE(eventually([&] { return done.load() == 8; }));
+    ASSERT_TRUE(stolen.load());
+
+    const size_t thief = 1 - producer.load();
+    const auto utilization = executor.stats().workers[thief].utilization;
+    ASSERT_EQ(utilization.steal_cycles.size(), 2u);
+    EXPECT_GT(utilization.steal_cycles[producer.load()], 0u);
+    EXPECT_EQ(utilization.steal_cycles[thief], 0u);
+    EXPECT_LE(std::accumulate(utilization.steal_cycles.begin(), utilization.steal_cycles.end(), uint64_t{0}),
+              utilization.of(Phase::kStealing));
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "exec/executor.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+using wr::test::Gate;
+
+// -------------------- Test prerequisites --------------------
+
+struct GroupConfig : wr::test::Config {
+    static constexpr size_t kMaxTaskGroups = 4;
+};
+
+using GroupExecutor = wr::WsExecutor<wr::TaskBase, GroupConfig>;
+
+// -------------------- Tests --------------------
+
+TEST(TaskGroupTest, RunsGroupTasksAndCountsThem) {
+    GroupExecutor executor(4);
+    auto group = executor.add_group(1);
+
+    std::atomic<int> done = 0;
+    for (int i = 0; i < 1000; ++i) {
+        executor.submit_to_group(group, [&done] { done.fetch_add(1); });
+    }
+
+    ASSERT_TRUE(eventually([&] { return done.load() == 1000; }));
+
+    auto stats = executor.group_stats(group);
+    EXPECT_EQ(stats.weight, 1u);
+    EXPECT_EQ(stats.submitted, 1000u);
+    EXPECT_EQ(stats.executed, 1000u);
+}
+
+TEST(TaskGroupTest, ShareFollowsWeights) {
+    constexpr int kPerGroup = 3000;
+    constexpr int kCheckpoint = 2000;
+
+    GroupExecutor executor(1);
+    auto light = executor.add_group(1);
+    auto heavy = executor.add_group(3);
+
+    std::atomic<int> done = 0;
+    std::atomic<uint64_t> light_at_checkpoint = 0;
+    std::atomic<uint64_t> heavy_at_checkpoint = 0;
+
+    auto task = [&] {
+        if (done.fetch_add(1) + 1 == kCheckpoint) {
+            light_at_checkpoint.store(executor.group_stats(light).executed);
+            heavy_at_checkpoint.store(executor.group_stats(heavy).executed);
+        }
+    };
+
+    Gate gate;
+    gate.close(executor);
+    for (int i = 0; i < kPerGroup; ++i) {
+        executor.submit_to_group(light, task);
+        executor.submit_to_group(heavy, task);
+    }
+    gate.open();
+
+    ASSERT_TRUE(eventually([&] { return done.load() == 2 * kPerGroup; }));
+
+    // both groups are backlogged until the checkpoint => 1 : 3
+    EXPECT_NEAR(static_cast<double>(light_at_checkpoint.load()), kCheckpoint / 4.0, 4);
+    EXPECT_NEAR(static_cast<double>(heavy_at_checkpoint.load()), kCheckpoint * 3 / 4.0, 4);
+}
+
+TEST(TaskGroupTest, NoisyGroupDoesNotStarveOthers) {
+    constexpr int kFlood = 10000;
+    constexpr int kQuiet = 10;
+
+    GroupExecutor executor(1);
+    auto noisy = executor.add_group(1);
+    auto quiet = executor.add_group(1);
+
+    std::atomic<int> noisy_done = 0;
+    std::atomic<int> quiet_done = 0;
+    std::atomic<int> noisy_done_when_quiet_finished = 0;
+
+    Gate gate;
+    gate.close(executor);
+    for (int i = 0; i < kFlood; ++i) {
+        executor.submit_to_group(noisy, [&] { noisy_done.fetch_add(1); });
+    }
+    for (int i = 0; i < kQuiet; ++i) {
+        executor.submit_to_group(quiet, [&] {
+            if (quiet_done.fetch_add(1) + 1 == kQuiet) {
+                noisy_done_when_quiet_finished.store(noisy_done.load());
+            }
+        });
+    }
+    gate.open();
+
+    ASSERT_TRUE(eventually([&] { return noisy_done.load() == kFlood && quiet_done.load() == kQuiet; }));
+    // equal weights => interleaved one by one instead of waiting for the whole flood
+    EXPECT_LE(noisy_done_when_quiet_finished.load(), 2 * kQuiet);
+}
+
+TEST(TaskGroupTest, UngroupedWorkTakesPartInTheRounds) {
+    GroupExecutor executor(2);
+    auto group = executor.add_group(2);
+
+    std::atomic<int> done = 0;
+    for (int i = 0; i < 500; ++i) {
+        executor.submit_to_group(group, [&done] { done.fetch_add(1); });
+        executor.submit([&done] { done.fetch_add(1); });
+    }
+
+    EXPECT_TRUE(eventually([&] { return done.load() == 1000; }));
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include "exec/executor.hpp"
+#include "introspect/segment.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+
+// -------------------- Test prerequisites --------------------
+
+struct IntrospectedConfig : wr::test::SmallQueueConfig {
+    static constexpr bool kEnableStats = true;
+    static constexpr bool kEnableCycleAccounting = true;
+    static constexpr bool kEnableIntrospection = true;
+    static constexpr uint32_t kIntrospectionPeriodMs = 2;
+};
+
+using IntrospectedExecutor = wr::WsExecutor<wr::TaskBase, IntrospectedConfig>;
+
+static_assert(!wr::WsExecutor<>::kEnableIntrospection);
+
+struct Record {
+    uint64_t a;
+    uint64_t b;
+};
+
+// -------------------- Tests --------------------
+
+TEST(SeqlockTest, ReadersNeverSeeTornRecords) {
+    wr::introspect::Seqlock<Record> record;
+    std::atomic<bool> stop = false;
+
+    std::thread writer([&] {
+        uint64_t i = 0;
+        do {
+            ++i;
+            record.store(Record{i, ~i});
+        } while (!stop.load(std::memory_order::relaxed));
+    });
+
+    size_t torn = 0;
+    for (size_t i = 0; i < 100000; ++i) {
+        const Record value = record.load();
+        if (value.a == 0 && value.b == 0) {
+            continue;  // nothing stored yet
+        }
+        torn += value.b != ~value.a ? 1 : 0;
+    }
+    stop.store(true);
+    writer.join();
+
+    EXPECT_EQ(torn, 0u);
+    EXPECT_GT(record.version(), 0u);
+}
+
+TEST(IntrospectionTest, WorkersArePublished) {
+    constexpr size_t kTasks = 100;
+
+    IntrospectedExecutor executor(2);
+    auto segment = wr::introspect::Segment::open(executor.introspection_name());
+
+    EXPECT_EQ(segment.workers(), 2u);
+    EXPECT_EQ(segment.header().flags, wr::introspect::kHasStats | wr::introspect::kHasCycles);
+    EXPECT_EQ(segment.header().period_ms, 2u);
+
+    std::atomic<size_t> done = 0;
+    for (size_t i = 0; i < kTasks; ++i) {
+        executor.submit([&] { done.fetch_add(1); });
+    }
+    ASSERT_TRUE(eventually([&] { return done.load() == kTasks; }));
+
+    // the counters reach the segment with the next samples
+    ASSERT_TRUE(eventually([&] {
+        return segment.worker(0).load().tasks_run + segment.worker(1).load().tasks_run == kTasks;
+    }));
+    // idle => both park, nothing is queued
+    ASSERT_TRUE(eventually([&] {
+        auto first = segment.worker(0).load();
+        auto second = segment.worker(1).load();
+        return first.parked == 1 && second.parked == 1 && segment.pool().load().global_depth == 0;
+    }));
+
+    auto sample = segment.worker(0).load();
+    EXPECT_EQ(sample.local_depth, 0u);
+    EXPECT_GT(segment.pool().load().ns_per_cycle, 0.0);
+    EXPECT_GE(segment.pool().version(), 1u);
+}
+
+TEST(IntrospectionTest, QueuedWorkIsVisible) {
+    IntrospectedExecutor executor(1);
+    auto segment = wr::introspect::Segment::open(executor.introspection_name());
+
+    std::atomic<bool> release = false;
+    std::atomic<size_t> done = 0;
+    executor.submit([&] {
+        for (size_t i = 0; i < 8; ++i) {
+            executor.submit([&] { done.fetch_add(1); });  // to the local queue of the only worker
+        }
+        eventually([&] { return release.load(); });
+    });
+    for (size_t i = 0; i < 5; ++i) {
+        executor.submit([&] { done.fetch_add(1); });  // to the global queue
+    }
+
+    EXPECT_TRUE(eventually([&] {
+        return segment.worker(0).load().local_depth == 8 && segment.pool().load().global_depth == 5;
+    }));
+    release.store(true);
+    ASSERT_TRUE(eventually([&] { return done.load() == 13; }));
+}
+
+TEST(IntrospectionTest, SegmentIsRemovedWithTheExecutor) {
+    std::string name;
+    {
+        IntrospectedExecutor executor(1);
+        name = executor.introspection_name();
+        EXPECT_NO_THROW(wr::introspect::Segment::open(name));
+    }
+    EXPECT_THROW(wr::introspect::Segment::open(name), std::system_error);
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "exec/executor.hpp"
+#include "utils/histogram.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+using wr::test::busy_for;
+
+// -------------------- Test prerequisites --------------------
+
+struct LatencyConfig : wr::test::Config {
+    static constexpr bool kEnableLatency = true;
+};
+
+using StampedExecutor = wr::WsExecutor<wr::StampedTask<wr::TaskBase>, LatencyConfig>;
+using wr::stats::Source;
+
+uint64_t total_runs(const wr::stats::LatencySnapshot& latency) {
+    return latency.total.exec.count();
+}
+
+// -------------------- Tests --------------------
+
+TEST(HistogramTest, LogLinearPrecision) {
+    using Buckets = wr::utils::LogLinearBuckets;
+
+    for (uint64_t value : {0ull, 1ull, 15ull, 16ull, 17ull, 1000ull, 123456789ull, ~0ull}) {
+        const uint64_t lower = Buckets::lower_bound(Buckets::index_of(value));
+        EXPECT_LE(lower, value);
+        EXPECT_LE(value - lower, value / Buckets::kSubBuckets);  // < 6.25%
+    }
+}
+
+TEST(HistogramTest, PercentilesAndMerge) {
+    wr::utils::Histogram low;
+    wr::utils::Histogram high;
+    for (uint64_t i = 1; i <= 100; ++i) {
+        low.record(i);
+        high.record(1000 * i);
+    }
+
+    EXPECT_EQ(low.count(), 100u);
+    EXPECT_EQ(low.max(), 100u);
+    EXPECT_NEAR(static_cast<double>(low.percentile(0.5)), 50.0, 50.0 / 16);
+    EXPECT_NEAR(low.mean(), 50.5, 1e-9);
+
+    low += high;
+    EXPECT_EQ(low.count(), 200u);
+    EXPECT_EQ(low.max(), 100000u);
+    EXPECT_LE(low.percentile(0.25), 50u);
+    EXPECT_GE(low.percentile(0.99), 90000u);
+}
+
+TEST(LatencyTest, QueueWaitOfInjectedTasks) {
+    constexpr size_t kTasks = 20;
+
+    StampedExecutor executor(1);
+    std::atomic<bool> released = false;
+    std::atomic<size_t> done = 0;
+
+    // all of them are queued before the first one runs
+    executor.submit([&] {
+        while (!released.load()) {
+            std::this_thread::yield();
+        }
+    });
+    for (size_t i = 0; i < kTasks; ++i) {
+        executor.submit([&] {
+            busy_for(500us);
+            done.fetch_add(1);
+        });
+    }
+    released.store(true);
+
+    ASSERT_TRUE(eventually([&] { return total_runs(executor.latency()) == kTasks + 1; }));
+
+    auto latency = executor.latency();
+    const auto& wait = latency.total.wait_from(Source::kGlobal);
+    EXPECT_EQ(wait.count(), kTasks + 1);
+
+    // one worker => the last task has waited for all the others
+    const double max_wait_us = static_cast<double>(wait.max()) * latency.ns_per_cycle / 1000;
+    EXPECT_GE(max_wait_us, 500.0 * (kTasks - 1) * 0.9);
+
+    const double p50_exec_us = static_cast<double>(latency.total.exec.percentile(0.5)) * latency.ns_per_cycle / 1000;
+    EXPECT_GE(p50_exec_us, 500.0 * 0.9);
+}
+
+TEST(LatencyTest, SpawnedTasksArePerSource) {
+    constexpr size_t kChildren = 100;
+
+    StampedExecutor executor(1);
+    executor.submit([&] {
+        for (size_t i = 0; i < kChildren; ++i) {
+            executor.submit([] {});
+        }
+    });
+
+    ASSERT_TRUE(eventually([&] { return total_runs(executor.latency()) == kChildren + 1; }));
+
+    auto latency = executor.latency();
+    EXPECT_EQ(latency.total.wait_from(Source::kGlobal).count(), 1u);
+    EXPECT_GT(latency.total.wait_from(Source::kLifo).count(), 0u);
+    EXPECT_EQ(latency.total.wait_from(Source::kLifo).count() + latency.total.wait_from(Source::kLocal).count(),
+              kChildren);
+    EXPECT_EQ(latency.workers.size(), 1u);
+}
+
+TEST(LatencyTest, TimersAndPinnedTasksAreStamped) {
+    StampedExecutor executor(2);
+    std::atomic<size_t> done = 0;
+
+    executor.submit_after(5ms, [&] { done.fetch_add(1); });
+
+    struct Pinned : wr::StampedTask<wr::TaskBase> {
+        std::atomic<size_t>* done;
+
+        explicit Pinned(std::atomic<size_t>* counter) : StampedTask(&Pinned::trampoline), done(counter) {}
+
+        static void trampoline(wr::StampedTask<wr::TaskBase>* self) noexcept {
+            static_cast<Pinned*>(self)->done->fetch_add(1);
+        }
+    } pinned(&done);
+    executor.submit_to(1, &pinned);
+
+    ASSERT_TRUE(eventually([&] { return total_runs(executor.latency()) == 2; }));
+
+    auto latency = executor.latency();
+    EXPECT_EQ(latency.total.wait_from(Source::kInbox).count(), 1u);
+    EXPECT_EQ(latency.workers[1].wait_from(Source::kInbox).count(), 1u);
+    // an expired timer is injected: its wait starts at the expiration, not at `submit_after`
+    const auto& timer_wait = latency.total.wait_from(Source::kGlobal);
+    EXPECT_EQ(timer_wait.count(), 1u);
+    EXPECT_LT(static_cast<double>(timer_wait.max()) * latency.ns_per_cycle, 5e6);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "exec/executor.hpp"
+#include "worker/this_worker.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+
+// -------------------- Test prerequisites --------------------
+
+struct PushingConfig : wr::test::SmallQueueConfig {
+    static constexpr auto kOverflowPolicy = wr::config::OverflowPolicy::kIdleWorker;
+    static constexpr size_t kInjectionCapacity = 1024;  // only to count what goes to the global queue
+};
+
+using PushingExecutor = wr::WsExecutor<wr::TaskBase, PushingConfig>;
+
+// -------------------- Tests --------------------
+
+TEST(OverflowTest, BurstIsHandedOverToIdleWorker) {
+    constexpr size_t kTasks = 24;  // a single overflow of the local queue
+
+    PushingExecutor executor(2);
+    std::atomic<size_t> done = 0;
+    std::atomic<size_t> elsewhere = 0;
+    std::atomic<size_t> producer = 0;
+    std::atomic<size_t> injected = 0;
+
+    std::this_thread::sleep_for(20ms);  // the workers run dry and park
+
+    executor.submit([&] {
+        producer.store(*wr::this_worker::index());
+        for (size_t i = 0; i < kTasks; ++i) {
+            executor.submit([&] {
+                elsewhere.fetch_add(*wr::this_worker::index() != producer.load() ? 1 : 0);
+                done.fetch_add(1);
+            });
+        }
+        injected.store(executor.injected());
+    });
+
+    ASSERT_TRUE(eventually([&] { return done.load() == kTasks; }));
+    EXPECT_EQ(injected.load(), 0u);  // the overflow went to the idle worker, not to the global queue
+    EXPECT_GT(elsewhere.load(), 0u);
+}
+
+TEST(OverflowTest, FallsBackToGlobalQueueWithoutIdleWorkers) {
+    constexpr size_t kTasks = 10000;
+
+    PushingExecutor executor(1);
+    std::atomic<size_t> done = 0;
+
+    executor.submit([&] {
+        for (size_t i = 0; i < kTasks; ++i) {
+            executor.submit([&] { done.fetch_add(1); });
+        }
+    });
+
+    ASSERT_TRUE(eventually([&] { return done.load() == kTasks; }));
+    EXPECT_TRUE(eventually([&] { return executor.injected() == 0; }));
+}
+
+TEST(OverflowTest, RecursiveSpawnsSpreadAcrossThePool) {
+    constexpr size_t kDepth = 14;
+
+    PushingExecutor executor(4);
+    std::atomic<size_t> leaves = 0;
+
+    struct Spawner {
+        static void spawn(PushingExecutor& executor, std::atomic<size_t>& leaves, size_t depth) {
+            if (depth == 0) {
+                leaves.fetch_add(1);
+                return;
+            }
+            for (int i = 0; i < 2; ++i) {
+                executor.submit([&executor, &leaves, depth] { spawn(executor, leaves, depth - 1); });
+            }
+        }
+    };
+    Spawner::spawn(executor, leaves, kDepth);
+
+    ASSERT_TRUE(eventually([&] { return leaves.load() == (size_t{1} << kDepth); }));
+}
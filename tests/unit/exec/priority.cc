@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "exec/executor.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+using wr::test::Gate;
+
+// -------------------- Test prerequisites --------------------
+
+struct PriorityConfig : wr::test::Config {
+    static constexpr size_t kPriorityLevels = 3;
+};
+
+struct AgingConfig : PriorityConfig {
+    static constexpr size_t kPriorityAgingPeriod = 8;
+};
+
+using PriorityExecutor = wr::WsExecutor<wr::TaskBase, PriorityConfig>;
+using AgingExecutor = wr::WsExecutor<wr::TaskBase, AgingConfig>;
+
+struct Journal {
+    std::mutex mutex;
+    std::vector<size_t> order;
+
+    void record(size_t value) {
+        std::lock_guard lock(mutex);
+        order.push_back(value);
+    }
+
+    size_t size() {
+        std::lock_guard lock(mutex);
+        return order.size();
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST(PriorityTest, ExternalSubmitsRunByPriority) {
+    constexpr size_t kPerLevel = 100;
+
+    PriorityExecutor executor(1);
+    Journal journal;
+    Gate gate;
+    gate.close(executor);
+
+    // lowest first: the arrival order is the opposite of the expected execution order
+    for (size_t level = PriorityExecutor::kPriorityLevels; level-- > 0;) {
+        for (size_t i = 0; i < kPerLevel; ++i) {
+            executor.submit([&journal, level] { journal.record(level); }, level);
+        }
+    }
+    gate.open();
+
+    ASSERT_TRUE(eventually([&] { return journal.size() == kPerLevel * PriorityExecutor::kPriorityLevels; }));
+    for (size_t i = 0; i < journal.order.size(); ++i) {
+        EXPECT_EQ(journal.order[i], i / kPerLevel);
+    }
+}
+
+TEST(PriorityTest, SpawnedTasksRunByPriority) {
+    constexpr size_t kPerLevel = 100;
+
+    PriorityExecutor executor(1);
+    Journal journal;
+
+    executor.submit([&] {
+        for (size_t i = 0; i < kPerLevel; ++i) {
+            executor.submit([&journal] { journal.record(2); }, 2);
+        }
+        for (size_t i = 0; i < kPerLevel; ++i) {
+            executor.submit([&journal] { journal.record(0); }, 0);
+        }
+    });
+
+    ASSERT_TRUE(eventually([&] { return journal.size() == 2 * kPerLevel; }));
+    for (size_t i = 0; i < journal.order.size(); ++i) {
+        EXPECT_EQ(journal.order[i], i < kPerLevel ? 0u : 2u);
+    }
+}
+
+TEST(PriorityTest, DefaultPriorityIsTheLowest) {
+    PriorityExecutor executor(1);
+    Journal journal;
+    Gate gate;
+    gate.close(executor);
+
+    executor.submit([&journal] { journal.record(PriorityExecutor::kDefaultPriority); });
+    executor.submit([&journal] { journal.record(1); }, 1);
+    gate.open();
+
+    ASSERT_TRUE(eventually([&] { return journal.size() == 2; }));
+    EXPECT_EQ(journal.order[0], 1u);
+    EXPECT_EQ(journal.order[1], 2u);
+}
+
+struct Flood {
+    AgingExecutor* executor;
+    std::atomic<size_t> remaining;
+
+    void spawn() {
+        executor->submit(
+            [this] {
+                if (remaining.fetch_sub(1) > 1) {
+                    spawn();
+                }
+            },
+            0);
+    }
+};
+
+TEST(PriorityTest, AgingLetsLowPriorityThroughAFlood) {
+    constexpr size_t kFlood = 10000;
+
+    AgingExecutor executor(1);
+    Flood flood{&executor, kFlood};
+    std::atomic<size_t> flood_left_when_low_ran = 0;
+
+    Gate gate;
+    gate.close(executor);
+
+    executor.submit([&] { flood_left_when_low_ran.store(flood.remaining.load()); }, 2);
+    flood.spawn();
+    gate.open();
+
+    ASSERT_TRUE(eventually([&] { return flood.remaining.load() == 0; }));
+    // strict priorities would run it only after the whole flood
+    EXPECT_GT(flood_left_when_low_ran.load(), kFlood - 100);
+}
+
+TEST(PriorityTest, MixedPrioritiesUnderStealing) {
+    constexpr size_t kParents = 64;
+    constexpr size_t kChildren = 200;
+
+    PriorityExecutor executor(4);
+    std::atomic<size_t> done = 0;
+
+    for (size_t p = 0; p < kParents; ++p) {
+        executor.submit(
+            [&executor, &done, p] {
+                for (size_t c = 0; c < kChildren; ++c) {
+                    executor.submit([&done] { done.fetch_add(1); }, (p + c) % PriorityExecutor::kPriorityLevels);
+                }
+            },
+            p % PriorityExecutor::kPriorityLevels);
+    }
+
+    EXPECT_TRUE(eventually([&] { return done.load() == kParents * kChildren; }));
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "exec/executor.hpp"
+#include "record/dag.hpp"
+#include "record/format.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+using wr::test::busy_for;
+
+// -------------------- Test prerequisites --------------------
+
+struct RecordedConfig : wr::test::SmallQueueConfig {
+    static constexpr bool kEnableRecording = true;
+};
+
+using RecordedExecutor = wr::WsExecutor<wr::TaskBase, RecordedConfig>;
+
+static_assert(!wr::WsExecutor<>::kEnableRecording);
+
+template <typename Body>
+wr::record::Recording record(size_t workers, Body body) {
+    const auto path = std::filesystem::temp_directory_path() / "wr_record_test.bin";
+    std::filesystem::remove(path);
+    {
+        RecordedExecutor executor(workers);
+        executor.record_to(path.string());
+        body(executor);
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    auto recording = wr::record::read(file);
+    std::filesystem::remove(path);
+    return recording;
+}
+
+// resubmits itself `left` times
+struct Boomerang : wr::TypedTask<Boomerang> {
+    RecordedExecutor* executor = nullptr;
+    int left = 0;
+    std::atomic<bool> done = false;
+
+    void run() noexcept {
+        busy_for(100us);
+        if (left-- > 0) {
+            executor->submit(this);
+        } else {
+            done.store(true);
+        }
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST(RecordTest, SpawnTreeIsRebuilt) {
+    std::atomic<size_t> done = 0;
+
+    auto recording = record(2, [&](RecordedExecutor& executor) {
+        executor.submit([&] {
+            for (int child = 0; child < 3; ++child) {
+                executor.submit([&] {
+                    busy_for(200us);
+                    for (int grandchild = 0; grandchild < 2; ++grandchild) {
+                        executor.submit([&] { done.fetch_add(1); });
+                    }
+                    done.fetch_add(1);
+                });
+            }
+            done.fetch_add(1);
+        });
+        ASSERT_TRUE(eventually([&] { return done.load() == 10; }));
+    });
+
+    EXPECT_EQ(recording.workers, 2u);
+    EXPECT_GT(recording.ns_per_cycle, 0.0);
+    ASSERT_EQ(recording.events.size(), 20u);  // a submit and a run per task
+    for (size_t i = 1; i < recording.events.size(); ++i) {
+        EXPECT_LE(recording.events[i - 1].tsc, recording.events[i].tsc);
+    }
+
+    auto dag = wr::record::build_dag(recording);
+    ASSERT_EQ(dag.nodes.size(), 10u);
+
+    std::vector<size_t> children(dag.nodes.size(), 0);
+    size_t roots = 0;
+    for (size_t i = 0; i < dag.nodes.size(); ++i) {
+        const auto& node = dag.nodes[i];
+        if (node.parent == wr::record::kRoot) {
+            ++roots;
+            continue;
+        }
+        ASSERT_LT(node.parent, i);  // a parent starts before its children
+        ++children[node.parent];
+        EXPECT_LE(node.offset, dag.nodes[node.parent].duration);  // submitted while the parent ran
+    }
+    EXPECT_EQ(roots, 1u);
+    EXPECT_EQ(dag.nodes[0].parent, wr::record::kRoot);
+    EXPECT_EQ(children[0], 3u);
+
+    size_t spawners = 0;
+    for (size_t i = 1; i < dag.nodes.size(); ++i) {
+        if (children[i] == 2) {
+            ++spawners;
+            EXPECT_GE(dag.nodes[i].duration, 200'000u);
+        }
+    }
+    EXPECT_EQ(spawners, 3u);
+    EXPECT_GE(dag.makespan, 200'000u);
+}
+
+TEST(RecordTest, ReusedTaskIsAChain) {
+    Boomerang task;
+
+    auto recording = record(1, [&](RecordedExecutor& executor) {
+        task.executor = &executor;
+        task.left = 3;
+        executor.submit(&task);
+        ASSERT_TRUE(eventually([&] { return task.done.load(); }));
+    });
+
+    auto dag = wr::record::build_dag(recording);
+    ASSERT_EQ(dag.nodes.size(), 4u);
+    EXPECT_EQ(dag.nodes[0].parent, wr::record::kRoot);
+    for (size_t i = 1; i < dag.nodes.size(); ++i) {
+        EXPECT_EQ(dag.nodes[i].parent, i - 1);
+        EXPECT_GE(dag.nodes[i].offset, 100'000u);  // resubmitted at the end of the previous run
+    }
+}
+
+TEST(RecordTest, ExternalSubmitsAreRoots) {
+    constexpr size_t kTasks = 50;
+    std::atomic<size_t> done = 0;
+
+    auto recording = record(2, [&](RecordedExecutor& executor) {
+        for (size_t i = 0; i < kTasks; ++i) {
+            executor.submit([&] { done.fetch_add(1); });
+        }
+        ASSERT_TRUE(eventually([&] { return done.load() == kTasks; }));
+    });
+
+    auto dag = wr::record::build_dag(recording);
+    ASSERT_EQ(dag.nodes.size(), kTasks);
+    for (const auto& node : dag.nodes) {
+        EXPECT_EQ(node.parent, wr::record::kRoot);
+        EXPECT_LT(node.worker, 2u);
+    }
+}
+
+TEST(RecordTest, NestedRunsKeepTheirParent) {
+    using wr::record::Event;
+    using wr::record::kRun;
+    using wr::record::kSubmit;
+
+    // `outer` runs [0, 100) and helps: `nested` runs [20, 40) inside of it on the same worker
+    const uint64_t outer = 1, nested = 2, first = 3, second = 4;
+    wr::record::Recording recording;
+    recording.workers = 1;
+    recording.events = {
+        Event{0, outer, 0, wr::record::kExternal, kSubmit, 0},
+        Event{0, outer, 100, 0, kRun, 0},
+        Event{10, nested, 0, 0, kSubmit, 0},
+        Event{20, nested, 20, 0, kRun, 0},
+        Event{30, first, 0, 0, kSubmit, 0},
+        Event{60, second, 0, 0, kSubmit, 0},
+        Event{100, first, 10, 0, kRun, 0},
+        Event{110, second, 10, 0, kRun, 0},
+    };
+
+    auto dag = wr::record::build_dag(recording);
+    ASSERT_EQ(dag.nodes.size(), 4u);
+    EXPECT_EQ(dag.nodes[0].parent, wr::record::kRoot);
+    EXPECT_EQ(dag.nodes[1].parent, 0u);
+    EXPECT_EQ(dag.nodes[2].parent, 1u);  // submitted by the nested run
+    EXPECT_EQ(dag.nodes[2].offset, 10u);
+    EXPECT_EQ(dag.nodes[3].parent, 0u);  // the outer run goes on after the nested one
+    EXPECT_EQ(dag.nodes[3].offset, 60u);
+}
+
+TEST(RecordTest, ForeignFilesAreRejected) {
+    std::istringstream garbage("definitely not a recording, but long enough to fill a header");
+    EXPECT_THROW(wr::record::read(garbage), std::runtime_error);
+
+    std::stringstream truncated;
+    wr::record::write(truncated, 1, 1.0, {wr::record::Event{}, wr::record::Event{}});
+    std::string bytes = truncated.str();
+    bytes.resize(bytes.size() - 1);
+    std::istringstream cut(bytes);
+    EXPECT_THROW(wr::record::read(cut), std::runtime_error);
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "exec/executor.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+
+// -------------------- Test prerequisites --------------------
+
+// Task with a "trampoline": sender operation states derive from it
+struct ErasedTask : IntrusiveListNode {
+    using RunFn = void (*)(ErasedTask*) noexcept;
+
+    RunFn run_fn;
+
+    explicit ErasedTask(RunFn fn) : run_fn(fn) {}
+
+    void run() noexcept {
+        run_fn(this);
+    }
+};
+
+using Executor = wr::WsExecutor<ErasedTask>;
+
+struct Completion {
+    std::atomic<int> values = 0;
+    std::atomic<int> errors = 0;
+    std::thread::id thread;
+};
+
+struct TestReceiver {
+    Completion* completion;
+
+    void set_value() && noexcept {
+        completion->thread = std::this_thread::get_id();
+        completion->values.fetch_add(1);
+    }
+
+    void set_error(std::exception_ptr) && noexcept {
+        completion->errors.fetch_add(1);
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST(SchedulerTest, SchedulersOfOneExecutorAreEqual) {
+    Executor executor(2);
+    EXPECT_EQ(executor.get_scheduler(), executor.get_scheduler());
+}
+
+TEST(SchedulerTest, ScheduleCompletesOnWorker) {
+    Executor executor(2);
+    Completion completion;
+
+    auto operation = wr::exec::schedule(executor.get_scheduler()).connect(TestReceiver{&completion});
+    wr::exec::start(operation);
+
+    ASSERT_TRUE(eventually([&] { return completion.values.load() == 1; }));
+    EXPECT_NE(completion.thread, std::this_thread::get_id());
+    EXPECT_EQ(completion.errors.load(), 0);
+}
+
+TEST(SchedulerTest, BulkVisitsEveryIndexOnce) {
+    constexpr int kShape = 10007;
+
+    Executor executor(4);
+    Completion completion;
+    std::vector<std::atomic<int>> visits(kShape);
+
+    auto sender = wr::exec::bulk(executor.get_scheduler().schedule(), kShape, [&](int i) {
+        visits[i].fetch_add(1);
+    });
+    auto operation = std::move(sender).connect(TestReceiver{&completion});
+    wr::exec::start(operation);
+
+    ASSERT_TRUE(eventually([&] { return completion.values.load() == 1; }));
+    for (auto& v : visits) {
+        EXPECT_EQ(v.load(), 1);
+    }
+}
+
+TEST(SchedulerTest, BulkShapeSmallerThanPool) {
+    Executor executor(8);
+    Completion completion;
+    std::atomic<int> sum = 0;
+
+    auto operation = wr::exec::bulk(executor.get_scheduler().schedule(), 3, [&](int i) {
+                         sum.fetch_add(i + 1);
+                     }).connect(TestReceiver{&completion});
+    wr::exec::start(operation);
+
+    ASSERT_TRUE(eventually([&] { return completion.values.load() == 1; }));
+    EXPECT_EQ(sum.load(), 6);
+}
+
+TEST(SchedulerTest, BulkEmptyShapeCompletesInline) {
+    Executor executor(2);
+    Completion completion;
+
+    auto operation = wr::exec::bulk(executor.get_scheduler().schedule(), 0, [](int) {})
+                         .connect(TestReceiver{&completion});
+    wr::exec::start(operation);
+
+    EXPECT_EQ(completion.values.load(), 1);
+    EXPECT_EQ(completion.thread, std::this_thread::get_id());
+}
+
+TEST(SchedulerTest, BulkReportsError) {
+    Executor executor(4);
+    Completion completion;
+
+    auto operation = wr::exec::bulk(executor.get_scheduler().schedule(), 100, [](int i) {
+                         if (i == 42) {
+                             throw std::runtime_error("boom");
+                         }
+                     }).connect(TestReceiver{&completion});
+    wr::exec::start(operation);
+
+    ASSERT_TRUE(eventually([&] { return completion.errors.load() == 1; }));
+    EXPECT_EQ(completion.values.load(), 0);
+}
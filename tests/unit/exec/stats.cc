@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+
+#include "exec/executor.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+
+// -------------------- Test prerequisites --------------------
+
+struct StatsConfig : wr::test::SmallQueueConfig {
+    static constexpr bool kEnableStats = true;
+};
+
+using StatsExecutor = wr::WsExecutor<wr::TaskBase, StatsConfig>;
+
+// off by default and then nothing is left of the counters
+static_assert(std::is_empty_v<wr::stats::Counters<false>>);
+static_assert(!wr::WsExecutor<>::kEnableStats);
+
+// -------------------- Tests --------------------
+
+TEST(StatsTest, InjectedTasksArePoppedFromGlobalQueue) {
+    constexpr size_t kTasks = 1000;
+
+    StatsExecutor executor(2);
+    std::atomic<size_t> done = 0;
+    for (size_t i = 0; i < kTasks; ++i) {
+        executor.submit([&] { done.fetch_add(1); });
+    }
+
+    ASSERT_TRUE(eventually([&] { return done.load() == kTasks; }));
+    // the counter is bumped right after `run` returns
+    ASSERT_TRUE(eventually([&] { return executor.stats().total.tasks_run == kTasks; }));
+
+    auto stats = executor.stats();
+    EXPECT_EQ(stats.workers.size(), 2u);
+    EXPECT_EQ(stats.total.global_pops, kTasks);
+    EXPECT_EQ(stats.total.lifo_hits + stats.total.local_pops, 0u);
+    EXPECT_EQ(stats.workers[0].tasks_run + stats.workers[1].tasks_run, kTasks);
+}
+
+TEST(StatsTest, SpawnedTasksAreLocal) {
+    constexpr size_t kChildren = 100;
+
+    StatsExecutor executor(1);
+    std::atomic<size_t> done = 0;
+    executor.submit([&] {
+        for (size_t i = 0; i < kChildren; ++i) {
+            executor.submit([&] { done.fetch_add(1); });
+        }
+    });
+
+    ASSERT_TRUE(eventually([&] { return executor.stats().total.tasks_run == kChildren + 1; }));
+
+    auto stats = executor.stats().total;
+    EXPECT_GT(stats.lifo_hits, 0u);
+    EXPECT_GT(stats.offloads, 0u);  // 100 children > local capacity
+    // every task came from exactly one place
+    EXPECT_EQ(stats.lifo_hits + stats.local_pops + stats.global_pops, kChildren + 1);
+    EXPECT_EQ(stats.steal_attempts, 0u);
+}
+
+TEST(StatsTest, StealsAreAccountedByOutcome) {
+    constexpr size_t kChildren = 2000;
+
+    StatsExecutor executor(4);
+    std::atomic<size_t> done = 0;
+    executor.submit([&] {
+        for (size_t i = 0; i < kChildren; ++i) {
+            executor.submit([&] {
+                auto until = std::chrono::steady_clock::now() + 10us;
+                while (std::chrono::steady_clock::now() < until) {
+                }
+                done.fetch_add(1);
+            });
+        }
+    });
+
+    ASSERT_TRUE(eventually([&] { return executor.stats().total.tasks_run == kChildren + 1; }));
+
+    auto stats = executor.stats().total;
+    EXPECT_EQ(stats.steal_attempts, stats.steal_success + stats.steal_empty + stats.steal_retry);
+    EXPECT_GE(stats.tasks_stolen, stats.steal_success);
+    EXPECT_EQ(stats.lifo_hits + stats.local_pops + stats.global_pops + stats.steal_success, kChildren + 1);
+}
+
+TEST(StatsTest, IdleWorkersPark) {
+    StatsExecutor executor(2);
+    std::this_thread::sleep_for(20ms);
+
+    std::atomic<bool> done = false;
+    executor.submit([&] { done.store(true); });
+    ASSERT_TRUE(eventually([&] { return done.load(); }));
+
+    auto stats = executor.stats().total;
+    EXPECT_GT(stats.parks, 0u);
+    EXPECT_GT(stats.unparks, 0u);
+    EXPECT_LE(stats.parks - stats.unparks, 2u);  // at most one park in progress per worker
+}
+
+TEST(StatsTest, PinnedTasksWakeOnlyTheirWorker) {
+    constexpr size_t kWorkers = 4;
+    constexpr size_t kTarget = 3;
+    constexpr size_t kTasks = 20;
+
+    StatsExecutor executor(kWorkers);
+    const auto parked = [&](size_t worker) {
+        const auto stats = executor.stats().workers[worker];
+        return stats.parks == stats.unparks + 1;
+    };
+    const auto all_parked = [&] {
+        for (size_t i = 0; i < kWorkers; ++i) {
+            if (!parked(i)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    ASSERT_TRUE(eventually(all_parked));
+
+    const auto before = executor.stats();
+    std::atomic<size_t> done = 0;
+    for (size_t i = 0; i < kTasks; ++i) {
+        executor.submit_to(kTarget, wr::task::make_closure<wr::TaskBase>([&] { done.fetch_add(1); }));
+        ASSERT_TRUE(eventually([&] { return done.load() == i + 1 && parked(kTarget); }));
+    }
+
+    const auto after = executor.stats();
+    EXPECT_EQ(after.workers[kTarget].unparks - before.workers[kTarget].unparks, kTasks);
+    for (size_t i = 0; i < kWorkers; ++i) {
+        if (i != kTarget) {
+            EXPECT_EQ(after.workers[i].unparks, before.workers[i].unparks) << "worker " << i;
+        }
+    }
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "exec/executor.hpp"
+#include "worker/this_worker.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+
+// -------------------- Test prerequisites --------------------
+
+struct TracingConfig : wr::test::SmallQueueConfig {
+    static constexpr bool kEnableTracing = true;
+    static constexpr size_t kTraceCapacity = 1024;
+};
+
+using TracingExecutor = wr::WsExecutor<wr::TaskBase, TracingConfig>;
+using wr::trace::EventType;
+
+// off by default and then nothing is left of the rings
+static_assert(std::is_empty_v<wr::trace::TraceRing<false>>);
+static_assert(!wr::WsExecutor<>::kEnableTracing);
+
+size_t count_events(const std::vector<wr::trace::WorkerTrace>& traces, EventType type) {
+    size_t count = 0;
+    for (const auto& trace : traces) {
+        count += std::count_if(trace.events.begin(), trace.events.end(),
+                               [type](const wr::trace::Event& event) { return event.type == type; });
+    }
+    return count;
+}
+
+// -------------------- Tests --------------------
+
+TEST(TraceRingTest, KeepsTheLastEventsOldestFirst) {
+    wr::trace::TraceRing<true> ring(8);
+    for (uint32_t i = 0; i < 20; ++i) {
+        ring.record(EventType::kSteal, i, static_cast<uint16_t>(i * 2));
+    }
+
+    auto events = ring.read();
+    ASSERT_EQ(events.size(), 8u);
+    for (uint32_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(events[i].type, EventType::kSteal);
+        EXPECT_EQ(events[i].arg, 12 + i);
+        EXPECT_EQ(events[i].aux, (12 + i) * 2);
+    }
+    EXPECT_TRUE(std::is_sorted(events.begin(), events.end(),
+                               [](const auto& lhs, const auto& rhs) { return lhs.tsc < rhs.tsc; }));
+}
+
+TEST(TraceRingTest, SlicesCutByTheWindowAreDropped) {
+    const std::vector<wr::trace::Event> events = {
+        {1, EventType::kTaskEnd, 0, 0},  // began before the window
+        {2, EventType::kUnpark, 0, 0},   // parked before the window
+        {3, EventType::kTaskBegin, 0, 0},
+        {4, EventType::kGlobalPop, 0, 0},
+        {5, EventType::kTaskEnd, 0, 0},
+    };
+
+    std::vector<uint64_t> kept;
+    wr::trace::detail::for_each_balanced(events, [&](const auto& event, const auto&) { kept.push_back(event.tsc); });
+    EXPECT_EQ(kept, (std::vector<uint64_t>{3, 4, 5}));
+}
+
+TEST(TraceTest, TasksAreSlicesOfTheirWorker) {
+    constexpr size_t kTasks = 100;
+
+    TracingExecutor executor(2);
+    std::atomic<size_t> done = 0;
+    for (size_t i = 0; i < kTasks; ++i) {
+        executor.submit([&] { done.fetch_add(1); });
+    }
+
+    ASSERT_TRUE(eventually([&] { return done.load() == kTasks; }));
+    // the end is recorded right after `run` returns
+    ASSERT_TRUE(eventually([&] { return count_events(executor.trace(), EventType::kTaskEnd) == kTasks; }));
+
+    auto traces = executor.trace();
+    ASSERT_EQ(traces.size(), 2u);
+    EXPECT_EQ(traces[0].worker, 0u);
+    EXPECT_EQ(traces[1].worker, 1u);
+    EXPECT_EQ(count_events(traces, EventType::kTaskBegin), kTasks);
+    EXPECT_EQ(count_events(traces, EventType::kGlobalPop), kTasks);
+}
+
+TEST(TraceTest, StealNamesTheVictim) {
+    TracingExecutor executor(2);
+    std::atomic<size_t> producer = 0;
+    std::atomic<bool> stolen = false;
+    std::atomic<size_t> done = 0;
+
+    executor.submit([&] {
+        producer.store(*wr::this_worker::index());
+        for (size_t i = 0; i < 8; ++i) {
+            executor.submit([&] {
+                if (*wr::this_worker::index() != producer.load()) {
+                    stolen.store(true);
+                }
+                done.fetch_add(1);
+            });
+        }
+        // keep the worker busy until the other one steals
+        eventually([&] { return stolen.load(); });
+    });
+
+    ASSERT_TRUE(eventually([&] { return done.load() == 8; }));
+    ASSERT_TRUE(stolen.load());
+
+    const size_t thief = 1 - producer.load();
+    const auto traces = executor.trace();
+    const auto& events = traces[thief].events;
+    auto steal = std::find_if(events.begin(), events.end(), [](const auto& event) {
+        return event.type == EventType::kSteal;
+    });
+    ASSERT_NE(steal, events.end());
+    EXPECT_EQ(steal->arg, producer.load());
+    EXPECT_GE(steal->aux, 1u);
+}
+
+TEST(TraceTest, ChromeJson) {
+    TracingExecutor executor(2);
+    std::atomic<bool> done = false;
+    executor.submit([&] { done.store(true); });
+    ASSERT_TRUE(eventually([&] { return done.load(); }));
+    ASSERT_TRUE(eventually([&] { return count_events(executor.trace(), EventType::kTaskEnd) == 1; }));
+
+    std::ostringstream out;
+    executor.dump_trace(out);
+    const std::string json = out.str();
+
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(json.substr(json.size() - 3), "]}\n");
+    EXPECT_NE(json.find("\"args\":{\"name\":\"wr-worker-0\"}"), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"wr-worker-1\"}"), std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"task\",\"cat\":\"wr\",\"ph\":\"B\""), std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"task\",\"cat\":\"wr\",\"ph\":\"E\""), std::string::npos);
+    EXPECT_NE(json.find("{\"name\":\"global pop\",\"cat\":\"wr\",\"ph\":\"i\""), std::string::npos);
+}
+
+TEST(TraceTest, PerfettoPacketsAreWellFormed) {
+    TracingExecutor executor(2);
+    std::atomic<bool> done = false;
+    executor.submit([&] { done.store(true); });
+    ASSERT_TRUE(eventually([&] { return done.load(); }));
+    ASSERT_TRUE(eventually([&] { return count_events(executor.trace(), EventType::kTaskEnd) == 1; }));
+
+    std::ostringstream out;
+    executor.dump_trace(out, wr::trace::Format::kPerfetto);
+    const std::string bytes = out.str();
+
+    auto varint = [&bytes](size_t& position) {
+        uint64_t value = 0;
+        for (int shift = 0; position < bytes.size(); shift += 7) {
+            const auto byte = static_cast<uint8_t>(bytes[position++]);
+            value |= uint64_t{byte & 0x7fu} << shift;
+            if ((byte & 0x80) == 0) {
+                break;
+            }
+        }
+        return value;
+    };
+
+    // Trace := repeated (tag of `packet` = 1, length-delimited) + TracePacket
+    size_t packets = 0;
+    size_t position = 0;
+    while (position < bytes.size()) {
+        ASSERT_EQ(varint(position), (1u << 3) | 2u);
+        position += varint(position);
+        ++packets;
+    }
+    EXPECT_EQ(position, bytes.size());
+
+    EXPECT_GE(packets, 2 + 3u);  // a track descriptor per worker + task begin, global pop, task end at least
+    EXPECT_NE(bytes.find("wr-worker-1"), std::string::npos);
+    EXPECT_NE(bytes.find("task"), std::string::npos);
+}
+
+TEST(TraceTest, DumpAtShutdown) {
+    const auto path = std::filesystem::temp_directory_path() / "wr_trace_at_shutdown.json";
+    std::filesystem::remove(path);
+
+    {
+        TracingExecutor executor(1);
+        executor.dump_trace_at_shutdown(path.string());
+
+        std::atomic<bool> done = false;
+        executor.submit([&] { done.store(true); });
+        ASSERT_TRUE(eventually([&] { return done.load(); }));
+    }
+
+    std::ifstream file(path);
+    ASSERT_TRUE(file.is_open());
+    std::stringstream json;
+    json << file.rdbuf();
+    EXPECT_NE(json.str().find("\"ph\":\"E\""), std::string::npos);  // the workers have stopped => the task ended
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "exec/executor.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+
+// -------------------- Test prerequisites --------------------
+
+struct CountingTask : IntrusiveListNode {
+    std::atomic<int>* counter = nullptr;
+
+    void run() noexcept {
+        counter->fetch_add(1);
+    }
+};
+
+// Spawns children into the same executor (local queue + stealing path)
+struct SpawningTask : IntrusiveListNode {
+    std::vector<SpawningTask>* children = nullptr;
+    std::atomic<int>* counter = nullptr;
+
+    void run() noexcept;
+};
+
+using SpawningExecutor = wr::WsExecutor<SpawningTask, wr::config::TinyConfig>;
+
+SpawningExecutor* spawning_executor = nullptr;
+
+void SpawningTask::run() noexcept {
+    counter->fetch_add(1);
+    if (children != nullptr) {
+        for (auto& child : *children) {
+            spawning_executor->submit(&child);
+        }
+    }
+}
+
+// -------------------- Tests --------------------
+
+TEST(WsExecutorTest, StartAndStopIdle) {
+    wr::WsExecutor<CountingTask> executor(4);
+    EXPECT_EQ(executor.workers_count(), 4u);
+}
+
+TEST(WsExecutorTest, RunsExternalSubmits) {
+    std::atomic<int> counter = 0;
+    std::vector<CountingTask> tasks(1000);
+
+    wr::WsExecutor<CountingTask> executor(4);
+    for (auto& task : tasks) {
+        task.counter = &counter;
+        executor.submit(&task);
+    }
+
+    EXPECT_TRUE(eventually([&] { return counter.load() == 1000; }));
+}
+
+TEST(WsExecutorTest, RunsTasksSpawnedFromWorkers) {
+    // more children than the tiny local queue can hold => offload to global queue
+    constexpr int kChildren = 1000;
+
+    std::atomic<int> counter = 0;
+    std::vector<SpawningTask> children(kChildren);
+
+    SpawningExecutor executor(4);
+    spawning_executor = &executor;
+    for (auto& child : children) {
+        child.counter = &counter;
+    }
+
+    SpawningTask root;
+    root.children = &children;
+    root.counter = &counter;
+    executor.submit(&root);
+
+    EXPECT_TRUE(eventually([&] { return counter.load() == kChildren + 1; }));
+}
+
+TEST(WsExecutorTest, SingleWorker) {
+    std::atomic<int> counter = 0;
+    std::vector<CountingTask> tasks(100);
+
+    wr::WsExecutor<CountingTask> executor(1);
+    for (auto& task : tasks) {
+        task.counter = &counter;
+        executor.submit(&task);
+        std::this_thread::sleep_for(10us);
+    }
+
+    EXPECT_TRUE(eventually([&] { return counter.load() == 100; }));
+}
+
+// -------------------- Heterogeneous tasks (TaskBase) --------------------
+
+struct IncrementTask : wr::TypedTask<IncrementTask> {
+    std::atomic<int>* counter = nullptr;
+
+    void run() noexcept {
+        counter->fetch_add(1);
+    }
+};
+
+struct AddTask : wr::TypedTask<AddTask> {
+    std::atomic<int>* counter = nullptr;
+    int delta = 0;
+
+    void run() noexcept {
+        counter->fetch_add(delta);
+    }
+};
+
+TEST(WsExecutorTest, RunsDifferentTaskTypesThroughTaskBase) {
+    std::atomic<int> counter = 0;
+    std::vector<IncrementTask> increments(100);
+    std::vector<AddTask> additions(100);
+
+    wr::WsExecutor<> executor(4);
+    for (size_t i = 0; i < 100; ++i) {
+        increments[i].counter = &counter;
+        additions[i].counter = &counter;
+        additions[i].delta = 10;
+
+        executor.submit(&increments[i]);
+        executor.submit(&additions[i]);
+    }
+
+    EXPECT_TRUE(eventually([&] { return counter.load() == 100 + 100 * 10; }));
+}
+
+// -------------------- Targeted submit (inbox) --------------------
+
+struct PinnedTask : wr::TypedTask<PinnedTask> {
+    size_t expected_worker = 0;
+    std::atomic<int>* counter = nullptr;
+    std::atomic<int>* misplaced = nullptr;
+
+    void run() noexcept {
+        if (wr::this_worker::index() != expected_worker) {
+            misplaced->fetch_add(1);
+        }
+        counter->fetch_add(1);
+    }
+};
+
+TEST(WsExecutorTest, SubmitToRunsOnTargetWorker) {
+    constexpr size_t kWorkers = 4;
+    constexpr size_t kPerWorker = 2000;  // more than the inbox ring => overflow is covered too
+
+    std::atomic<int> counter = 0;
+    std::atomic<int> misplaced = 0;
+    std::vector<PinnedTask> tasks(kWorkers * kPerWorker);
+
+    wr::WsExecutor<> executor(kWorkers);
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        tasks[i].expected_worker = i % kWorkers;
+        tasks[i].counter = &counter;
+        tasks[i].misplaced = &misplaced;
+        executor.submit_to(tasks[i].expected_worker, &tasks[i]);
+    }
+
+    EXPECT_TRUE(eventually([&] { return counter.load() == static_cast<int>(tasks.size()); }));
+    EXPECT_EQ(misplaced.load(), 0);
+}
+
+TEST(WsExecutorTest, SubmitToWakesParkedWorker) {
+    std::atomic<int> counter = 0;
+    std::atomic<int> misplaced = 0;
+    std::vector<PinnedTask> tasks(50);
+
+    wr::WsExecutor<> executor(4);
+    for (auto& task : tasks) {
+        task.expected_worker = 3;
+        task.counter = &counter;
+        task.misplaced = &misplaced;
+
+        // let everybody fall asleep between the submits
+        std::this_thread::sleep_for(200us);
+        executor.submit_to(3, &task);
+    }
+
+    EXPECT_TRUE(eventually([&] { return counter.load() == 50; }));
+    EXPECT_EQ(misplaced.load(), 0);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "exec/executor.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+
+// -------------------- Test prerequisites --------------------
+
+struct WatchedConfig : wr::test::SmallQueueConfig {
+    static constexpr uint32_t kWatchdogThresholdMs = 20;
+};
+
+struct BacktraceConfig : WatchedConfig {
+    static constexpr bool kWatchdogBacktrace = true;
+};
+
+using WatchedExecutor = wr::WsExecutor<wr::TaskBase, WatchedConfig>;
+using BacktraceExecutor = wr::WsExecutor<wr::TaskBase, BacktraceConfig>;
+
+static_assert(!wr::WsExecutor<>::kEnableWatchdog);
+
+// spins until released
+template <typename Self>
+struct Stalling : wr::TypedTask<Self> {
+    std::atomic<bool> release = false;
+    std::atomic<bool> done = false;
+
+    void run() noexcept {
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+        done.store(true);
+    }
+};
+
+struct StallingTask : Stalling<StallingTask> {};
+struct BlockedTask : Stalling<BlockedTask> {};
+
+class Reports {
+  private:
+    mutable std::mutex mutex_;
+    std::vector<wr::watchdog::StallReport> reports_;
+
+  public:
+    void add(const wr::watchdog::StallReport& report) {
+        std::lock_guard lock(mutex_);
+        reports_.push_back(report);
+    }
+
+    std::vector<wr::watchdog::StallReport> get() const {
+        std::lock_guard lock(mutex_);
+        return reports_;
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST(WatchdogTest, StalledTaskIsReportedOnce) {
+    WatchedExecutor executor(2);
+    Reports reports;
+    executor.on_stall([&](const wr::watchdog::StallReport& report) { reports.add(report); });
+
+    StallingTask task;
+    executor.submit(&task);
+
+    ASSERT_TRUE(eventually([&] { return !reports.get().empty(); }));
+    std::this_thread::sleep_for(50ms);  // a dozen more checks of the same task
+    task.release.store(true);
+    ASSERT_TRUE(eventually([&] { return task.done.load(); }));
+
+    auto all = reports.get();
+    ASSERT_EQ(all.size(), 1u);
+    EXPECT_LT(all[0].worker, 2u);
+    EXPECT_EQ(all[0].task, static_cast<const void*>(static_cast<wr::TaskBase*>(&task)));
+    EXPECT_EQ(all[0].type, "wr::TypedTask<StallingTask>::trampoline");
+    EXPECT_GE(all[0].duration, 20ms);
+    EXPECT_TRUE(all[0].backtrace.empty());
+}
+
+TEST(WatchdogTest, EveryStallIsReported) {
+    WatchedExecutor executor(1);
+    Reports reports;
+    executor.on_stall([&](const wr::watchdog::StallReport& report) { reports.add(report); });
+
+    StallingTask first;
+    StallingTask second;
+    executor.submit(&first);
+    executor.submit(&second);
+
+    ASSERT_TRUE(eventually([&] { return reports.get().size() == 1; }));
+    first.release.store(true);
+    ASSERT_TRUE(eventually([&] { return reports.get().size() == 2; }));
+    second.release.store(true);
+    ASSERT_TRUE(eventually([&] { return second.done.load(); }));
+
+    auto all = reports.get();
+    EXPECT_EQ(all[0].task, static_cast<const void*>(static_cast<wr::TaskBase*>(&first)));
+    EXPECT_EQ(all[1].task, static_cast<const void*>(static_cast<wr::TaskBase*>(&second)));
+}
+
+TEST(WatchdogTest, ReportsNameTheTypeOfTheStalledTask) {
+    WatchedExecutor executor(2);
+    Reports reports;
+    executor.on_stall([&](const wr::watchdog::StallReport& report) { reports.add(report); });
+
+    StallingTask stalling;
+    BlockedTask blocked;
+    executor.submit(&stalling);
+    executor.submit(&blocked);
+
+    ASSERT_TRUE(eventually([&] { return reports.get().size() == 2; }));
+    stalling.release.store(true);
+    blocked.release.store(true);
+    ASSERT_TRUE(eventually([&] { return stalling.done.load() && blocked.done.load(); }));
+
+    for (const auto& report : reports.get()) {
+        if (report.task == static_cast<const void*>(static_cast<wr::TaskBase*>(&stalling))) {
+            EXPECT_EQ(report.type, "wr::TypedTask<StallingTask>::trampoline");
+        } else {
+            EXPECT_EQ(report.task, static_cast<const void*>(static_cast<wr::TaskBase*>(&blocked)));
+            EXPECT_EQ(report.type, "wr::TypedTask<BlockedTask>::trampoline");
+        }
+    }
+}
+
+TEST(WatchdogTest, ShortTasksAndIdleWorkersAreNotReported) {
+    constexpr size_t kTasks = 10000;
+
+    WatchedExecutor executor(2);
+    Reports reports;
+    executor.on_stall([&](const wr::watchdog::StallReport& report) { reports.add(report); });
+
+    std::atomic<size_t> done = 0;
+    for (size_t i = 0; i < kTasks; ++i) {
+        executor.submit([&] { done.fetch_add(1); });
+    }
+    ASSERT_TRUE(eventually([&] { return done.load() == kTasks; }));
+
+    std::this_thread::sleep_for(100ms);  // the last task has "started" long ago, but the workers are parked
+    EXPECT_TRUE(reports.get().empty());
+}
+
+#if defined(__GLIBC__)
+
+TEST(WatchdogTest, BacktraceOfTheStalledWorker) {
+    BacktraceExecutor executor(1);
+    Reports reports;
+    executor.on_stall([&](const wr::watchdog::StallReport& report) { reports.add(report); });
+
+    StallingTask task;
+    executor.submit(&task);
+
+    ASSERT_TRUE(eventually([&] { return !reports.get().empty(); }));
+    task.release.store(true);
+    ASSERT_TRUE(eventually([&] { return task.done.load(); }));
+
+    auto report = reports.get()[0];
+    EXPECT_GT(report.backtrace.size(), 2u);  // the handler, the trampoline, the run loop...
+}
+
+#endif
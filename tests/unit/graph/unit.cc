@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "exec/executor.hpp"
+#include "graph/task_graph.hpp"
+
+// -------------------- Test prerequisites --------------------
+
+using Executor = wr::WsExecutor<>;
+using Graph = wr::TaskGraph<Executor>;
+
+// Every node stamps the global finish order => edges can be checked after the run
+struct OrderRecorder {
+    std::atomic<size_t> clock = 0;
+    std::vector<size_t> stamps;
+
+    explicit OrderRecorder(size_t nodes) : stamps(nodes, 0) {}
+
+    auto node(size_t id) {
+        return [this, id] { stamps[id] = clock.fetch_add(1) + 1; };
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST(TaskGraphTest, EmptyGraph) {
+    Executor executor(2);
+    Graph graph(&executor);
+    graph.run_and_wait();
+    EXPECT_EQ(graph.size(), 0u);
+}
+
+TEST(TaskGraphTest, Diamond) {
+    Executor executor(4);
+    Graph graph(&executor);
+    OrderRecorder recorder(4);
+
+    auto a = graph.emplace(recorder.node(0));
+    auto b = graph.emplace(recorder.node(1));
+    auto c = graph.emplace(recorder.node(2));
+    auto d = graph.emplace(recorder.node(3));
+    graph.precede(a, b);
+    graph.precede(a, c);
+    graph.precede(b, d);
+    graph.precede(c, d);
+
+    graph.run_and_wait();
+
+    EXPECT_EQ(recorder.clock.load(), 4u);
+    EXPECT_LT(recorder.stamps[0], recorder.stamps[1]);
+    EXPECT_LT(recorder.stamps[0], recorder.stamps[2]);
+    EXPECT_LT(recorder.stamps[1], recorder.stamps[3]);
+    EXPECT_LT(recorder.stamps[2], recorder.stamps[3]);
+}
+
+TEST(TaskGraphTest, LongChain) {
+    constexpr size_t kNodes = 10000;
+
+    Executor executor(4);
+    Graph graph(&executor);
+    std::vector<size_t> order;  // not synchronized on purpose: the chain is serial
+
+    Graph::NodeId prev = graph.emplace([&order] { order.push_back(0); });
+    for (size_t i = 1; i < kNodes; ++i) {
+        auto node = graph.emplace([&order, i] { order.push_back(i); });
+        graph.precede(prev, node);
+        prev = node;
+    }
+
+    graph.run_and_wait();
+
+    ASSERT_EQ(order.size(), kNodes);
+    for (size_t i = 0; i < kNodes; ++i) {
+        ASSERT_EQ(order[i], i);
+    }
+}
+
+TEST(TaskGraphTest, RandomDagRespectsEdges) {
+    constexpr size_t kNodes = 2000;
+    constexpr size_t kEdges = 8000;
+
+    Executor executor(4);
+    Graph graph(&executor);
+    OrderRecorder recorder(kNodes);
+
+    for (size_t i = 0; i < kNodes; ++i) {
+        graph.emplace(recorder.node(i));
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<uint32_t> pick(0, kNodes - 1);
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    while (edges.size() < kEdges) {
+        uint32_t from = pick(gen);
+        uint32_t to = pick(gen);
+        if (from == to) {
+            continue;
+        }
+        if (from > to) {
+            std::swap(from, to);  // forward edges only => acyclic
+        }
+        graph.precede(from, to);
+        edges.emplace_back(from, to);
+    }
+
+    graph.run_and_wait();
+
+    EXPECT_EQ(recorder.clock.load(), kNodes);
+    for (auto [from, to] : edges) {
+        ASSERT_LT(recorder.stamps[from], recorder.stamps[to]);
+    }
+}
+
+TEST(TaskGraphTest, ReusableAcrossRuns) {
+    constexpr size_t kWidth = 100;
+
+    Executor executor(4);
+    Graph graph(&executor);
+    std::atomic<int> counter = 0;
+
+    // fan-out / fan-in: root -> kWidth -> join
+    auto root = graph.emplace([&] { counter.fetch_add(1); });
+    auto join = graph.emplace([&] { counter.fetch_add(1); });
+    for (size_t i = 0; i < kWidth; ++i) {
+        auto node = graph.emplace([&] { counter.fetch_add(1); });
+        graph.precede(root, node);
+        graph.precede(node, join);
+    }
+
+    for (int run = 1; run <= 50; ++run) {
+        graph.run_and_wait();
+        ASSERT_EQ(counter.load(), run * static_cast<int>(kWidth + 2));
+    }
+
+    // the graph may grow between runs
+    auto tail = graph.emplace([&] { counter.fetch_add(1000); });
+    graph.precede(join, tail);
+    graph.run_and_wait();
+    EXPECT_EQ(counter.load(), 51 * static_cast<int>(kWidth + 2) + 1000);
+}
+
+TEST(TaskGraphTest, IndependentNodes) {
+    constexpr size_t kNodes = 10000;
+
+    Executor executor(4);
+    Graph graph(&executor);
+    std::atomic<size_t> counter = 0;
+
+    for (size_t i = 0; i < kNodes; ++i) {
+        graph.emplace([&] { counter.fetch_add(1); });
+    }
+
+    graph.run_and_wait();
+    EXPECT_EQ(counter.load(), kNodes);
+}
+
+#ifndef NDEBUG
+TEST(TaskGraphDeathTest, CycleBehindASourceIsCaught) {
+    // c -> a -> b -> a: `c` is a source, the cycle would never run and `wait()` would block forever
+    EXPECT_DEATH(
+        {
+            Executor executor(1);
+            Graph graph(&executor);
+            auto a = graph.emplace([] {});
+            auto b = graph.emplace([] {});
+            auto c = graph.emplace([] {});
+            graph.precede(c, a);
+            graph.precede(a, b);
+            graph.precede(b, a);
+            graph.run_and_wait();
+        },
+        "graph has a cycle");
+}
+#endif
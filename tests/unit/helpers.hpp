@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+// Prerequisites shared by the suites which run an executor
+namespace wr::test {
+
+// Pool shape of the executor suites: a suite derives its config and adds the knobs it is about
+struct Config {
+    static constexpr size_t kLocalQueueCapacity = 256;
+    static constexpr size_t kMaxLifoStreak = 23;
+    static constexpr uint64_t kFairnessPeriod = 61;
+};
+
+// The local queue overflows after 16 tasks => the overflow path is exercised by small workloads
+struct SmallQueueConfig : Config {
+    static constexpr size_t kLocalQueueCapacity = 16;
+};
+
+// Polls until `predicate` holds; false once `timeout` has passed
+template <typename P>
+bool eventually(P&& predicate, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+// Occupies a worker until opened: on a single-worker pool everything submitted meanwhile stays queued
+struct Gate {
+    std::atomic<bool> entered = false;
+    std::atomic<bool> opened = false;
+
+    template <typename Executor>
+    void close(Executor& executor) {
+        executor.submit([this] {
+            entered.store(true);
+            while (!opened.load()) {
+                std::this_thread::yield();
+            }
+        });
+        while (!entered.load()) {
+            std::this_thread::yield();
+        }
+    }
+
+    void open() {
+        opened.store(true);
+    }
+};
+
+// Keeps the calling thread (a worker) busy, unlike a sleep
+inline void busy_for(std::chrono::microseconds duration) {
+    const auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+}  // namespace wr::test
@@ -0,0 +1,287 @@
+#include <gtest/gtest.h>
+
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "exec/executor.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+
+// -------------------- Test prerequisites --------------------
+
+struct ReactorConfig : wr::test::Config {
+    static constexpr bool kEnableReactor = true;
+};
+
+using Executor = wr::WsExecutor<wr::TaskBase, ReactorConfig>;
+
+struct ReactorStatsConfig : ReactorConfig {
+    static constexpr bool kEnableStats = true;
+};
+using IoTask = wr::IoTask<wr::TaskBase>;
+
+// reads everything available from its descriptor, counts the wakeups
+struct Reader : IoTask {
+    std::atomic<int> wakeups = 0;
+    std::atomic<size_t> bytes = 0;
+    std::atomic<uint32_t> events = 0;
+
+    Reader() : IoTask(&Reader::trampoline) {}
+
+    static void trampoline(wr::TaskBase* self) noexcept {
+        auto* reader = static_cast<Reader*>(self);
+        char buffer[256];
+        ssize_t count = ::read(reader->fd(), buffer, sizeof(buffer));
+        if (count > 0) {
+            reader->bytes.fetch_add(static_cast<size_t>(count));
+        }
+        reader->events.store(reader->ready_events());
+        reader->wakeups.fetch_add(1);
+    }
+};
+
+// re-arms itself until `expected` wakeups
+struct Counter : IoTask {
+    Executor* executor = nullptr;
+    int expected = 0;
+    std::atomic<int> wakeups = 0;
+
+    Counter() : IoTask(&Counter::trampoline) {}
+
+    static void trampoline(wr::TaskBase* self) noexcept {
+        auto* counter = static_cast<Counter*>(self);
+        uint64_t value = 0;
+        [[maybe_unused]] auto bytes = ::read(counter->fd(), &value, sizeof(value));
+
+        if (counter->wakeups.fetch_add(1) + 1 < counter->expected) {
+            counter->executor->reactor().rearm(counter, EPOLLIN);
+        }
+    }
+};
+
+struct Pipe {
+    int fds[2] = {-1, -1};
+
+    Pipe() {
+        EXPECT_EQ(::pipe(fds), 0);
+    }
+    ~Pipe() {
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+
+    void write(const std::string& data) {
+        ASSERT_EQ(::write(fds[1], data.data(), data.size()), static_cast<ssize_t>(data.size()));
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST(ReactorTest, PipeReadiness) {
+    Executor executor(2);
+    Pipe pipe;
+    Reader reader;
+
+    executor.reactor().add(&reader, pipe.fds[0], EPOLLIN);
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(reader.wakeups.load(), 0);
+
+    pipe.write("white rabbit");
+    ASSERT_TRUE(eventually([&] { return reader.wakeups.load() == 1; }));
+    EXPECT_EQ(reader.bytes.load(), 12u);
+    EXPECT_TRUE(reader.events.load() & EPOLLIN);
+
+    executor.reactor().remove(&reader);
+}
+
+TEST(ReactorTest, OneShotUntilRearmed) {
+    Executor executor(2);
+    Pipe pipe;
+    Reader reader;
+
+    executor.reactor().add(&reader, pipe.fds[0], EPOLLIN);
+    pipe.write("a");
+    ASSERT_TRUE(eventually([&] { return reader.wakeups.load() == 1; }));
+
+    pipe.write("b");
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(reader.wakeups.load(), 1);  // not re-armed
+
+    executor.reactor().rearm(&reader, EPOLLIN);
+    ASSERT_TRUE(eventually([&] { return reader.wakeups.load() == 2; }));
+    EXPECT_EQ(reader.bytes.load(), 2u);
+
+    executor.reactor().remove(&reader);
+}
+
+TEST(ReactorTest, EventfdRearmedFromTask) {
+    constexpr int kEvents = 100;
+
+    Executor executor(3);
+    int fd = ::eventfd(0, EFD_NONBLOCK);
+    ASSERT_GE(fd, 0);
+
+    Counter counter;
+    counter.executor = &executor;
+    counter.expected = kEvents;
+    executor.reactor().add(&counter, fd, EPOLLIN);
+
+    for (int i = 0; i < kEvents; ++i) {
+        const int before = counter.wakeups.load();
+        const uint64_t one = 1;
+        ASSERT_EQ(::write(fd, &one, sizeof(one)), static_cast<ssize_t>(sizeof(one)));
+        ASSERT_TRUE(eventually([&] { return counter.wakeups.load() > before; }));
+    }
+    EXPECT_EQ(counter.wakeups.load(), kEvents);
+
+    executor.reactor().remove(&counter);
+    ::close(fd);
+}
+
+TEST(ReactorTest, ManyDescriptorsInOneBatch) {
+    constexpr int kPipes = 100;  // > Reactor::kMaxEvents
+
+    Executor executor(4);
+    Pipe pipes[kPipes];
+    Reader readers[kPipes];
+
+    for (int i = 0; i < kPipes; ++i) {
+        executor.reactor().add(&readers[i], pipes[i].fds[0], EPOLLIN);
+    }
+    for (int i = 0; i < kPipes; ++i) {
+        pipes[i].write("x");
+    }
+
+    ASSERT_TRUE(eventually([&] {
+        for (auto& reader : readers) {
+            if (reader.wakeups.load() != 1) {
+                return false;
+            }
+        }
+        return true;
+    }));
+
+    for (auto& reader : readers) {
+        executor.reactor().remove(&reader);
+    }
+}
+
+TEST(ReactorTest, LoopbackSocketEcho) {
+    Executor executor(2);
+
+    int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_GE(listener, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    ASSERT_EQ(::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    ASSERT_EQ(::listen(listener, 1), 0);
+    socklen_t length = sizeof(address);
+    ASSERT_EQ(::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length), 0);
+
+    int client = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_EQ(::connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    int server = ::accept(listener, nullptr, nullptr);
+    ASSERT_GE(server, 0);
+
+    // the server echoes whatever arrives and waits for more
+    struct Echo : IoTask {
+        Executor* executor = nullptr;
+        std::atomic<int> echoed = 0;
+
+        Echo() : IoTask(&Echo::trampoline) {}
+
+        static void trampoline(wr::TaskBase* self) noexcept {
+            auto* echo = static_cast<Echo*>(self);
+            char buffer[64];
+            ssize_t count = ::recv(echo->fd(), buffer, sizeof(buffer), MSG_DONTWAIT);
+            echo->executor->reactor().rearm(echo, EPOLLIN);
+            if (count > 0) {
+                // the last touch of `echo`: the client may remove it as soon as the reply arrives
+                echo->echoed.fetch_add(1);
+                [[maybe_unused]] auto sent = ::send(echo->fd(), buffer, static_cast<size_t>(count), 0);
+            }
+        }
+    } echo;
+    echo.executor = &executor;
+    executor.reactor().add(&echo, server, EPOLLIN);
+
+    for (int i = 0; i < 10; ++i) {
+        const std::string message = "ping " + std::to_string(i);
+        ASSERT_EQ(::send(client, message.data(), message.size(), 0), static_cast<ssize_t>(message.size()));
+
+        char reply[64] = {};
+        ASSERT_EQ(::recv(client, reply, sizeof(reply), 0), static_cast<ssize_t>(message.size()));
+        EXPECT_EQ(std::string(reply, message.size()), message);
+    }
+    EXPECT_EQ(echo.echoed.load(), 10);
+
+    executor.reactor().remove(&echo);
+    ::close(client);
+    ::close(server);
+    ::close(listener);
+}
+
+TEST(ReactorTest, SubmitWakesBlockedPoller) {
+    Executor executor(1);  // the only worker sleeps in epoll_wait
+    Pipe pipe;
+    Reader reader;
+    executor.reactor().add(&reader, pipe.fds[0], EPOLLIN);
+
+    for (int i = 0; i < 50; ++i) {
+        std::this_thread::sleep_for(1ms);
+        std::atomic<bool> done = false;
+        executor.submit([&] { done.store(true); });
+        ASSERT_TRUE(eventually([&] { return done.load(); }));
+    }
+
+    pipe.write("z");
+    ASSERT_TRUE(eventually([&] { return reader.wakeups.load() == 1; }));
+    executor.reactor().remove(&reader);
+}
+
+TEST(ReactorTest, TimersFireWhileIdle) {
+    Executor executor(2);
+    std::atomic<bool> fired = false;
+
+    const auto start = std::chrono::steady_clock::now();
+    executor.submit_after(20ms, [&] { fired.store(true); });
+
+    ASSERT_TRUE(eventually([&] { return fired.load(); }));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+}
+
+TEST(ReactorTest, PollerSleepsWhileAnotherWorkerKeepsTime) {
+    wr::WsExecutor<wr::TaskBase, ReactorStatsConfig> executor(2);
+    Pipe pipe;
+    Reader reader;
+    executor.reactor().add(&reader, pipe.fds[0], EPOLLIN);
+    std::this_thread::sleep_for(20ms);  // one worker polls, the other one is parked
+
+    // the poller has no alarm to wait for => the parked worker wakes up and keeps time
+    executor.submit_after(10s, [] {});
+    std::this_thread::sleep_for(20ms);
+
+    // the poller wakes up once and has to block again although the timer is not its business
+    pipe.write("x");
+    ASSERT_TRUE(eventually([&] { return reader.wakeups.load() == 1; }));
+    std::this_thread::sleep_for(20ms);
+
+    const auto before = executor.stats().total.parks;
+    std::this_thread::sleep_for(100ms);
+    EXPECT_LE(executor.stats().total.parks - before, 2u);
+
+    executor.reactor().remove(&reader);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "memory/arena.hpp"
+
+using wr::memory::Arena;
+using wr::memory::ArenaAllocator;
+using wr::memory::ArenaScope;
+
+// -------------------- Tests --------------------
+
+TEST(ArenaTest, LazyFirstChunk) {
+    Arena arena(4096);
+    EXPECT_EQ(arena.capacity(), 0u);
+
+    void* ptr = arena.allocate(16);
+    EXPECT_NE(ptr, nullptr);
+    EXPECT_GE(arena.capacity(), 4096u);
+}
+
+TEST(ArenaTest, BumpAndAlignment) {
+    Arena arena(4096);
+
+    auto* a = static_cast<std::byte*>(arena.allocate(3, 1));
+    auto* b = static_cast<std::byte*>(arena.allocate(8, 64));
+
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0u);
+    EXPECT_GE(b, a + 3);
+}
+
+TEST(ArenaTest, ResetReusesMemory) {
+    Arena arena(4096);
+
+    void* first = arena.allocate(100);
+    (void)arena.allocate(3000);
+    (void)arena.allocate(3000);  // second chunk
+    const size_t capacity = arena.capacity();
+
+    arena.reset();
+    EXPECT_EQ(arena.allocate(100), first);
+
+    (void)arena.allocate(3000);
+    (void)arena.allocate(3000);
+    EXPECT_EQ(arena.capacity(), capacity);  // no new chunks after warm-up
+}
+
+TEST(ArenaTest, ScopeRewinds) {
+    Arena arena(4096);
+    (void)arena.allocate(10);
+
+    void* inside = nullptr;
+    {
+        ArenaScope scope(arena);
+        inside = arena.allocate(32);
+    }
+
+    EXPECT_EQ(arena.allocate(32), inside);
+}
+
+TEST(ArenaTest, OversizedAllocation) {
+    Arena arena(4096);
+
+    auto* big = static_cast<char*>(arena.allocate(100'000));
+    big[99'999] = 'x';
+    EXPECT_GE(arena.capacity(), 100'000u);
+}
+
+TEST(ArenaTest, StlAdapter) {
+    Arena arena(4096);
+
+    std::vector<int, ArenaAllocator<int>> numbers{ArenaAllocator<int>(arena)};
+    for (int i = 0; i < 10'000; ++i) {
+        numbers.push_back(i);
+    }
+
+    EXPECT_EQ(numbers[9'999], 9'999);
+    EXPECT_EQ(ArenaAllocator<int>(arena), ArenaAllocator<long>(arena));
+}
+
+TEST(ArenaTest, HugePagesFallback) {
+    // works whether or not huge pages are reserved on the machine
+    Arena arena(4096, /*huge_pages=*/true);
+
+    auto* ptr = static_cast<char*>(arena.allocate(1024));
+    ptr[0] = 'x';
+    EXPECT_EQ(arena.capacity() % Arena::kHugePageSize, 0u);
+}
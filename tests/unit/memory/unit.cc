@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "memory/block_pool.hpp"
+
+using wr::memory::BlockPool;
+
+// -------------------- Test prerequisites --------------------
+
+class BlockPoolTest : public ::testing::Test {
+  protected:
+    BlockPool pool;
+
+    void SetUp() override {
+        BlockPool::set_current(&pool);
+    }
+
+    void TearDown() override {
+        BlockPool::set_current(nullptr);
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST_F(BlockPoolTest, LocalFreeIsReused) {
+    void* first = pool.allocate(24);
+    BlockPool::deallocate(first);
+
+    void* second = pool.allocate(24);
+    EXPECT_EQ(first, second);
+    BlockPool::deallocate(second);
+}
+
+TEST_F(BlockPoolTest, SizeClassesDoNotMix) {
+    void* small = pool.allocate(16);
+    void* big = pool.allocate(200);
+    BlockPool::deallocate(small);
+
+    // freed small block must not be handed out for a bigger request
+    void* another_big = pool.allocate(200);
+    EXPECT_NE(another_big, small);
+
+    BlockPool::deallocate(big);
+    BlockPool::deallocate(another_big);
+}
+
+TEST_F(BlockPoolTest, BlocksAreDistinctAndAligned) {
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < 3 * BlockPool::kBlocksPerSlab; ++i) {
+        blocks.push_back(pool.allocate(40));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(blocks.back()) % alignof(std::max_align_t), 0u);
+    }
+
+    std::sort(blocks.begin(), blocks.end());
+    EXPECT_EQ(std::adjacent_find(blocks.begin(), blocks.end()), blocks.end());
+
+    for (void* block : blocks) {
+        BlockPool::deallocate(block);
+    }
+}
+
+TEST_F(BlockPoolTest, OversizedGoesToHeap) {
+    void* huge = pool.allocate(4096);
+    ASSERT_NE(huge, nullptr);
+    BlockPool::deallocate(huge);
+}
+
+TEST_F(BlockPoolTest, NoPoolOnThreadMeansHeap) {
+    std::thread([] {
+        EXPECT_EQ(BlockPool::current(), nullptr);
+        void* block = BlockPool::allocate_local(32);
+        BlockPool::deallocate(block);
+    }).join();
+}
+
+TEST_F(BlockPoolTest, RemoteFreeReturnsToOwner) {
+    void* block = pool.allocate(48);
+
+    // freed on a thread which does not own the block => goes to the remote-free list
+    std::thread([block] {
+        BlockPool::deallocate(block);
+    }).join();
+
+    // local freelist of the class still has the rest of the slab: drain it
+    std::vector<void*> drained;
+    for (size_t i = 0; i + 1 < BlockPool::kBlocksPerSlab; ++i) {
+        drained.push_back(pool.allocate(48));
+    }
+
+    // next allocation takes remote-freed blocks before asking for fresh memory
+    void* reused = pool.allocate(48);
+    EXPECT_EQ(reused, block);
+
+    BlockPool::deallocate(reused);
+    for (void* b : drained) {
+        BlockPool::deallocate(b);
+    }
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "exec/executor.hpp"
+#include "pipeline/pipeline.hpp"
+
+// -------------------- Test prerequisites --------------------
+
+using Executor = wr::WsExecutor<>;
+
+struct Item {
+    int64_t index = 0;
+    int64_t value = 0;
+};
+
+using Pipeline = wr::Pipeline<Executor, Item>;
+
+// Counts items [0, count) into the pipeline
+struct Source {
+    int64_t next = 0;
+    int64_t count = 0;
+
+    bool operator()(Item& item) {
+        if (next == count) {
+            return false;
+        }
+        item.index = next++;
+        item.value = 0;
+        return true;
+    }
+};
+
+// Detects overlapping calls of a serial stage
+struct SerialProbe {
+    std::atomic<bool> inside = false;
+    std::atomic<int> overlaps = 0;
+
+    void enter() {
+        if (inside.exchange(true)) {
+            overlaps.fetch_add(1);
+        }
+    }
+
+    void leave() {
+        inside.store(false);
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST(PipelineTest, SerialParallelSerialKeepsOrder) {
+    constexpr int64_t kItems = 10000;
+
+    Executor executor(4);
+    Pipeline pipeline(&executor, 16);
+    std::vector<int64_t> output;
+    SerialProbe probe;
+
+    pipeline.input(Source{0, kItems})
+        .stage(wr::StageMode::kParallel, [](Item& item) { item.value = item.index * item.index; })
+        .stage(wr::StageMode::kSerialInOrder, [&](Item& item) {
+            probe.enter();
+            output.push_back(item.value);
+            probe.leave();
+        });
+
+    pipeline.run_and_wait();
+
+    ASSERT_EQ(output.size(), static_cast<size_t>(kItems));
+    for (int64_t i = 0; i < kItems; ++i) {
+        ASSERT_EQ(output[i], i * i);
+    }
+    EXPECT_EQ(probe.overlaps.load(), 0);
+}
+
+TEST(PipelineTest, TokensBoundItemsInFlight) {
+    constexpr size_t kTokens = 4;
+
+    Executor executor(8);
+    Pipeline pipeline(&executor, kTokens);
+    std::atomic<int64_t> in_flight = 0;
+    std::atomic<int64_t> max_in_flight = 0;
+    int64_t produced = 0;
+
+    pipeline
+        .input([&](Item& item) {
+            if (produced == 5000) {
+                return false;
+            }
+            item.index = produced++;
+            int64_t now = in_flight.fetch_add(1) + 1;
+            int64_t max = max_in_flight.load();
+            while (now > max && !max_in_flight.compare_exchange_weak(max, now)) {
+            }
+            return true;
+        })
+        .stage(wr::StageMode::kParallel, [](Item& item) { item.value = item.index; })
+        .stage(wr::StageMode::kParallel, [&](Item&) { in_flight.fetch_sub(1); });
+
+    pipeline.run_and_wait();
+
+    EXPECT_EQ(produced, 5000);
+    EXPECT_EQ(in_flight.load(), 0);
+    EXPECT_LE(max_in_flight.load(), static_cast<int64_t>(kTokens));
+}
+
+TEST(PipelineTest, SerialOutOfOrderIsSerial) {
+    constexpr int64_t kItems = 5000;
+
+    Executor executor(4);
+    Pipeline pipeline(&executor, 32);
+    SerialProbe probe;
+    int64_t sum = 0;  // not atomic on purpose: the stage is serial
+
+    pipeline.input(Source{0, kItems})
+        .stage(wr::StageMode::kParallel, [](Item& item) { item.value = item.index; })
+        .stage(wr::StageMode::kSerialOutOfOrder, [&](Item& item) {
+            probe.enter();
+            sum += item.value;
+            probe.leave();
+        });
+
+    pipeline.run_and_wait();
+
+    EXPECT_EQ(sum, kItems * (kItems - 1) / 2);
+    EXPECT_EQ(probe.overlaps.load(), 0);
+}
+
+TEST(PipelineTest, SeveralOrderedStages) {
+    constexpr int64_t kItems = 3000;
+
+    Executor executor(4);
+    Pipeline pipeline(&executor, 8);
+    std::vector<int64_t> first;
+    std::vector<int64_t> second;
+
+    pipeline.input(Source{0, kItems})
+        .stage(wr::StageMode::kParallel, [](Item& item) { item.value = item.index + 1; })
+        .stage(wr::StageMode::kSerialInOrder, [&](Item& item) { first.push_back(item.index); })
+        .stage(wr::StageMode::kParallel, [](Item& item) { item.value *= 2; })
+        .stage(wr::StageMode::kSerialInOrder, [&](Item& item) { second.push_back(item.value); });
+
+    pipeline.run_and_wait();
+
+    ASSERT_EQ(first.size(), static_cast<size_t>(kItems));
+    ASSERT_EQ(second.size(), static_cast<size_t>(kItems));
+    for (int64_t i = 0; i < kItems; ++i) {
+        ASSERT_EQ(first[i], i);
+        ASSERT_EQ(second[i], 2 * (i + 1));
+    }
+}
+
+TEST(PipelineTest, SingleToken) {
+    Executor executor(4);
+    Pipeline pipeline(&executor, 1);
+    std::vector<int64_t> output;
+
+    pipeline.input(Source{0, 100}).stage(wr::StageMode::kSerialInOrder, [&](Item& item) {
+        output.push_back(item.index);
+    });
+
+    pipeline.run_and_wait();
+
+    ASSERT_EQ(output.size(), 100u);
+    for (int64_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(output[i], i);
+    }
+}
+
+TEST(PipelineTest, ReusableAcrossRuns) {
+    Executor executor(4);
+    Pipeline pipeline(&executor, 8);
+    Source source{0, 1000};
+    int64_t count = 0;
+
+    pipeline.input([&](Item& item) { return source(item); })
+        .stage(wr::StageMode::kSerialInOrder, [&](Item&) { ++count; });
+
+    for (int run = 1; run <= 5; ++run) {
+        source.next = 0;
+        pipeline.run_and_wait();
+        ASSERT_EQ(count, run * 1000);
+    }
+}
+
+TEST(PipelineTest, EmptyInput) {
+    Executor executor(2);
+    Pipeline pipeline(&executor, 4);
+    int64_t count = 0;
+
+    pipeline.input(Source{0, 0}).stage(wr::StageMode::kSerialInOrder, [&](Item&) { ++count; });
+    pipeline.run_and_wait();
+
+    EXPECT_EQ(count, 0);
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include "queues/global/group_queue.hpp"
+
+// -------------------- Test prerequisites --------------------
+
+struct GroupTask : IntrusiveListNode {
+    int value;
+
+    explicit GroupTask(int v) : value(v) {}
+
+    void run() noexcept { /* do nothing */ }
+};
+
+// -------------------- Tests --------------------
+
+TEST(GroupQueueTest, CountsSubmittedAndExecuted) {
+    wr::queues::GroupQueue<GroupTask> queue;
+    queue.set_weight(3);
+
+    GroupTask t1(1), t2(2);
+    queue.push(&t1);
+    queue.push(&t2);
+
+    EXPECT_EQ(queue.weight(), 3u);
+    EXPECT_EQ(queue.submitted(), 2u);
+    EXPECT_EQ(queue.executed(), 0u);
+    EXPECT_TRUE(queue.maybe_non_empty());
+
+    auto task = queue.try_pop();
+    ASSERT_TRUE(task.has_value());
+    EXPECT_EQ((*task)->value, 1);
+    EXPECT_EQ(queue.executed(), 1u);
+
+    ASSERT_TRUE(queue.try_pop().has_value());
+    EXPECT_FALSE(queue.try_pop().has_value());  // failed pops are not counted
+
+    EXPECT_EQ(queue.executed(), 2u);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.maybe_non_empty());
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "queues/inbox/inbox.hpp"
+
+// -------------------- Test prerequisites --------------------
+
+struct TestTask : IntrusiveListNode {
+    int value = 0;
+
+    void run() noexcept { /* do nothing */ }
+};
+
+using SmallInbox = wr::queues::Inbox<TestTask, 4>;
+
+// -------------------- Tests --------------------
+
+TEST(InboxTest, EmptyOnStart) {
+    SmallInbox inbox;
+    EXPECT_TRUE(inbox.empty());
+    EXPECT_FALSE(inbox.try_pop().has_value());
+}
+
+TEST(InboxTest, FIFO) {
+    SmallInbox inbox;
+    std::vector<TestTask> tasks(3);
+    for (int i = 0; i < 3; ++i) {
+        tasks[i].value = i;
+        ASSERT_TRUE(inbox.try_push(&tasks[i]));
+    }
+    EXPECT_FALSE(inbox.empty());
+
+    for (int i = 0; i < 3; ++i) {
+        auto task = inbox.try_pop();
+        ASSERT_TRUE(task.has_value());
+        EXPECT_EQ((*task)->value, i);
+    }
+    EXPECT_TRUE(inbox.empty());
+}
+
+TEST(InboxTest, RingWrapsAround) {
+    SmallInbox inbox;
+    TestTask task;
+
+    for (int lap = 0; lap < 10; ++lap) {
+        ASSERT_TRUE(inbox.try_push(&task));
+        ASSERT_EQ(inbox.try_pop(), &task);
+    }
+    EXPECT_TRUE(inbox.empty());
+}
+
+TEST(InboxTest, OverflowWhenRingIsFull) {
+    SmallInbox inbox;
+    std::vector<TestTask> tasks(6);
+
+    for (size_t i = 0; i < SmallInbox::kCapacity; ++i) {
+        ASSERT_TRUE(inbox.try_push(&tasks[i]));
+    }
+    EXPECT_FALSE(inbox.try_push(&tasks[4]));
+
+    // `push` never fails: the rest goes to the overflow list of the same inbox
+    inbox.push(&tasks[4]);
+    inbox.push(&tasks[5]);
+
+    size_t popped = 0;
+    while (inbox.try_pop().has_value()) {
+        ++popped;
+    }
+    EXPECT_EQ(popped, tasks.size());
+    EXPECT_TRUE(inbox.empty());
+}
+
+TEST(InboxTest, HandoffIsKeptApart) {
+    SmallInbox inbox;
+    std::vector<TestTask> tasks(5);
+
+    SmallInbox::Batch batch;
+    for (size_t i = 0; i < 4; ++i) {
+        batch.push_back(tasks[i]);
+    }
+    inbox.push_batch(std::move(batch), 4);
+    inbox.push(&tasks[4]);
+
+    EXPECT_FALSE(inbox.empty());
+    EXPECT_TRUE(inbox.has_handoff());
+
+    // targeted tasks do not mix with the handed over batch
+    EXPECT_EQ(*inbox.try_pop(), &tasks[4]);
+    EXPECT_FALSE(inbox.try_pop().has_value());
+    EXPECT_FALSE(inbox.empty());
+
+    auto adopted = inbox.try_take_handoff();
+    ASSERT_TRUE(adopted.has_value());
+    size_t count = 0;
+    while (!adopted->empty()) {
+        adopted->try_pop_front();
+        ++count;
+    }
+    EXPECT_EQ(count, 4u);
+    EXPECT_FALSE(inbox.has_handoff());
+    EXPECT_TRUE(inbox.empty());
+    EXPECT_FALSE(inbox.try_take_handoff().has_value());
+}
+
+TEST(InboxTest, ManyProducersSingleConsumer) {
+    constexpr size_t kProducers = 4;
+    constexpr size_t kPerProducer = 10000;
+
+    wr::queues::Inbox<TestTask, 64> inbox;
+    std::vector<TestTask> tasks(kProducers * kPerProducer);
+
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (size_t i = 0; i < kPerProducer; ++i) {
+                inbox.push(&tasks[p * kPerProducer + i]);
+            }
+        });
+    }
+
+    size_t popped = 0;
+    while (popped < tasks.size()) {
+        if (auto task = inbox.try_pop()) {
+            ++(*task)->value;
+            ++popped;
+        }
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_TRUE(inbox.empty());
+    for (auto& task : tasks) {
+        ASSERT_EQ(task.value, 1);
+    }
+}
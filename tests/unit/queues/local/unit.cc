@@ -1 +1,106 @@
-#include <iostream>
+#include <gtest/gtest.h>
+
+#include <ntrusive/intrusive.hpp>
+
+#include "queues/local/ws_queue.hpp"
+
+// -------------------- Test prerequisites --------------------
+
+struct LocalTask : IntrusiveListNode {
+    int value = 0;
+
+    void run() noexcept { /* do nothing */ }
+};
+
+class WorkStealingQueueTest : public ::testing::Test {
+  protected:
+    static constexpr size_t kCapacity = 8;
+
+    wr::queues::WorkStealingQueue<LocalTask, kCapacity> queue;
+    LocalTask tasks[kCapacity + 1];
+
+    void SetUp() override {
+        for (int i = 0; i <= static_cast<int>(kCapacity); ++i) {
+            tasks[i].value = i;
+        }
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST_F(WorkStealingQueueTest, PopFromEmpty) {
+    EXPECT_FALSE(queue.try_pop().has_value());
+}
+
+TEST_F(WorkStealingQueueTest, OwnerIsLIFO) {
+    queue.try_push(&tasks[0]);
+    queue.try_push(&tasks[1]);
+
+    EXPECT_EQ((*queue.try_pop())->value, 1);
+    EXPECT_EQ((*queue.try_pop())->value, 0);
+    EXPECT_FALSE(queue.try_pop().has_value());
+}
+
+TEST_F(WorkStealingQueueTest, PushFailsWhenFull) {
+    for (size_t i = 0; i < kCapacity; ++i) {
+        EXPECT_TRUE(queue.try_push(&tasks[i]));
+    }
+    EXPECT_FALSE(queue.try_push(&tasks[kCapacity]));
+}
+
+TEST_F(WorkStealingQueueTest, StealerIsFIFO) {
+    auto stealer = queue.create_stealer();
+
+    queue.try_push(&tasks[0]);
+    queue.try_push(&tasks[1]);
+
+    auto loot = stealer.steal();
+    ASSERT_TRUE(loot.success());
+    EXPECT_EQ(std::move(loot).unwrap()->value, 0);
+
+    EXPECT_EQ((*queue.try_pop())->value, 1);
+    EXPECT_TRUE(stealer.steal().empty());
+    EXPECT_TRUE(stealer.empty());
+}
+
+TEST_F(WorkStealingQueueTest, StealBatchAndPop) {
+    wr::queues::WorkStealingQueue<LocalTask, kCapacity> thief;
+    auto stealer = queue.create_stealer();
+
+    for (int i = 0; i < 6; ++i) {
+        queue.try_push(&tasks[i]);
+    }
+
+    // first task + half of the rest (2 of 5): the last stolen one is returned
+    auto loot = stealer.steal_batch_and_pop(thief);
+    ASSERT_TRUE(loot.success());
+    EXPECT_EQ(std::move(loot).unwrap()->value, 2);
+
+    EXPECT_EQ((*thief.try_pop())->value, 1);
+    EXPECT_EQ((*thief.try_pop())->value, 0);
+    EXPECT_FALSE(thief.try_pop().has_value());
+
+    int remains = 0;
+    while (queue.try_pop()) {
+        ++remains;
+    }
+    EXPECT_EQ(remains, 3);
+}
+
+TEST_F(WorkStealingQueueTest, OffloadHalf) {
+    for (size_t i = 0; i < kCapacity; ++i) {
+        queue.try_push(&tasks[i]);
+    }
+
+    auto batch = queue.offload_half();
+    ASSERT_TRUE(batch.has_value());
+
+    // the oldest half leaves the queue
+    int expected = 0;
+    while (auto* task = batch->try_pop_front()) {
+        EXPECT_EQ(task->value, expected++);
+    }
+    EXPECT_EQ(expected, static_cast<int>(kCapacity / 2));
+
+    EXPECT_TRUE(queue.try_push(&tasks[kCapacity]));
+}
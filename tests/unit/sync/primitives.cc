@@ -0,0 +1,223 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "exec/executor.hpp"
+#include "sync/event.hpp"
+#include "sync/mutex.hpp"
+#include "sync/semaphore.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+
+// -------------------- Test prerequisites --------------------
+
+namespace {
+
+using Executor = wr::WsExecutor<>;
+
+// Fire-and-forget coroutine: starts inline, its frame is freed at the end
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+            std::terminate();
+        }
+    };
+};
+
+Detached lock_and_increment(wr::AsyncMutex<Executor>& mutex, int& counter, std::atomic<int>& done, int rounds) {
+    for (int i = 0; i < rounds; ++i) {
+        co_await mutex.lock();
+        ++counter;  // not atomic on purpose: protected by the mutex
+        mutex.unlock();
+    }
+    done.fetch_add(1);
+}
+
+Detached wait_event(wr::Event<Executor>& event, std::atomic<int>& done) {
+    co_await event.wait();
+    done.fetch_add(1);
+}
+
+Detached limited_section(wr::AsyncSemaphore<Executor>& semaphore, std::atomic<int>& inside, std::atomic<int>& max_inside,
+                         std::atomic<int>& done) {
+    co_await semaphore.acquire();
+
+    int now = inside.fetch_add(1) + 1;
+    int max = max_inside.load();
+    while (now > max && !max_inside.compare_exchange_weak(max, now)) {
+    }
+    std::this_thread::sleep_for(10us);
+    inside.fetch_sub(1);
+
+    semaphore.release();
+    done.fetch_add(1);
+}
+
+// Callback-style waiter: runs as the owner of the mutex
+struct Critical : wr::Waiter<wr::TaskBase> {
+    wr::AsyncMutex<Executor>* mutex = nullptr;
+    int* counter = nullptr;
+    std::atomic<int>* done = nullptr;
+
+    Critical() : wr::Waiter<wr::TaskBase>(&Critical::trampoline) {}
+
+    void enter() {
+        if (mutex->lock_or_wait(this)) {
+            body();
+        }
+    }
+
+    void body() {
+        ++*counter;
+        mutex->unlock();
+        done->fetch_add(1);
+    }
+
+    static void trampoline(wr::TaskBase* self) noexcept {
+        static_cast<Critical*>(self)->body();
+    }
+};
+
+}  // namespace
+
+// -------------------- AsyncMutex --------------------
+
+TEST(AsyncMutexTest, TryLock) {
+    Executor executor(1);
+    wr::AsyncMutex<Executor> mutex(&executor);
+
+    EXPECT_TRUE(mutex.try_lock());
+    EXPECT_FALSE(mutex.try_lock());
+    mutex.unlock();
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST(AsyncMutexTest, CoroutinesAreSerialized) {
+    constexpr int kCoroutines = 200;
+    constexpr int kRounds = 100;
+
+    Executor executor(4);
+    wr::AsyncMutex<Executor> mutex(&executor);
+    int counter = 0;
+    std::atomic<int> done = 0;
+
+    for (int i = 0; i < kCoroutines; ++i) {
+        executor.submit([&] { lock_and_increment(mutex, counter, done, kRounds); });
+    }
+
+    ASSERT_TRUE(eventually([&] { return done.load() == kCoroutines; }));
+    EXPECT_EQ(counter, kCoroutines * kRounds);
+}
+
+TEST(AsyncMutexTest, CallbackWaiters) {
+    Executor executor(4);
+    wr::AsyncMutex<Executor> mutex(&executor);
+    int counter = 0;
+    std::atomic<int> done = 0;
+
+    std::vector<Critical> tasks(1000);
+    for (auto& task : tasks) {
+        task.mutex = &mutex;
+        task.counter = &counter;
+        task.done = &done;
+        executor.submit([&task] { task.enter(); });
+    }
+
+    ASSERT_TRUE(eventually([&] { return done.load() == 1000; }));
+    EXPECT_EQ(counter, 1000);
+}
+
+// -------------------- Event --------------------
+
+TEST(EventTest, SetWakesAllWaiters) {
+    Executor executor(4);
+    wr::Event<Executor> event(&executor);
+    std::atomic<int> done = 0;
+    std::atomic<int> started = 0;
+
+    for (int i = 0; i < 100; ++i) {
+        executor.submit([&] {
+            started.fetch_add(1);
+            wait_event(event, done);
+        });
+    }
+
+    ASSERT_TRUE(eventually([&] { return started.load() == 100; }));
+    std::this_thread::sleep_for(1ms);
+    EXPECT_EQ(done.load(), 0);
+
+    event.set();
+    EXPECT_TRUE(eventually([&] { return done.load() == 100; }));
+}
+
+TEST(EventTest, SetEventPassesThrough) {
+    Executor executor(2);
+    wr::Event<Executor> event(&executor);
+    std::atomic<int> done = 0;
+
+    event.set();
+    EXPECT_TRUE(event.is_set());
+
+    wait_event(event, done);  // does not suspend
+    EXPECT_EQ(done.load(), 1);
+
+    event.reset();
+    EXPECT_FALSE(event.is_set());
+}
+
+// -------------------- AsyncSemaphore --------------------
+
+TEST(AsyncSemaphoreTest, LimitsConcurrency) {
+    constexpr int kPermits = 3;
+    constexpr int kCoroutines = 200;
+
+    Executor executor(8);
+    wr::AsyncSemaphore<Executor> semaphore(&executor, kPermits);
+    std::atomic<int> inside = 0;
+    std::atomic<int> max_inside = 0;
+    std::atomic<int> done = 0;
+
+    for (int i = 0; i < kCoroutines; ++i) {
+        executor.submit([&] { limited_section(semaphore, inside, max_inside, done); });
+    }
+
+    ASSERT_TRUE(eventually([&] { return done.load() == kCoroutines; }));
+    EXPECT_LE(max_inside.load(), kPermits);
+    EXPECT_EQ(semaphore.available(), static_cast<size_t>(kPermits));
+}
+
+TEST(AsyncSemaphoreTest, ReleaseManyPermits) {
+    Executor executor(4);
+    wr::AsyncSemaphore<Executor> semaphore(&executor, 0);
+    std::atomic<int> inside = 0;
+    std::atomic<int> max_inside = 0;
+    std::atomic<int> done = 0;
+
+    for (int i = 0; i < 10; ++i) {
+        executor.submit([&] { limited_section(semaphore, inside, max_inside, done); });
+    }
+    std::this_thread::sleep_for(1ms);
+    EXPECT_EQ(done.load(), 0);
+
+    semaphore.release(10);
+    ASSERT_TRUE(eventually([&] { return done.load() == 10; }));
+    EXPECT_EQ(semaphore.available(), 10u);
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "exec/executor.hpp"
+#include "sync/strand.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+
+// -------------------- Test prerequisites --------------------
+
+using Executor = wr::WsExecutor<>;
+using Strand = wr::Strand<Executor>;
+
+// Detects overlapping messages of one strand
+struct SerialProbe {
+    std::atomic<bool> inside = false;
+    std::atomic<int> overlaps = 0;
+    int counter = 0;  // not atomic on purpose: protected by the strand
+
+    void enter() {
+        if (inside.exchange(true)) {
+            overlaps.fetch_add(1);
+        }
+        ++counter;
+        inside.store(false);
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST(StrandTest, MessagesDoNotOverlap) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 5000;
+
+    Executor executor(4);
+    Strand strand(&executor);
+    SerialProbe probe;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                strand.post([&probe] { probe.enter(); });
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_TRUE(eventually([&] { return strand.idle(); }));
+    EXPECT_EQ(probe.counter, kProducers * kPerProducer);
+    EXPECT_EQ(probe.overlaps.load(), 0);
+}
+
+TEST(StrandTest, FifoForSingleProducer) {
+    Executor executor(4);
+    Strand strand(&executor, /*budget=*/3);
+
+    std::vector<int> order;
+    for (int i = 0; i < 1000; ++i) {
+        strand.post([&order, i] { order.push_back(i); });
+    }
+
+    EXPECT_TRUE(eventually([&] { return strand.idle(); }));
+    ASSERT_EQ(order.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(order[i], i);
+    }
+}
+
+struct Ping : wr::StrandTask {
+    std::atomic<int>* counter = nullptr;
+
+    Ping() : wr::StrandTask(&Ping::trampoline) {}
+
+    static void trampoline(wr::StrandTask* self) noexcept {
+        static_cast<Ping*>(self)->counter->fetch_add(1);
+    }
+};
+
+TEST(StrandTest, UserOwnedMessages) {
+    std::atomic<int> counter = 0;
+    std::vector<Ping> pings(100);
+
+    Executor executor(2);
+    Strand strand(&executor);
+    for (auto& ping : pings) {
+        ping.counter = &counter;
+        strand.post(&ping);
+    }
+
+    EXPECT_TRUE(eventually([&] { return counter.load() == 100 && strand.idle(); }));
+}
+
+TEST(StrandTest, PostFromOwnMessage) {
+    constexpr int kHops = 10000;
+
+    Executor executor(4);
+    Strand strand(&executor, /*budget=*/16);
+    SerialProbe probe;
+
+    std::function<void()> hop = [&] {
+        probe.enter();
+        if (probe.counter < kHops) {
+            strand.post(hop);
+        }
+    };
+    strand.post(hop);
+
+    EXPECT_TRUE(eventually([&] { return strand.idle() && probe.counter == kHops; }));
+    EXPECT_EQ(probe.overlaps.load(), 0);
+}
+
+TEST(StrandTest, OtherTasksRunBetweenBatches) {
+    constexpr size_t kBudget = 4;
+    constexpr size_t kMessages = 16;
+    constexpr size_t kOthers = 8;
+
+    // a single worker: the run order is the scheduling order
+    using OneWorker = wr::WsExecutor<wr::TaskBase, wr::test::Config>;
+    OneWorker executor(1);
+    wr::Strand<OneWorker> strand(&executor, kBudget);
+
+    std::mutex mutex;
+    std::string order;
+    const auto log = [&](char what) {
+        std::lock_guard lock(mutex);
+        order.push_back(what);
+    };
+
+    // the other tasks are queued first, the strand is the newest task of the worker
+    executor.submit([&] {
+        for (size_t i = 0; i < kOthers; ++i) {
+            executor.submit([&] { log('o'); });
+        }
+        for (size_t i = 0; i < kMessages; ++i) {
+            strand.post([&] { log('s'); });
+        }
+    });
+
+    ASSERT_TRUE(eventually([&] {
+        std::lock_guard lock(mutex);
+        return order.size() == kMessages + kOthers;
+    }));
+    EXPECT_TRUE(eventually([&] { return strand.idle(); }));
+    EXPECT_EQ(order.find('o'), kBudget) << order;  // one batch, then the worker is given away
+}
+
+TEST(StrandTest, ManyStrandsFromWorkers) {
+    constexpr size_t kStrands = 1000;
+    constexpr int kMessages = 50;
+
+    Executor executor(4);
+    std::vector<std::unique_ptr<Strand>> strands;
+    std::vector<SerialProbe> probes(kStrands);
+    for (size_t i = 0; i < kStrands; ++i) {
+        strands.push_back(std::make_unique<Strand>(&executor));
+    }
+
+    // producers are tasks themselves => strands are submitted from workers (lifo slot / local queues)
+    std::atomic<size_t> posted = 0;
+    for (size_t i = 0; i < kStrands; ++i) {
+        executor.submit([&, i] {
+            for (int m = 0; m < kMessages; ++m) {
+                strands[(i + m) % kStrands]->post([&probes, j = (i + m) % kStrands] { probes[j].enter(); });
+            }
+            posted.fetch_add(1);
+        });
+    }
+
+    EXPECT_TRUE(eventually([&] {
+        if (posted.load() != kStrands) {
+            return false;
+        }
+        for (auto& strand : strands) {
+            if (!strand->idle()) {
+                return false;
+            }
+        }
+        return true;
+    }));
+
+    for (auto& probe : probes) {
+        ASSERT_EQ(probe.counter, kMessages);
+        ASSERT_EQ(probe.overlaps.load(), 0);
+    }
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include "exec/executor.hpp"
+#include "../helpers.hpp"
+
+using namespace std::chrono_literals;
+using wr::test::eventually;
+
+// -------------------- Test prerequisites --------------------
+
+using Executor = wr::WsExecutor<>;
+using Clock = std::chrono::steady_clock;
+
+struct StatsConfig : wr::test::Config {
+    static constexpr bool kEnableStats = true;
+};
+
+struct Alarm : wr::TimerTask<wr::TaskBase> {
+    std::atomic<bool> rang = false;
+
+    Alarm() : wr::TimerTask<wr::TaskBase>(&Alarm::trampoline) {}
+
+    static void trampoline(wr::TaskBase* self) noexcept {
+        static_cast<Alarm*>(self)->rang.store(true);
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST(TimersTest, SubmitAfterNeverFiresEarly) {
+    Executor executor(2);
+    std::atomic<bool> done = false;
+    std::atomic<int64_t> elapsed_us = 0;
+
+    const auto start = Clock::now();
+    executor.submit_after(20ms, [&] {
+        elapsed_us.store(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+        done.store(true);
+    });
+
+    ASSERT_TRUE(eventually([&] { return done.load(); }));
+    EXPECT_GE(elapsed_us.load(), 20000);
+}
+
+TEST(TimersTest, ManyTimersAllFireInTime) {
+    constexpr int kTimers = 10000;
+
+    Executor executor(4);
+    std::atomic<int> fired = 0;
+    std::atomic<int> early = 0;
+    std::mt19937 gen(1);
+
+    for (int i = 0; i < kTimers; ++i) {
+        const auto deadline = Clock::now() + std::chrono::microseconds(gen() % 50000);
+        executor.submit_at(deadline, [&, deadline] {
+            early.fetch_add(Clock::now() < deadline ? 1 : 0);
+            fired.fetch_add(1);
+        });
+    }
+
+    ASSERT_TRUE(eventually([&] { return fired.load() == kTimers; }));
+    EXPECT_EQ(early.load(), 0);
+}
+
+TEST(TimersTest, CancelledTimerDoesNotRun) {
+    Executor executor(2);
+    Alarm alarm;
+
+    executor.submit_after(30ms, &alarm);
+    EXPECT_TRUE(executor.cancel(&alarm));
+    EXPECT_FALSE(executor.cancel(&alarm));
+
+    std::this_thread::sleep_for(80ms);
+    EXPECT_FALSE(alarm.rang.load());
+
+    // and it can be scheduled again
+    executor.submit_after(1ms, &alarm);
+    ASSERT_TRUE(eventually([&] { return alarm.rang.load(); }));
+    EXPECT_FALSE(executor.cancel(&alarm));
+}
+
+TEST(TimersTest, EarlierTimerWakesTheTimekeeper) {
+    Executor executor(2);
+    Alarm late;
+    std::atomic<bool> soon = false;
+
+    executor.submit_after(10s, &late);
+    std::this_thread::sleep_for(20ms);  // a worker parks until the late deadline
+
+    const auto start = Clock::now();
+    executor.submit_after(10ms, [&] { soon.store(true); });
+
+    ASSERT_TRUE(eventually([&] { return soon.load(); }));
+    EXPECT_LT(Clock::now() - start, 1s);
+    EXPECT_TRUE(executor.cancel(&late));
+}
+
+TEST(TimersTest, EarlierTimerWakesOnlyTheTimekeeper) {
+    constexpr size_t kWorkers = 4;
+
+    wr::WsExecutor<wr::TaskBase, StatsConfig> executor(kWorkers);
+    const auto all_parked = [&] {
+        const auto stats = executor.stats();
+        for (const auto& worker : stats.workers) {
+            if (worker.parks != worker.unparks + 1) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    Alarm late;
+    Alarm sooner;
+    executor.submit_after(10s, &late);
+    std::this_thread::sleep_for(50ms);    // the wake-ups of the start and of this submit are over
+    ASSERT_TRUE(eventually(all_parked));  // one of them keeps time until the late deadline
+    const auto before = executor.stats().total.unparks;
+
+    executor.submit_after(5s, &sooner);
+    std::this_thread::sleep_for(50ms);
+    ASSERT_TRUE(eventually(all_parked));  // the timekeeper parks again with the sooner alarm
+
+    EXPECT_EQ(executor.stats().total.unparks - before, 1u);
+    EXPECT_TRUE(executor.cancel(&sooner));
+    EXPECT_TRUE(executor.cancel(&late));
+}
+
+TEST(TimersTest, PastDeadlineRunsRightAway) {
+    Executor executor(1);
+    std::atomic<bool> done = false;
+
+    executor.submit_at(Clock::now() - 1s, [&] { done.store(true); });
+    EXPECT_TRUE(eventually([&] { return done.load(); }));
+}
+
+TEST(TimersTest, TimersFireWhileWorkersAreBusy) {
+    Executor executor(1);
+    std::atomic<bool> stop = false;
+    std::atomic<bool> fired = false;
+
+    // the only worker never runs out of tasks => it never parks
+    struct Spinner {
+        Executor* executor;
+        std::atomic<bool>* stop;
+
+        void operator()() const {
+            if (!stop->load()) {
+                executor->submit(*this);
+            }
+        }
+    };
+    executor.submit(Spinner{&executor, &stop});
+
+    executor.submit_after(10ms, [&] { fired.store(true); });
+    EXPECT_TRUE(eventually([&] { return fired.load(); }));
+    stop.store(true);
+}
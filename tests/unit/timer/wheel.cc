@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "timer/timer_wheel.hpp"
+
+using wr::timer::TimerNode;
+using wr::timer::TimerWheel;
+
+// -------------------- Test prerequisites --------------------
+
+struct Fired {
+    std::vector<TimerNode*> nodes;
+    std::vector<uint64_t> at;  // `now()` of the wheel when fired
+
+    auto callback(TimerWheel& wheel) {
+        return [this, &wheel](TimerNode* node) {
+            nodes.push_back(node);
+            at.push_back(wheel.now());
+        };
+    }
+};
+
+// -------------------- Tests --------------------
+
+TEST(TimerWheelTest, FiresExactlyAtDeadlines) {
+    TimerWheel wheel;
+    const std::vector<uint64_t> deadlines = {5, 1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 300000};
+    std::vector<TimerNode> nodes(deadlines.size());
+
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        wheel.insert(&nodes[i], deadlines[i]);
+    }
+    EXPECT_EQ(wheel.size(), deadlines.size());
+
+    Fired fired;
+    for (uint64_t tick = 1; tick <= 300000; ++tick) {
+        const size_t before = fired.nodes.size();
+        wheel.advance(tick, fired.callback(wheel));
+
+        for (size_t i = before; i < fired.nodes.size(); ++i) {
+            EXPECT_EQ(fired.nodes[i]->deadline(), tick);
+            EXPECT_FALSE(fired.nodes[i]->scheduled());
+        }
+    }
+
+    EXPECT_EQ(fired.nodes.size(), deadlines.size());
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, RandomDeadlinesAndJumps) {
+    constexpr size_t kTimers = 20000;
+
+    TimerWheel wheel;
+    std::vector<TimerNode> nodes(kTimers);
+    std::mt19937_64 gen(7);
+
+    for (auto& node : nodes) {
+        wheel.insert(&node, 1 + gen() % (1 << 22));
+    }
+
+    Fired fired;
+    uint64_t now = 0;
+    while (!wheel.empty()) {
+        const uint64_t previous = now;
+        now += 1 + gen() % 5000;
+        const size_t before = fired.nodes.size();
+        wheel.advance(now, fired.callback(wheel));
+
+        // fired during this jump: not earlier than the deadline, not later than the target
+        for (size_t i = before; i < fired.nodes.size(); ++i) {
+            EXPECT_GT(fired.nodes[i]->deadline(), previous);
+            EXPECT_LE(fired.nodes[i]->deadline(), now);
+        }
+    }
+    EXPECT_EQ(fired.nodes.size(), kTimers);
+}
+
+TEST(TimerWheelTest, RemoveFromTheMiddleOfASlot) {
+    TimerWheel wheel;
+    TimerNode first, middle, last;
+
+    wheel.insert(&first, 10);
+    wheel.insert(&middle, 10);
+    wheel.insert(&last, 10);
+
+    wheel.remove(&middle);
+    EXPECT_FALSE(middle.scheduled());
+    EXPECT_EQ(wheel.size(), 2u);
+
+    Fired fired;
+    wheel.advance(10, fired.callback(wheel));
+    ASSERT_EQ(fired.nodes.size(), 2u);
+    EXPECT_NE(fired.nodes[0], &middle);
+    EXPECT_NE(fired.nodes[1], &middle);
+
+    // removal of the last entry of a slot clears it
+    wheel.insert(&middle, 5000);
+    wheel.remove(&middle);
+    EXPECT_EQ(wheel.next_expiration(), TimerWheel::kNever);
+}
+
+TEST(TimerWheelTest, NextExpiration) {
+    TimerWheel wheel;
+    EXPECT_EQ(wheel.next_expiration(), TimerWheel::kNever);
+
+    TimerNode far, near;
+    wheel.insert(&far, 1000);  // level 1: the event is the cascade of its slot, not the deadline itself
+    EXPECT_LE(wheel.next_expiration(), 1000u);
+    EXPECT_GT(wheel.next_expiration(), 0u);
+
+    wheel.insert(&near, 10);
+    EXPECT_EQ(wheel.next_expiration(), 10u);
+
+    Fired fired;
+    wheel.advance(999, fired.callback(wheel));
+    EXPECT_EQ(fired.nodes.size(), 1u);
+    EXPECT_EQ(wheel.next_expiration(), 1000u);
+
+    wheel.advance(1000, fired.callback(wheel));
+    EXPECT_EQ(fired.nodes.size(), 2u);
+}
+
+TEST(TimerWheelTest, DeadlinesBeyondTheTopWheel) {
+    TimerWheel wheel;
+    TimerNode node;
+
+    const uint64_t deadline = (uint64_t{1} << 40) + 12345;
+    wheel.insert(&node, deadline);
+
+    Fired fired;
+    wheel.advance(deadline - 1, fired.callback(wheel));
+    EXPECT_TRUE(fired.nodes.empty());
+    EXPECT_TRUE(node.scheduled());
+
+    wheel.advance(deadline, fired.callback(wheel));
+    ASSERT_EQ(fired.nodes.size(), 1u);
+    EXPECT_EQ(fired.at[0], deadline);
+}
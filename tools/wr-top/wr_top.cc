@@ -0,0 +1,183 @@
+// wr-top: live view of an executor built with `kEnableIntrospection` (see src/introspect/)
+//
+//   wr-top [--once] [--interval <ms>] [<segment>]
+//
+// Without a segment name the executors of this machine are listed (/dev/shm/wr-*): the only one is shown.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "introspect/segment.hpp"
+
+namespace {
+
+using wr::introspect::PoolSample;
+using wr::introspect::Segment;
+using wr::introspect::WorkerSample;
+using Phase = wr::stats::Phase;
+
+struct Reading {
+    PoolSample pool;
+    std::vector<WorkerSample> workers;
+};
+
+Reading read(const Segment& segment) {
+    Reading reading;
+    reading.pool = segment.pool().load();
+    for (size_t i = 0; i < segment.workers(); ++i) {
+        reading.workers.push_back(segment.worker(i).load());
+    }
+    return reading;
+}
+
+std::vector<std::string> list_segments() {
+    std::vector<std::string> names;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/dev/shm", error)) {
+        const std::string file = entry.path().filename().string();
+        if (file.rfind("wr-", 0) == 0) {
+            names.push_back("/" + file);
+        }
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+double per_second(uint64_t now, uint64_t before, double seconds) {
+    return seconds > 0 ? static_cast<double>(now - before) / seconds : 0.0;
+}
+
+void print(const Segment& segment, const Reading& now, const Reading& before) {
+    const auto& header = segment.header();
+    const bool has_stats = (header.flags & wr::introspect::kHasStats) != 0;
+    const bool has_cycles = (header.flags & wr::introspect::kHasCycles) != 0;
+    const double seconds = static_cast<double>(now.pool.timestamp_ns - before.pool.timestamp_ns) / 1e9;
+
+    std::printf("wr-top  %s  pid %llu  workers %u  global queue %llu  injected %llu\n\n", segment.name().c_str(),
+                static_cast<unsigned long long>(header.pid), header.workers,
+                static_cast<unsigned long long>(now.pool.global_depth),
+                static_cast<unsigned long long>(now.pool.injected));
+    std::printf("%4s %5s %7s %10s %9s %6s %6s %6s %6s %6s %6s  %s\n", "W", "state", "depth", "tasks/s", "steals/s",
+                "run%", "local%", "glob%", "coord%", "steal%", "park%", "steals from");
+
+    for (size_t i = 0; i < now.workers.size(); ++i) {
+        const WorkerSample& current = now.workers[i];
+        const WorkerSample& previous = before.workers[i];
+
+        const char* state = current.parked ? "P" : (current.searching ? "S" : "R");
+        std::printf("%4zu %5s %7llu ", i, state, static_cast<unsigned long long>(current.local_depth));
+
+        if (has_stats) {
+            std::printf("%10.0f %9.0f ", per_second(current.tasks_run, previous.tasks_run, seconds),
+                        per_second(current.steal_success, previous.steal_success, seconds));
+        } else {
+            std::printf("%10s %9s ", "-", "-");
+        }
+
+        if (!has_cycles) {
+            std::printf("%6s %6s %6s %6s %6s %6s  -\n", "-", "-", "-", "-", "-", "-");
+            continue;
+        }
+
+        // shares of the cycles spent since the previous reading
+        uint64_t total = 0;
+        for (size_t phase = 0; phase < current.cycles.size(); ++phase) {
+            total += current.cycles[phase] - previous.cycles[phase];
+        }
+        auto share = [&](Phase phase) {
+            const auto index = static_cast<size_t>(phase);
+            return total == 0 ? 0.0 : 100.0 * static_cast<double>(current.cycles[index] - previous.cycles[index]) /
+                                          static_cast<double>(total);
+        };
+        std::printf("%6.1f %6.1f %6.1f %6.1f %6.1f %6.1f  ", share(Phase::kRunning), share(Phase::kLocalPop),
+                    share(Phase::kGlobalPoll), share(Phase::kCoordinator), share(Phase::kStealing),
+                    share(Phase::kParked));
+
+        // steal flow: the victims this worker spent its stealing cycles on
+        std::vector<std::pair<uint64_t, size_t>> victims;
+        uint64_t stealing = 0;
+        for (size_t victim = 0; victim < current.steal_cycles.size(); ++victim) {
+            const uint64_t cycles = current.steal_cycles[victim] - previous.steal_cycles[victim];
+            if (cycles > 0) {
+                victims.emplace_back(cycles, victim);
+                stealing += cycles;
+            }
+        }
+        std::sort(victims.rbegin(), victims.rend());
+        for (size_t k = 0; k < victims.size() && k < 3; ++k) {
+            std::printf("%zu:%.0f%% ", victims[k].second,
+                        100.0 * static_cast<double>(victims[k].first) / static_cast<double>(stealing));
+        }
+        std::printf("\n");
+    }
+    std::fflush(stdout);
+}
+
+int usage() {
+    std::fprintf(stderr, "usage: wr-top [--once] [--interval <ms>] [<segment>]\n");
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool once = false;
+    std::chrono::milliseconds interval{1000};
+    std::string name;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--once") {
+            once = true;
+        } else if (arg == "--interval" && i + 1 < argc) {
+            interval = std::chrono::milliseconds(std::strtoul(argv[++i], nullptr, 10));
+        } else if (!arg.empty() && arg[0] != '-' && name.empty()) {
+            name = arg;
+        } else {
+            return usage();
+        }
+    }
+
+    if (name.empty()) {
+        const auto names = list_segments();
+        if (names.size() != 1) {
+            std::fprintf(stderr, names.empty() ? "no executors found\n" : "several executors, choose one:\n");
+            for (const auto& candidate : names) {
+                std::fprintf(stderr, "  %s\n", candidate.c_str());
+            }
+            return 1;
+        }
+        name = names.front();
+    }
+
+    try {
+        const Segment segment = Segment::open(name);
+        interval = std::max(interval, std::chrono::milliseconds(segment.header().period_ms));
+
+        Reading before = read(segment);
+        while (true) {
+            std::this_thread::sleep_for(interval);
+            Reading now = read(segment);
+
+            if (!once) {
+                std::printf("\033[H\033[2J");  // home + clear
+            }
+            print(segment, now, before);
+            if (once) {
+                return 0;
+            }
+            before = std::move(now);
+        }
+    } catch (const std::exception& error) {
+        std::fprintf(stderr, "wr-top: %s\n", error.what());
+        return 1;
+    }
+}